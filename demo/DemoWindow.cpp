@@ -20,6 +20,7 @@
 #include <QElapsedTimer>
 #include <QGraphicsOpacityEffect>
 #include <QHBoxLayout>
+#include <QLoggingCategory>
 #include <QPainter>
 #include <QParallelAnimationGroup>
 #include <QPointer>
@@ -40,6 +41,7 @@
 #include "Fluent/FluentCheckBox.h"
 #include "Fluent/FluentColorDialog.h"
 #include "Fluent/FluentColorPicker.h"
+#include "Fluent/FluentDiagnostics.h"
 #include "Fluent/FluentDialog.h"
 #include "Fluent/FluentFlowLayout.h"
 #include "Fluent/FluentGroupBox.h"
@@ -73,6 +75,9 @@ using namespace Fluent;
 
 namespace {
 
+// Feeds each buildUi step into the library startup trace (phases after the
+// first frame are dropped there) and logs the per-step cost through
+// Diagnostics::startupLog(), i.e. with QTFLUENT_STARTUP_TRACE=1.
 class DemoStartupTrace
 {
 public:
@@ -80,46 +85,26 @@ public:
         : m_context(std::move(context))
     {
         m_timer.start();
-        qInfo().noquote() << QStringLiteral("[DemoStartup] %1 begin").arg(m_context);
+        Diagnostics::markStartupPhase(QStringLiteral("%1 begin").arg(m_context));
     }
 
     ~DemoStartupTrace()
     {
-        qInfo().noquote() << QStringLiteral("[DemoStartup] %1 done at %2 ms").arg(m_context).arg(m_timer.elapsed());
+        Diagnostics::markStartupPhase(QStringLiteral("%1 done").arg(m_context));
+        qCInfo(Diagnostics::startupLog).noquote() << QStringLiteral("[DemoStartup] %1 done at %2 ms").arg(m_context).arg(m_timer.elapsed());
     }
 
     void mark(const QString &label)
     {
         const qint64 now = m_timer.elapsed();
-        qInfo().noquote() << QStringLiteral("[DemoStartup] %1 %2 +%3 ms, total %4 ms")
-                                  .arg(m_context, label)
-                                  .arg(now - m_lastMark)
-                                  .arg(now);
+        Diagnostics::markStartupPhase(QStringLiteral("%1: %2").arg(m_context, label));
+        qCInfo(Diagnostics::startupLog).noquote() << QStringLiteral("[DemoStartup] %1 %2 +%3 ms, total %4 ms")
+                                                         .arg(m_context, label)
+                                                         .arg(now - m_lastMark)
+                                                         .arg(now);
         m_lastMark = now;
     }
 
-    template <typename Factory>
-    QWidget *addPage(QStackedWidget *stack, const QString &name, Factory factory)
-    {
-        const qint64 beforeCreate = m_timer.elapsed();
-        QWidget *page = factory();
-        const qint64 afterCreate = m_timer.elapsed();
-        qInfo().noquote() << QStringLiteral("[DemoStartup] %1 page %2 created +%3 ms, total %4 ms")
-                                  .arg(m_context, name)
-                                  .arg(afterCreate - beforeCreate)
-                                  .arg(afterCreate);
-        if (stack && page) {
-            const qint64 beforeAdd = m_timer.elapsed();
-            stack->addWidget(page);
-            const qint64 afterAdd = m_timer.elapsed();
-            qInfo().noquote() << QStringLiteral("[DemoStartup] %1 page %2 added +%3 ms, total %4 ms")
-                                      .arg(m_context, name)
-                                      .arg(afterAdd - beforeAdd)
-                                      .arg(afterAdd);
-        }
-        return page;
-    }
-
 private:
     QString m_context;
     QElapsedTimer m_timer;
@@ -231,9 +216,7 @@ DemoWindow::DemoWindow(QWidget *parent,
     , m_toastPosition(toastPosition)
     , m_selectedNavigationKey(selectedNavigationKey)
 {
-    qInfo().noquote() << QStringLiteral("[DemoStartup] DemoWindow ctor body begin");
     buildUi();
-    qInfo().noquote() << QStringLiteral("[DemoStartup] DemoWindow ctor body done");
 }
 
 void DemoWindow::clearUi()
@@ -523,9 +506,9 @@ void DemoWindow::buildUi()
         timer.start();
         QWidget *page = pageFactories->at(index)();
         const qint64 createdMs = timer.elapsed();
-        qInfo().noquote() << QStringLiteral("[DemoStartup] lazy page %1 created +%2 ms")
-                                  .arg(name)
-                                  .arg(createdMs);
+        qCInfo(Diagnostics::startupLog).noquote() << QStringLiteral("[DemoStartup] lazy page %1 created +%2 ms")
+                                                         .arg(name)
+                                                         .arg(createdMs);
         if (!page) {
             return nullptr;
         }
@@ -538,9 +521,9 @@ void DemoWindow::buildUi()
         stack->insertWidget(qBound(0, stackIndex, stack->count()), page);
         pageWidgets->replace(index, page);
 
-        qInfo().noquote() << QStringLiteral("[DemoStartup] lazy page %1 installed +%2 ms")
-                                  .arg(name)
-                                  .arg(timer.elapsed() - createdMs);
+        qCInfo(Diagnostics::startupLog).noquote() << QStringLiteral("[DemoStartup] lazy page %1 installed +%2 ms")
+                                                         .arg(name)
+                                                         .arg(timer.elapsed() - createdMs);
         return page;
     };
 
@@ -3,7 +3,6 @@
 #include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
-#include <QElapsedTimer>
 #include <QEventLoop>
 #include <QFile>
 #include <QFont>
@@ -11,6 +10,7 @@
 #include <QGraphicsEffect>
 #include <QImage>
 #include <QList>
+#include <QLoggingCategory>
 #include <QLocale>
 #include <QMouseEvent>
 #include <QPointer>
@@ -37,6 +37,7 @@
 #include "Fluent/FluentTheme.h"
 #include "Fluent/FluentAnnotatedScrollBar.h"
 #include "Fluent/FluentCard.h"
+#include "Fluent/FluentDiagnostics.h"
 #include "Fluent/FluentMotion.h"
 #include "Fluent/FluentNavigationView.h"
 
@@ -200,8 +201,8 @@ void configureDemoFontRendering(QApplication &app)
     font.setStyleStrategy(QFont::PreferAntialias);
     app.setFont(font);
 
-    qInfo().noquote() << QStringLiteral("[DemoStartup] font family=\"%1\" hinting=PreferFullHinting")
-                             .arg(app.font().family());
+    qCInfo(Fluent::Diagnostics::startupLog).noquote() << QStringLiteral("[DemoStartup] font family=\"%1\" hinting=PreferFullHinting")
+                                                     .arg(app.font().family());
 }
 
 int currentScalePercent()
@@ -662,21 +663,18 @@ int runInteractionSmoke(const QString &outputPath)
 
 int main(int argc, char *argv[])
 {
-    QElapsedTimer startupTimer;
-    startupTimer.start();
-
     QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
     QApplication::setAttribute(Qt::AA_UseHighDpiPixmaps);
     QApplication::setHighDpiScaleFactorRoundingPolicy(Qt::HighDpiScaleFactorRoundingPolicy::PassThrough);
 
     QApplication app(argc, argv);
-    qInfo().noquote() << QStringLiteral("[DemoStartup] QApplication constructed at %1 ms").arg(startupTimer.elapsed());
     configureDemoFontRendering(app);
+    Fluent::Diagnostics::markStartupPhase(QStringLiteral("demo fonts configured"));
 
     QCoreApplication::setOrganizationName(QStringLiteral("QtFluent"));
     QCoreApplication::setApplicationName(QStringLiteral("QtFluentDemo"));
     Demo::initializeLanguage();
-    qInfo().noquote() << QStringLiteral("[DemoStartup] language initialized at %1 ms").arg(startupTimer.elapsed());
+    Fluent::Diagnostics::markStartupPhase(QStringLiteral("demo language initialized"));
 
     const QStringList arguments = QCoreApplication::arguments();
     const QString renderArg = argumentValue(arguments, QStringLiteral("--render-baselines"));
@@ -702,17 +700,11 @@ int main(int argc, char *argv[])
     }
 
     Demo::DemoWindow w;
-    qInfo().noquote() << QStringLiteral("[DemoStartup] DemoWindow constructed at %1 ms").arg(startupTimer.elapsed());
+    Fluent::Diagnostics::markStartupPhase(QStringLiteral("DemoWindow constructed"));
 
     w.resize(1260, 780);
-    qInfo().noquote() << QStringLiteral("[DemoStartup] DemoWindow resized at %1 ms").arg(startupTimer.elapsed());
-
     w.show();
-    qInfo().noquote() << QStringLiteral("[DemoStartup] DemoWindow show() returned at %1 ms").arg(startupTimer.elapsed());
-
-    QTimer::singleShot(0, &app, [&startupTimer]() {
-        qInfo().noquote() << QStringLiteral("[DemoStartup] first event loop tick at %1 ms").arg(startupTimer.elapsed());
-    });
+    Fluent::Diagnostics::markStartupPhase(QStringLiteral("DemoWindow show() returned"));
 
     return app.exec();
 }
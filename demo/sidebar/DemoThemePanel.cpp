@@ -15,6 +15,7 @@
 #include "Fluent/FluentCard.h"
 #include "Fluent/FluentColorDialog.h"
 #include "Fluent/FluentComboBox.h"
+#include "Fluent/FluentDiagnostics.h"
 #include "Fluent/FluentFlowLayout.h"
 #include "Fluent/FluentFramePainter.h"
 #include "Fluent/FluentLabel.h"
@@ -940,6 +941,58 @@ DemoThemePanel::DemoThemePanel(QWidget *hostWindow, QWidget *parent, bool showTo
     QObject::connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, updateThemeInfo);
     updateThemeInfo();
 
+    addGroupTitle(DEMO_TEXT("诊断", "Diagnostics"));
+
+    auto *flashRow = new QHBoxLayout();
+    flashRow->setContentsMargins(0, 0, 0, 0);
+    auto *flashLabel = new FluentLabel(DEMO_TEXT("重绘闪烁", "Flash repaints"));
+    auto *flashToggle = new FluentToggleSwitch();
+    flashToggle->setChecked(Diagnostics::repaintFlashEnabled());
+    flashRow->addWidget(flashLabel);
+    flashRow->addStretch(1);
+    flashRow->addWidget(flashToggle);
+    themeLayout->addLayout(flashRow);
+
+    auto *paintStats = new FluentLabel();
+    paintStats->setWordWrap(true);
+    paintStats->setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Preferred);
+    paintStats->setMinimumWidth(0);
+    paintStats->setStyleSheet("font-size: 12px; opacity: 0.9;");
+    paintStats->setVisible(flashToggle->isChecked());
+    themeLayout->addWidget(paintStats);
+
+    // Busiest classes over the last second; the label's own repaint shows up too.
+    auto *paintStatsTimer = new QTimer(paintStats);
+    paintStatsTimer->setInterval(1000);
+    QObject::connect(paintStatsTimer, &QTimer::timeout, paintStats, [paintStats]() {
+        const PaintReport report = Diagnostics::paintReport();
+        QStringList lines;
+        lines << DEMO_TEXT("%1 次重绘 / %2 ms", "%1 paints / %2 ms")
+                     .arg(report.paintCount)
+                     .arg(report.totalNs / 1000000.0, 0, 'f', 1);
+        for (int i = 0; i < qMin(3, report.classes.size()); ++i) {
+            const PaintCost &cost = report.classes.at(i);
+            lines << QStringLiteral("%1  x%2  %3 ms")
+                         .arg(cost.className.section(QStringLiteral("::"), -1))
+                         .arg(cost.count)
+                         .arg(cost.totalNs / 1000000.0, 0, 'f', 1);
+        }
+        paintStats->setText(lines.join(QLatin1Char('\n')));
+        Diagnostics::resetPaintReport();
+    });
+
+    QObject::connect(flashToggle, &FluentToggleSwitch::toggled, this, [paintStats, paintStatsTimer](bool checked) {
+        Diagnostics::setRepaintFlashEnabled(checked);
+        Diagnostics::setPaintProfilingEnabled(checked);
+        Diagnostics::resetPaintReport();
+        paintStats->setVisible(checked);
+        if (checked) {
+            paintStatsTimer->start();
+        } else {
+            paintStatsTimer->stop();
+        }
+    });
+
     if (m_showToastControls) {
         addGroupTitle(QStringLiteral("Toast"));
 
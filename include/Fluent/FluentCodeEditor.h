@@ -2,16 +2,24 @@
 
 #include "Fluent/FluentExport.h"
 
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QPair>
 #include <QPlainTextEdit>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QVector>
 #include "Fluent/FluentQtCompat.h"
 
 class QAction;
+class QAtomicInt;
 class QTimer;
 class QProcess;
 class QVariantAnimation;
 
 namespace Fluent {
 
+class BracketIndex;
 class FluentCppHighlighter;
 class FluentCodeEditorLineNumberArea;
 class FluentCodeEditorBorderOverlay;
@@ -44,6 +52,9 @@ public:
 
     void setBracketMatchHighlightEnabled(bool enabled);
     bool bracketMatchHighlightEnabled() const;
+    // Brackets opened and not yet closed before position, ignoring literals
+    // and comments; for rainbow brackets or scope guides.
+    int bracketDepthAt(int position) const;
 
     qreal hoverLevel() const;
     void setHoverLevel(qreal value);
@@ -80,13 +91,32 @@ public:
     void setMaxAutoFormatCharacters(int chars);
     int maxAutoFormatCharacters() const;
 
+    // Large-file mode: above either threshold (0 turns one off) only the
+    // visible lines are highlighted and auto formatting stops.
+    void setLargeFileCharacterThreshold(int chars);
+    int largeFileCharacterThreshold() const;
+
+    void setLargeFileLineThreshold(int lines);
+    int largeFileLineThreshold() const;
+
+    bool largeFileMode() const;
+
+    // Like setPlainText(), but text large enough for large-file mode is
+    // inserted in chunks from the event loop, with the editor read-only
+    // until loadFinished().
+    void loadPlainText(const QString &text);
+    bool isLoading() const;
+
 public slots:
     void formatDocumentNow();
 
 signals:
     void clangFormatAvailabilityChanged(bool available);
     void formatStarted();
-    void formatFinished(bool applied);
+    void formatFinished(bool applied, qint64 elapsedMs);
+    void largeFileModeChanged(bool enabled);
+    void loadProgress(qint64 loaded, qint64 total);
+    void loadFinished();
 
 protected:
     void changeEvent(QEvent *event) override;
@@ -110,20 +140,31 @@ private:
     void updateLineNumberArea(const QRect &rect, int dy);
     int lineNumberAreaWidth() const;
     void lineNumberAreaPaintEvent(QPaintEvent *event);
+    void updateLineNumberLayer();
+    void paintLineNumbers(const QRect &rect);
     void updateExtraSelections();
-    int findMatchingBracket(int position, QChar bracket) const;
 
     void applyTheme();
     void startHoverAnimation(qreal to);
     void startFocusAnimation(qreal to);
 
     void ensureHighlighter();
+    void releaseHighlighter();
+    void updateLargeFileMode();
+    void setLargeFileMode(bool enabled);
+    void scheduleVisibleHighlight();
+    void highlightVisibleBlocks();
+    void loadNextChunk();
+    void endLoad();
     void scheduleAutoFormat();
-    void runClangFormatAsync();
-    bool applyFormattedText(const QString &formatted);
+    void startFormat(bool changedLinesOnly);
+    void runClangFormatAsync(bool changedLinesOnly);
+    void trackDirtyLines(int position, int charsAdded);
+    void startFormatJob(const QString &formatted, bool basicFormatter);
+    void finishFormat(bool applied);
 
     static QString findDefaultClangFormat();
-    QString runBasicFormatter(const QString &input) const;
+    static QString runBasicFormatter(const QString &input, const QAtomicInt *cancel = nullptr);
 
     bool m_cppHighlightingEnabled = true;
     bool m_autoBraceNewlineEnabled = true;
@@ -133,8 +174,24 @@ private:
     bool m_bracketMatchHighlightEnabled = true;
 
     FluentCppHighlighter *m_highlighter = nullptr;
-
-    QWidget *m_lineNumberArea = nullptr;
+    BracketIndex *m_bracketIndex = nullptr;
+
+    int m_largeFileCharThreshold = 4000000;
+    int m_largeFileLineThreshold = 100000;
+    bool m_largeFileMode = false;
+    // Formats visible lines in large-file mode; never attached to the document.
+    FluentCppHighlighter *m_visibleHighlighter = nullptr;
+    // A highlighter detached from a document that grew too large to delete it.
+    QPointer<FluentCppHighlighter> m_parkedHighlighter;
+    QTimer *m_visibleHighlightTimer = nullptr;
+
+    QString m_loadText;
+    int m_loadOffset = 0;
+    quint64 m_loadToken = 0;
+    bool m_loading = false;
+    bool m_loadReadOnly = false;
+
+    FluentCodeEditorLineNumberArea *m_lineNumberArea = nullptr;
     QWidget *m_borderOverlay = nullptr;
 
     QString m_clangFormatPath;
@@ -155,6 +212,15 @@ private:
     bool m_internalChange = false;
     bool m_formatPending = false;
     int m_formatStartRevision = 0;
+    bool m_formatJobRunning = false;
+    quint64 m_formatJobToken = 0;
+    QSharedPointer<QAtomicInt> m_formatJobCancel;
+    QElapsedTimer m_formatTimer;
+    QByteArray m_formatCacheKey;
+
+    // Block ranges edited since the last successful format, first/last inclusive.
+    QVector<QPair<int, int>> m_dirtyLines;
+    int m_trackedBlockCount = 1;
 
     bool m_inPreedit = false;
     bool m_autoFormatDeferredByPreedit = false;
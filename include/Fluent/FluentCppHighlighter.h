@@ -5,8 +5,11 @@
 #include <QSyntaxHighlighter>
 #include <QRegularExpression>
 #include <QTextCharFormat>
+#include <QTextLayout>
 #include <QVector>
 
+#include <functional>
+
 class QTextDocument;
 
 namespace Fluent {
@@ -27,9 +30,20 @@ protected:
     void highlightBlock(const QString &text) override;
 
 private:
+    friend class FluentCodeEditor;
+
     void applyThemeFormats();
     void rebuildRulesIfNeeded();
 
+    // The rules of highlightBlock() for one line after a line ending in
+    // previousState; returns the state this line ends in.
+    int highlightLine(const QString &text,
+                      int previousState,
+                      const std::function<void(int, int, const QTextCharFormat &)> &setFormat);
+    // Same, collected as layout format ranges so a line can be highlighted
+    // without attaching to its document.
+    int formatLine(const QString &text, int previousState, QVector<QTextLayout::FormatRange> *ranges);
+
     bool m_operatorHighlightEnabled = true;
     bool m_preprocessorHighlightEnabled = true;
 
@@ -2,8 +2,74 @@
 
 #include "Fluent/FluentExport.h"
 
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+class QLoggingCategory;
+
 namespace Fluent {
 
+// Accumulated cost of one themeChanged receiver, grouped by class and objectName.
+struct FLUENT_EXPORT ThemeReceiverCost
+{
+    QString className;
+    QString objectName;
+    int count = 0;          // handled dispatches
+    qint64 totalNs = 0;     // exclusive time (nested receivers are not double counted)
+    qint64 maxNs = 0;
+};
+
+struct FLUENT_EXPORT ThemeSwitchReport
+{
+    int dispatchCount = 0;
+    qint64 dispatchNs = 0;       // total time spent emitting themeChanged
+    qint64 lastDispatchNs = 0;
+    qint64 unattributedNs = 0;   // dispatch time outside instrumented receivers
+    int styleSheetCount = 0;     // setStyleSheet calls that changed a sheet
+    qint64 styleSheetNs = 0;
+    int styleRecomputeCount = 0; // QEvent::StyleChange delivered during dispatch
+    QVector<ThemeReceiverCost> receivers; // sorted by totalNs, most expensive first
+};
+
+// Accumulated Paint events of one widget, or of one class when widget is 0.
+struct FLUENT_EXPORT PaintCost
+{
+    QString className;
+    QString objectName;
+    quintptr widget = 0;    // identity of the instance at first paint; 0 for class rows
+    int count = 0;          // Paint events delivered
+    qint64 totalNs = 0;     // inclusive paintEvent time
+    qint64 maxNs = 0;
+    qint64 area = 0;        // summed invalidated region, logical pixels
+};
+
+struct FLUENT_EXPORT PaintReport
+{
+    int paintCount = 0;
+    qint64 totalNs = 0;
+    qint64 area = 0;
+    qint64 elapsedMs = 0;      // wall time since profiling was enabled or reset
+    QVector<PaintCost> widgets; // sorted by totalNs, most expensive first
+    QVector<PaintCost> classes; // sorted by totalNs, most expensive first
+};
+
+// One timestamp of the startup trace. Times count from the static
+// initialization of the library, which runs before main().
+struct FLUENT_EXPORT StartupPhase
+{
+    QString name;
+    qint64 elapsedNs = 0;
+};
+
+struct FLUENT_EXPORT StartupTrace
+{
+    QVector<StartupPhase> phases; // in recording order
+    bool complete = false;        // the first frame of a window has been presented
+    qint64 firstFrameNs = 0;
+};
+
 class FLUENT_EXPORT Diagnostics final
 {
 public:
@@ -20,6 +86,56 @@ public:
     // Enables/disables all QtWarningMsg output. Use only for local Debug profiling.
     static void setQtWarningOutputEnabled(bool enabled);
     static bool qtWarningOutputEnabled();
+
+    // Theme-switch profiler. While enabled, each themeChanged dispatch records
+    // the time of every instrumented receiver, setStyleSheet calls and style
+    // recomputations. Also enabled by QTFLUENT_THEME_SWITCH_PROFILE=1.
+    static void setThemeSwitchProfilingEnabled(bool enabled);
+    static bool themeSwitchProfilingEnabled();
+    static ThemeSwitchReport themeSwitchReport();
+    static void resetThemeSwitchReport();
+    static QByteArray themeSwitchReportJson();
+    static bool writeThemeSwitchReport(const QString &path);
+
+    // Paint profiler. While enabled, an application-wide event filter counts
+    // and times every QEvent::Paint per widget and per class and sums the
+    // invalidated area. Disabled, no filter is installed. Also enabled by
+    // QTFLUENT_PAINT_PROFILE=1.
+    static void setPaintProfilingEnabled(bool enabled);
+    static bool paintProfilingEnabled();
+    static PaintReport paintReport();
+    static void resetPaintReport();
+    static QByteArray paintReportJson();
+    static bool writePaintReport(const QString &path);
+
+    // Tints each repainted region of a shown window for a moment, on top of
+    // the widget's own painting. Implies paint profiling while on. Also
+    // enabled by QTFLUENT_PAINT_FLASH=1.
+    static void setRepaintFlashEnabled(bool enabled);
+    static bool repaintFlashEnabled();
+
+    // Startup trace. The library records "QCoreApplication constructed",
+    // "first window shown", "first window exposed", "first paint" and
+    // "first frame" (the end of the repaint that put the first paint on
+    // screen); applications add their own phases with markStartupPhase().
+    // The trace closes at the first frame and later marks are ignored until
+    // resetStartupTrace(). Set QTFLUENT_STARTUP_TRACE=1 to log the phases
+    // through startupLog() when it closes, QTFLUENT_STARTUP_TRACE_FILE=<path>
+    // to write startupTraceJson() there.
+    static void markStartupPhase(const QString &name);
+    static StartupTrace startupTrace();
+    static void resetStartupTrace();
+    static QByteArray startupTraceJson();
+    static bool writeStartupTrace(const QString &path);
+
+    // "qtfluent.themeswitch" category for the theme switch timeline. Info output
+    // is off by default; enable it through QT_LOGGING_RULES or
+    // QTFLUENT_THEME_SWITCH_LOG=1.
+    static const QLoggingCategory &themeSwitchLog();
+
+    // "qtfluent.startup" category for the startup trace; info output is off
+    // unless QTFLUENT_STARTUP_TRACE=1 or QT_LOGGING_RULES enables it.
+    static const QLoggingCategory &startupLog();
 };
 
 } // namespace Fluent
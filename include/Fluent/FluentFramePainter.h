@@ -165,18 +165,31 @@ inline void paintFluentSurfaceShadow(QPainter &p, const QRectF &rect, const Them
         return;
     }
 
-    p.save();
-    p.setRenderHint(QPainter::Antialiasing, true);
-    p.setPen(Qt::NoPen);
-    for (int i = steps; i >= 1; --i) {
-        QColor shadow = tokens.elevation.shadow;
-        shadow.setAlphaF(qBound<qreal>(0.0, alpha * (static_cast<qreal>(i) / steps) * 0.42, 1.0));
-        const qreal spread = static_cast<qreal>(i);
-        const QRectF shadowRect = rect.translated(0.0, offset).adjusted(-spread, -spread, spread, spread);
-        p.setBrush(shadow);
-        p.drawRoundedRect(shadowRect, spec.radius + spread, spec.radius + spread);
+    // Without the surface cache a blur would be recomputed on every paint;
+    // the stacked 1px rings it approximates are cheaper to draw directly.
+    if (!Style::surfaceCacheEnabled()) {
+        p.save();
+        p.setRenderHint(QPainter::Antialiasing, true);
+        p.setPen(Qt::NoPen);
+        for (int i = steps; i >= 1; --i) {
+            QColor ring = tokens.elevation.shadow;
+            ring.setAlphaF(qBound<qreal>(0.0, alpha * (static_cast<qreal>(i) / steps) * 0.42, 1.0));
+            const qreal spread = static_cast<qreal>(i);
+            const QRectF ringRect = rect.translated(0.0, offset).adjusted(-spread, -spread, spread, spread);
+            p.setBrush(ring);
+            p.drawRoundedRect(ringRect, spec.radius + spread, spec.radius + spread);
+        }
+        p.restore();
+        return;
     }
-    p.restore();
+
+    // A blurred rect carrying the opacity of `steps` 1px rings stacked
+    // around the panel, spread halfway out and fading over the rest.
+    QColor shadow = tokens.elevation.shadow;
+    shadow.setAlphaF(qBound<qreal>(0.0, alpha * 0.42 * (steps + 1) / 2.0, 1.0));
+    const qreal spread = steps / 2.0;
+    const QRectF shadowRect = rect.translated(0.0, offset).adjusted(-spread, -spread, spread, spread);
+    Style::paintShadow(p, shadowRect, spec.radius + spread, steps / 2.0, shadow);
 }
 
 inline void paintFluentSurface(QPainter &p, const QRectF &rect, const ThemeColors &colors, const FluentSurfaceSpec &spec)
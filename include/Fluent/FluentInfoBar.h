@@ -6,13 +6,13 @@
 
 class QHBoxLayout;
 class QBoxLayout;
-class QGraphicsOpacityEffect;
 class QParallelAnimationGroup;
 class QShowEvent;
 
 namespace Fluent {
 
 class FluentButton;
+class FluentFadeLayer;
 class FluentLabel;
 class FluentToolButton;
 
@@ -88,7 +88,7 @@ private:
     FluentLabel *m_messageLabel = nullptr;
     FluentButton *m_actionButton = nullptr;
     FluentToolButton *m_closeButton = nullptr;
-    QGraphicsOpacityEffect *m_opacityEffect = nullptr;
+    FluentFadeLayer *m_fade = nullptr;
     QParallelAnimationGroup *m_dismissGroup = nullptr;
 
     bool m_dismissInProgress = false;
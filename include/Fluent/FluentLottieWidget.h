@@ -36,6 +36,30 @@ public:
                   const QString &cacheKey = QString(),
                   const QString &resourcePath = QString());
 
+    // Read and parse on a worker thread; loaded() / loadFailed() report the
+    // result. A model already in the shared registry is applied immediately.
+    // Any later load*() call supersedes a pending asynchronous one.
+    void loadAsync(const QString &path);
+    void loadDataAsync(const QByteArray &json,
+                       const QString &cacheKey = QString(),
+                       const QString &resourcePath = QString());
+    bool isLoading() const;
+
+    // Parsed models are shared by every widget through a process-wide
+    // registry keyed by absolute file path or cache key. preload() warms it
+    // from worker threads, e.g. while a splash screen is up.
+    static void preload(const QStringList &paths);
+    static void preloadData(const QByteArray &json,
+                            const QString &cacheKey,
+                            const QString &resourcePath = QString());
+    static bool isModelCached(const QString &pathOrCacheKey);
+    static void clearModelCache();
+    // Models no widget holds stay cached while their JSON fits in this many
+    // bytes (least recently used go first; 16 MiB by default, 0 keeps only
+    // models in use).
+    static void setModelCacheLimit(qint64 bytes);
+    static qint64 modelCacheLimit();
+
     bool isLoaded() const;
     QString errorString() const;
 
@@ -108,6 +132,7 @@ private:
     void syncReducedMotionState();
     void finishActiveSegmentImmediately(bool emitFinished);
     void syncAnimationMetadata();
+    bool finishLoad(const QString &failureMessage);
     void setError(const QString &error);
 
     struct Private;
@@ -8,6 +8,7 @@
 #include <QtGlobal>
 
 #include "Fluent/FluentBorderEffect.h"
+#include "Fluent/FluentMotion.h"
 
 class QMenuBar;
 class QStatusBar;
@@ -17,7 +18,7 @@ class QLabel;
 class QShowEvent;
 class QVariantAnimation;
 
-namespace Fluent { class FluentMenuBar; class FluentToolButton; class FluentResizeHelper; }
+namespace Fluent { class FluentMenuBar; class FluentToolButton; class FluentResizeHelper; class FluentPageTransitionOverlay; }
 
 namespace Fluent {
 
@@ -31,6 +32,11 @@ public:
     // accent border is visible (even when the central widget fills the whole area).
     void setCentralWidget(QWidget *widget);
 
+    // Opt-in: replacing the central widget animates from offscreen snapshots
+    // of the old and new content. Defaults to FluentPageTransition::None.
+    void setContentTransition(FluentPageTransition transition);
+    FluentPageTransition contentTransition() const;
+
     // Fluent Design: this window uses FluentMenuBar embedded into the title bar.
     // Traditional QMainWindow tool bars / status bars are intentionally not supported.
     // These hide (non-virtual) QMainWindow methods when called on FluentMainWindow.
@@ -115,6 +121,7 @@ private slots:
 
 private:
     void ensureTitleBar();
+    void ensureWindowChrome();
     void updateTitleBarContent();
     void updateWindowControlIcons();
     void ensureFrameHostAsCentral();
@@ -186,6 +193,8 @@ private:
     bool m_initialTracePending = false;
 
     QWidget *m_userCentralWidget = nullptr;
+    FluentPageTransitionOverlay *m_contentTransitionOverlay = nullptr;
+    FluentPageTransition m_contentTransition = FluentPageTransition::None;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(FluentMainWindow::WindowButtons)
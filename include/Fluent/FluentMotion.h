@@ -23,6 +23,15 @@ enum class FluentMotionRole {
     WheelSnap
 };
 
+// Snapshot-based page switch used by page hosts (FluentTabWidget pages and
+// the FluentMainWindow content area). None keeps the instant switch.
+enum class FluentPageTransition {
+    None,
+    Fade,
+    Slide,
+    DrillIn
+};
+
 namespace FluentMotion {
 
 inline const FluentMotionTokens &tokens()
@@ -185,5 +194,37 @@ inline void configure(QPropertyAnimation *animation, FluentMotionRole role)
     animation->setEasingCurve(easing(role));
 }
 
+// Moves a 0..1 control level from `from` to `to` through an animation that is
+// only allocated on the first animated change. Idle controls therefore carry
+// just the level and a null pointer; all running levels already share Qt's
+// single animation timer. With motion disabled the level snaps through apply()
+// and nothing is allocated.
+template <typename Apply>
+inline void animateLevel(QObject *owner,
+                         QVariantAnimation *&animation,
+                         FluentMotionRole role,
+                         qreal from,
+                         qreal to,
+                         Apply apply)
+{
+    if (animation) {
+        animation->stop();
+    }
+    if (duration(role) <= 0) {
+        apply(to);
+        return;
+    }
+    if (!animation) {
+        animation = new QVariantAnimation(owner);
+        QObject::connect(animation, &QVariantAnimation::valueChanged, owner, [apply](const QVariant &value) {
+            apply(value.toReal());
+        });
+    }
+    configure(animation, role);
+    animation->setStartValue(from);
+    animation->setEndValue(to);
+    animation->start();
+}
+
 } // namespace FluentMotion
 } // namespace Fluent
@@ -39,6 +39,7 @@ struct FLUENT_EXPORT FluentNavigationItem
     bool animatedIconLooping = false; // loop while active instead of playing once on hover/selection
     bool    separator = false; // if true, rendered as a horizontal line (text/icon ignored)
     bool    selectsOnInvoked = true; // if false, clicking invokes without changing selectedKey
+    bool    hasLazyChildren = false; // children are requested from the children provider on first expansion
 
     std::vector<FluentNavigationItem> children; // sub-items (arbitrary nesting supported)
 };
@@ -80,6 +81,19 @@ public:
     void addFooterItem(const FluentNavigationItem &item);
     void clearFooterItems();
 
+    // --- Keyed incremental updates -------------------------------------------
+    // An empty parentKey addresses the top-level items; index < 0 appends.
+    bool insertItem(const QString &parentKey, int index, const FluentNavigationItem &item);
+    bool removeItem(const QString &key);
+    bool setItemText(const QString &key, const QString &text);
+    bool setItemChildren(const QString &parentKey, const std::vector<FluentNavigationItem> &children);
+
+    // --- Lazy children -------------------------------------------------------
+    // Called once for an item with hasLazyChildren when it is first expanded
+    // or its flyout is first opened.
+    using ChildrenProvider = std::function<std::vector<FluentNavigationItem>(const QString &parentKey)>;
+    void setChildrenProvider(ChildrenProvider provider);
+
     // --- Selection ---------------------------------------------------------
     QString selectedKey() const;
     void    setSelectedKey(const QString &key);
@@ -82,25 +82,39 @@ inline QPainterPath shadowContentClipPath(const QRect &rect)
 inline void paintSoftPopupShadow(QPainter &painter, const QRectF &rect, const ThemeColors &colors)
 {
     const auto tokens = Theme::tokens(colors);
-    constexpr int steps = 8;
-    const qreal baseAlpha = tokens.dark ? 0.16 : 0.075;
     const qreal verticalOffset = 5.0;
 
-    painter.save();
-    painter.setRenderHint(QPainter::Antialiasing, true);
-    painter.setPen(Qt::NoPen);
-
-    for (int i = steps; i >= 1; --i) {
-        const qreal t = static_cast<qreal>(i) / static_cast<qreal>(steps);
-        QColor shadow = tokens.elevation.shadow;
-        shadow.setAlphaF(qBound<qreal>(0.0, baseAlpha * t * t * 0.16, 1.0));
-        const qreal spread = static_cast<qreal>(i) * 1.1;
-        const QRectF shadowRect = rect.translated(0.0, verticalOffset)
-                                      .adjusted(-spread, -spread, spread, spread);
-        painter.setBrush(shadow);
-        painter.drawRoundedRect(shadowRect, kRadius + spread, kRadius + spread);
+    // Uncached, the layered rects are cheaper than a fresh blur per paint.
+    if (!Style::surfaceCacheEnabled()) {
+        constexpr int steps = 8;
+        const qreal baseAlpha = tokens.dark ? 0.16 : 0.075;
+
+        painter.save();
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.setPen(Qt::NoPen);
+
+        for (int i = steps; i >= 1; --i) {
+            const qreal t = static_cast<qreal>(i) / static_cast<qreal>(steps);
+            QColor layer = tokens.elevation.shadow;
+            layer.setAlphaF(qBound<qreal>(0.0, baseAlpha * t * t * 0.16, 1.0));
+            const qreal layerSpread = static_cast<qreal>(i) * 1.1;
+            const QRectF layerRect = rect.translated(0.0, verticalOffset)
+                                         .adjusted(-layerSpread, -layerSpread, layerSpread, layerSpread);
+            painter.setBrush(layer);
+            painter.drawRoundedRect(layerRect, kRadius + layerSpread, kRadius + layerSpread);
+        }
+        painter.restore();
+        return;
     }
-    painter.restore();
+
+    const qreal spread = 4.0;
+    const qreal blur = 3.0;
+
+    // Reaches spread + 3 * blur around the panel, which the shadow margins hold.
+    QColor shadow = tokens.elevation.shadow;
+    shadow.setAlphaF(tokens.dark ? 0.082 : 0.038);
+    const QRectF shadowRect = rect.translated(0.0, verticalOffset).adjusted(-spread, -spread, spread, spread);
+    Style::paintShadow(painter, shadowRect, kRadius + spread, blur, shadow);
 }
 
 /// Paints the Fluent surface panel (fill + themed border + optional accent trace).
@@ -38,6 +38,14 @@ struct FLUENT_EXPORT WindowMetrics {
     QEasingCurve::Type accentBorderTraceDisableEasing = QEasingCurve::InCubic;
 };
 
+struct FLUENT_EXPORT SurfaceCacheStats {
+    quint64 hits = 0;
+    quint64 misses = 0;   // each miss rasterizes one nine-slice tile
+    quint64 bypassed = 0; // paints the cache could not slice (rotated, translucent, fractional size)
+    int tiles = 0;
+    qint64 bytes = 0;
+};
+
 class FLUENT_EXPORT Style final
 {
 public:
@@ -85,6 +93,16 @@ public:
         bool enabled,
         bool pressed);
 
+    // Control surfaces (paintControlSurface, button chrome) are blitted from
+    // cached nine-slice tiles keyed by radius, colors and DPR; hover/focus
+    // levels snap to 1/32 steps while the cache is on. Disable it to compare
+    // against direct painting (also QTFLUENT_SURFACE_CACHE=0).
+    static void setSurfaceCacheEnabled(bool enabled);
+    static bool surfaceCacheEnabled();
+    static SurfaceCacheStats surfaceCacheStats();
+    static void resetSurfaceCacheStats();
+    static void clearSurfaceCache();
+
     static void drawChevronDown(QPainter &p, const QPointF &center, const QColor &color, qreal size = 8.0, qreal strokeWidth = 1.6);
     static void drawChevronUp(QPainter &p, const QPointF &center, const QColor &color, qreal size = 8.0, qreal strokeWidth = 1.6);
     static void drawChevronLeft(QPainter &p, const QPointF &center, const QColor &color, qreal size = 8.0, qreal strokeWidth = 1.6);
@@ -98,6 +116,13 @@ public:
         qreal strokeWidth = 1.6,
         qreal gap = 6.0);
 
+    // Drop shadow of a rounded rect: rect filled with color and blurred with a
+    // Gaussian of blur px sigma, reaching about 3 * blur past rect. The
+    // blurred tile is computed once per radius, blur, color and DPR, kept with
+    // the surface cache tiles and stretched as a nine-slice. With the cache
+    // off every call blurs again, so the built-in shadows stack rects instead.
+    static void paintShadow(QPainter &p, const QRectF &rect, qreal radius, qreal blur, const QColor &color);
+
     static void paintElevationShadow(
         QPainter &p,
         const QRectF &panelRect,
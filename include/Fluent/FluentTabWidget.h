@@ -1,11 +1,15 @@
 #pragma once
 
 #include "Fluent/FluentExport.h"
+#include "Fluent/FluentMotion.h"
 
+#include <QPointer>
 #include <QTabWidget>
 
 namespace Fluent {
 
+class FluentPageTransitionOverlay;
+
 class FLUENT_EXPORT FluentTabWidget final : public QTabWidget
 {
     Q_OBJECT
@@ -26,6 +30,11 @@ public:
     int contentMargin() const;
     void setContentMargin(int margin);
 
+    // Opt-in: animate page switches from offscreen snapshots of the outgoing
+    // and incoming pages. Defaults to FluentPageTransition::None.
+    FluentPageTransition pageTransition() const;
+    void setPageTransition(FluentPageTransition transition);
+
 protected:
     bool event(QEvent *event) override;
     void changeEvent(QEvent *event) override;
@@ -41,8 +50,13 @@ private:
     void syncFrameOverlay();
     void scheduleDocumentCornerWidgetPosition();
     void positionDocumentCornerWidget();
+    void startPageTransition(int index);
+    void finishPageTransition();
 
     QWidget *m_frameOverlay = nullptr;
+    FluentPageTransitionOverlay *m_pageTransitionOverlay = nullptr;
+    FluentPageTransition m_pageTransition = FluentPageTransition::None;
+    QPointer<QWidget> m_currentPage;
     int m_contentMargin = 5;
     bool m_documentCornerPositionPending = false;
 };
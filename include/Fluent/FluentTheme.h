@@ -129,6 +129,11 @@ struct FLUENT_EXPORT FluentThemeTokens {
     bool dark = false;
 };
 
+struct FLUENT_EXPORT StyleSheetCacheStats {
+    quint64 hits = 0;
+    quint64 misses = 0; // each miss is one full stylesheet build
+};
+
 class FLUENT_EXPORT Theme final
 {
 public:
@@ -166,6 +171,12 @@ public:
     static QString statusBarStyle(const ThemeColors &colors);
     static QString dialogStyle(const ThemeColors &colors);
     static QString cardStyle(const ThemeColors &colors);
+
+    // The *Style builders above (and baseStyleSheet) are cached per palette and
+    // shared by every caller; these expose the hit rate and reset the cache.
+    static StyleSheetCacheStats styleSheetCacheStats();
+    static void resetStyleSheetCacheStats();
+    static void clearStyleSheetCache();
 };
 
 class FLUENT_EXPORT ThemeManager final : public QObject
@@ -2,6 +2,7 @@
 
 #include "Fluent/FluentExport.h"
 
+#include <QPointer>
 #include <QWidget>
 
 #include "Fluent/FluentBorderEffect.h"
@@ -12,6 +13,8 @@ class QMouseEvent;
 
 namespace Fluent {
 
+class FluentFadeLayer;
+
 class FLUENT_EXPORT FluentToast final : public QWidget
 {
     Q_OBJECT
@@ -29,6 +32,9 @@ public:
 
     // Shows a toast anchored to the given top-level window widget.
     // The toast will animate in, count down, and dismiss automatically.
+    // Posting is cheap: a toast with the same title and message as one already
+    // shown (or queued) at that position is coalesced into it with a repeat
+    // badge, and toasts beyond maxVisibleCount() wait in a queue.
     static void showToast(QWidget *window, const QString &title, const QString &message, int durationMs = 3500);
 
     static void showToast(QWidget *window,
@@ -37,6 +43,14 @@ public:
                           Position position,
                           int durationMs = 3500);
 
+    // Caps how many toasts are shown at once per position; the default is 5.
+    // A count of 0 removes the cap. Queued toasts appear as shown ones dismiss.
+    static void setMaxVisibleCount(Position position, int count);
+    static int maxVisibleCount(Position position);
+
+    // Number of identical toasts coalesced into this one (1 when not repeated).
+    int repeatCount() const;
+
 signals:
     void dismissed();
 
@@ -45,10 +59,16 @@ protected:
     void paintEvent(QPaintEvent *event) override;
 
 private:
+    class ToastOverlay;
+
     void applyTheme();
     void finishOpacityAnimationsImmediatelyIfReducedMotion();
     void start(int durationMs);
     void dismiss(bool animated);
+    void finishDismiss();
+    void repeat(int durationMs);
+    void reset(const QString &title, const QString &message);
+    void stopAnimations();
 
     QString m_title;
     QString m_message;
@@ -56,7 +76,14 @@ private:
     class ProgressBar;
     ProgressBar *m_progress = nullptr;
 
+    FluentFadeLayer *m_fade = nullptr;
+    QPointer<QVariantAnimation> m_countdown;
+
+    int m_repeatCount = 1;
     bool m_dismissing = false;
+    // Set for toasts owned by a window's toast overlay, which recycles them
+    // after dismissal instead of deleting them.
+    bool m_pooled = false;
 
     FluentBorderEffect m_border{this};
 };
@@ -5,7 +5,7 @@
 #include <QWidget>
 #include "Fluent/FluentQtCompat.h"
 
-class QPropertyAnimation;
+class QVariantAnimation;
 
 namespace Fluent {
 
@@ -57,9 +57,9 @@ private:
     qreal m_progress = 0.0;
     qreal m_hoverLevel = 0.0;
     qreal m_focusLevel = 0.0;
-    QPropertyAnimation *m_progressAnim = nullptr;
-    QPropertyAnimation *m_hoverAnim = nullptr;
-    QPropertyAnimation *m_focusAnim = nullptr;
+    QVariantAnimation *m_progressAnim = nullptr;
+    QVariantAnimation *m_hoverAnim = nullptr;
+    QVariantAnimation *m_focusAnim = nullptr;
 };
 
 } // namespace Fluent
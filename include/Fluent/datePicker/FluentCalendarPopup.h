@@ -5,7 +5,9 @@
 #include "Fluent/FluentBorderEffect.h"
 
 #include <QDate>
+#include <QPixmap>
 #include <QString>
+#include <QVector>
 #include <QWidget>
 
 class QPainter;
@@ -58,6 +60,7 @@ protected:
     void showEvent(QShowEvent *event) override;
     void hideEvent(QHideEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
+    void changeEvent(QEvent *event) override;
 	void paintEvent(QPaintEvent *event) override;
 	void mouseMoveEvent(QMouseEvent *event) override;
 	void mousePressEvent(QMouseEvent *event) override;
@@ -125,6 +128,23 @@ private:
 	void paintRangePanelHeader(QPainter &p, int panelX, int pageYear, int pageMonth, bool isRight);
 	void paintRangePanelDays(QPainter &p, int panelX, int pageYear, int pageMonth, bool isRight);
 
+	// Cached grid glyphs. The weekday row and cell labels of a page only
+	// depend on the page, theme, locale, font and DPR, so they are rasterized
+	// once; hover / selection / today decorations are composited per paint.
+	enum class GridLayerSlot { Days, RangeLeft, RangeRight, Months, Years, Count };
+	struct GridLayer {
+		QPixmap pixmap;
+		QSize   size;
+		qreal   dpr   = 0.0;
+		int     year  = 0;
+		int     month = 0;
+	};
+	const QPixmap &gridLayer(GridLayerSlot slot, const QRect &area, int year, int month);
+	void paintGridGlyphs(QPainter &p, GridLayerSlot slot, const QRect &area, int year, int month) const;
+	void drawGridLayer(QPainter &p, GridLayerSlot slot, const QRect &area, int year, int month,
+	                   const QVector<QRect> &excludedCells);
+	void invalidateGridLayers();
+
 	void drawChevronLeft(QPainter &p, const QPointF &center, const QColor &color) const;
 	void drawChevronRight(QPainter &p, const QPointF &center, const QColor &color) const;
 
@@ -169,6 +189,8 @@ private:
 	int     m_pressIndex = -1;
 	QString m_todayText;
 	bool m_dismissing = false;
+
+	GridLayer m_gridLayers[int(GridLayerSlot::Count)];
 };
 
 } // namespace Fluent
@@ -4,6 +4,8 @@
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
 #include "FluentButtonVisuals_p.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QAbstractAnimation>
 #include <QEvent>
@@ -331,7 +333,7 @@ void FluentAnimatedButton::initialize()
     });
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentAnimatedButton::applyTheme);
+    ThemeRegistry::enroll<&FluentAnimatedButton::applyTheme>(this);
     connect(this, &QAbstractButton::toggled, this, [this](bool) {
         updateAnimatedIconTint();
         syncRestingAnimationState(true);
@@ -341,6 +343,8 @@ void FluentAnimatedButton::initialize()
 
 void FluentAnimatedButton::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool pressRunning = m_pressAnim && m_pressAnim->state() == QAbstractAnimation::Running;
     const QVariant hoverEnd = m_hoverAnim ? m_hoverAnim->endValue() : QVariant();
@@ -10,6 +10,8 @@
 #include "Fluent/FluentToolButton.h"
 #include "FluentPopupUtils.h"
 #include "FluentViewPaletteSupport.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QApplication>
 #include <QCursor>
@@ -304,9 +306,7 @@ public:
                 "}")
                 .arg(colors.text.name(QColor::HexArgb),
                      tokens.neutral.stroke.name(QColor::HexArgb));
-            if (m_view->styleSheet() != next) {
-                m_view->setStyleSheet(next);
-            }
+            ThemeProfiler::setStyleSheetIfChanged(m_view, next);
         }
         update();
     }
@@ -660,7 +660,7 @@ FluentAutoSuggestBox::FluentAutoSuggestBox(QWidget *parent)
     connect(m_searchButton, &QToolButton::clicked, this, &FluentAutoSuggestBox::submit);
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentAutoSuggestBox::applyTheme);
+    ThemeRegistry::enroll<&FluentAutoSuggestBox::applyTheme>(this);
 }
 
 FluentLineEdit *FluentAutoSuggestBox::lineEdit() const
@@ -740,6 +740,8 @@ void FluentAutoSuggestBox::changeEvent(QEvent *event)
 
 void FluentAutoSuggestBox::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     if (m_popup) {
         m_popup->applyTheme();
     }
@@ -0,0 +1,383 @@
+#include "FluentBracketIndex_p.h"
+
+#include <QString>
+#include <QTextBlock>
+#include <QTextDocument>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace Fluent {
+
+namespace {
+
+int bracketKind(QChar c, bool *open)
+{
+    switch (c.unicode()) {
+    case '(':
+    case ')':
+        *open = c == QLatin1Char('(');
+        return 0;
+    case '[':
+    case ']':
+        *open = c == QLatin1Char('[');
+        return 1;
+    case '{':
+    case '}':
+        *open = c == QLatin1Char('{');
+        return 2;
+    default:
+        return -1;
+    }
+}
+
+} // namespace
+
+BracketIndex::BracketIndex(QTextDocument *document, QObject *parent)
+    : QObject(parent)
+    , m_document(document)
+{
+    if (document) {
+        connect(document, &QTextDocument::contentsChange, this, &BracketIndex::onContentsChange);
+    }
+    rebuild();
+}
+
+void BracketIndex::rebuild()
+{
+    m_blocks.clear();
+    m_treeDirty = true;
+    if (!m_document) {
+        return;
+    }
+
+    m_blocks.reserve(m_document->blockCount());
+    bool inComment = false;
+    for (QTextBlock block = m_document->begin(); block.isValid(); block = block.next()) {
+        m_blocks.append(scanBlock(block.text(), inComment));
+        inComment = m_blocks.constLast().endsInComment;
+    }
+}
+
+void BracketIndex::onContentsChange(int position, int, int charsAdded)
+{
+    QTextDocument *doc = m_document;
+    if (!doc) {
+        return;
+    }
+
+    const int blocks = doc->blockCount();
+    const int delta = blocks - static_cast<int>(m_blocks.size());
+    const int lastPosition = qMax(0, doc->characterCount() - 1);
+    const QTextBlock firstBlock = doc->findBlock(qMin(position, lastPosition));
+    const QTextBlock lastBlock = doc->findBlock(qMin(position + charsAdded, lastPosition));
+    const int first = firstBlock.isValid() ? firstBlock.blockNumber() : blocks - 1;
+    const int last = qMax(first, lastBlock.isValid() ? lastBlock.blockNumber() : blocks - 1);
+    // Old blocks first..removedEnd became first..last.
+    const int removedEnd = last - delta;
+    if (removedEnd < first || removedEnd >= m_blocks.size()) {
+        rebuild();
+        return;
+    }
+
+    m_blocks.remove(first, removedEnd - first + 1);
+    m_blocks.insert(first, last - first + 1, BlockInfo());
+
+    // Rescan the edited blocks, then keep going while a comment the edit
+    // opened or closed changes how the following blocks start.
+    bool inComment = first > 0 && m_blocks.at(first - 1).endsInComment;
+    int number = first;
+    for (QTextBlock block = doc->findBlockByNumber(first); block.isValid(); block = block.next(), ++number) {
+        if (number > last && m_blocks.at(number).startsInComment == inComment) {
+            break;
+        }
+        m_blocks[number] = scanBlock(block.text(), inComment);
+        inComment = m_blocks.at(number).endsInComment;
+        if (delta == 0 && !m_treeDirty) {
+            updateLeaf(number);
+        }
+    }
+    if (delta != 0) {
+        m_treeDirty = true;
+    }
+}
+
+BracketIndex::BlockInfo BracketIndex::scanBlock(const QString &text, bool startsInComment)
+{
+    BlockInfo info;
+    info.startsInComment = startsInComment;
+
+    bool inComment = startsInComment;
+    bool inString = false;
+    bool inChar = false;
+    bool escaped = false;
+    const int size = static_cast<int>(text.size());
+    for (int i = 0; i < size; ++i) {
+        const QChar c = text.at(i);
+        const QChar next = i + 1 < size ? text.at(i + 1) : QChar();
+        if (inComment) {
+            if (c == QLatin1Char('*') && next == QLatin1Char('/')) {
+                inComment = false;
+                ++i;
+            }
+            continue;
+        }
+        if (inString || inChar) {
+            if (escaped) {
+                escaped = false;
+            } else if (c == QLatin1Char('\\')) {
+                escaped = true;
+            } else if ((inString && c == QLatin1Char('"')) || (inChar && c == QLatin1Char('\''))) {
+                inString = false;
+                inChar = false;
+            }
+            continue;
+        }
+        if (c == QLatin1Char('/') && next == QLatin1Char('/')) {
+            break;
+        }
+        if (c == QLatin1Char('/') && next == QLatin1Char('*')) {
+            inComment = true;
+            ++i;
+            continue;
+        }
+        if (c == QLatin1Char('"')) {
+            inString = true;
+            continue;
+        }
+        if (c == QLatin1Char('\'')) {
+            // Not after a digit: 1'000'000 uses it as a digit separator.
+            inChar = i == 0 || !text.at(i - 1).isDigit();
+            continue;
+        }
+
+        bool open = false;
+        const int kind = bracketKind(c, &open);
+        if (kind >= 0) {
+            Token token;
+            token.column = i;
+            token.kind = static_cast<quint8>(kind);
+            token.open = open;
+            info.tokens.append(token);
+        }
+    }
+    info.endsInComment = inComment;
+
+    Summary &summary = info.summary;
+    for (const Token &token : std::as_const(info.tokens)) {
+        int &running = summary.delta[token.kind];
+        running += token.open ? 1 : -1;
+        summary.minPrefix[token.kind] = qMin(summary.minPrefix[token.kind], running);
+    }
+    int fromEnd[KindCount] = {};
+    for (auto it = info.tokens.crbegin(); it != info.tokens.crend(); ++it) {
+        int &running = fromEnd[it->kind];
+        running += it->open ? -1 : 1;
+        summary.minSuffix[it->kind] = qMin(summary.minSuffix[it->kind], running);
+    }
+    return info;
+}
+
+BracketIndex::Summary BracketIndex::combine(const Summary &left, const Summary &right)
+{
+    Summary out;
+    for (int kind = 0; kind < KindCount; ++kind) {
+        out.delta[kind] = left.delta[kind] + right.delta[kind];
+        out.minPrefix[kind] = qMin(left.minPrefix[kind], left.delta[kind] + right.minPrefix[kind]);
+        out.minSuffix[kind] = qMin(right.minSuffix[kind], left.minSuffix[kind] - right.delta[kind]);
+    }
+    return out;
+}
+
+void BracketIndex::ensureTree() const
+{
+    if (!m_treeDirty) {
+        return;
+    }
+    const int blocks = static_cast<int>(m_blocks.size());
+    m_leafCount = 1;
+    while (m_leafCount < blocks) {
+        m_leafCount *= 2;
+    }
+    m_tree.fill(Summary(), 2 * m_leafCount);
+    for (int i = 0; i < blocks; ++i) {
+        m_tree[m_leafCount + i] = m_blocks.at(i).summary;
+    }
+    for (int node = m_leafCount - 1; node >= 1; --node) {
+        m_tree[node] = combine(m_tree.at(2 * node), m_tree.at(2 * node + 1));
+    }
+    m_treeDirty = false;
+}
+
+void BracketIndex::updateLeaf(int block) const
+{
+    int node = m_leafCount + block;
+    m_tree[node] = m_blocks.at(block).summary;
+    for (node /= 2; node >= 1; node /= 2) {
+        m_tree[node] = combine(m_tree.at(2 * node), m_tree.at(2 * node + 1));
+    }
+}
+
+// First block at or after from in which depth unmatched opening brackets of
+// kind, carried in from the left, get closed; depth is advanced past every
+// block skipped on the way.
+int BracketIndex::findForward(int node, int lo, int hi, int from, int kind, int &depth) const
+{
+    if (hi <= from) {
+        return -1;
+    }
+    const Summary &summary = m_tree.at(node);
+    if (lo >= from && depth + summary.minPrefix[kind] >= 0) {
+        depth += summary.delta[kind];
+        return -1;
+    }
+    if (hi - lo == 1) {
+        return lo;
+    }
+    const int mid = (lo + hi) / 2;
+    const int found = findForward(2 * node, lo, mid, from, kind, depth);
+    return found >= 0 ? found : findForward(2 * node + 1, mid, hi, from, kind, depth);
+}
+
+// Last block before to in which depth unmatched closing brackets of kind,
+// carried in from the right, get opened.
+int BracketIndex::findBackward(int node, int lo, int hi, int to, int kind, int &depth) const
+{
+    if (lo >= to) {
+        return -1;
+    }
+    const Summary &summary = m_tree.at(node);
+    if (hi <= to && depth + summary.minSuffix[kind] >= 0) {
+        depth -= summary.delta[kind];
+        return -1;
+    }
+    if (hi - lo == 1) {
+        return lo;
+    }
+    const int mid = (lo + hi) / 2;
+    const int found = findBackward(2 * node + 1, mid, hi, to, kind, depth);
+    return found >= 0 ? found : findBackward(2 * node, lo, mid, to, kind, depth);
+}
+
+int BracketIndex::match(int position) const
+{
+    QTextDocument *doc = m_document;
+    if (!doc || m_blocks.size() != doc->blockCount()) {
+        return NoBracket;
+    }
+    const QTextBlock block = doc->findBlock(position);
+    if (!block.isValid()) {
+        return NoBracket;
+    }
+
+    const int number = block.blockNumber();
+    const int column = position - block.position();
+    const QVector<Token> &tokens = m_blocks.at(number).tokens;
+    const auto at = std::lower_bound(tokens.cbegin(), tokens.cend(), column, [](const Token &token, int value) {
+        return token.column < value;
+    });
+    if (at == tokens.cend() || at->column != column) {
+        return NoBracket;
+    }
+
+    // Walking away from the bracket, brackets of its kind that face the same
+    // way nest one level deeper; the first one facing back at depth 0 pairs.
+    const int kind = at->kind;
+    const bool forward = at->open;
+    int depth = 0;
+    auto pairs = [kind, forward, &depth](const Token &token) {
+        if (token.kind != kind) {
+            return false;
+        }
+        if (token.open == forward) {
+            ++depth;
+            return false;
+        }
+        return depth-- == 0;
+    };
+
+    if (forward) {
+        for (auto it = at + 1; it != tokens.cend(); ++it) {
+            if (pairs(*it)) {
+                return block.position() + it->column;
+            }
+        }
+        ensureTree();
+        const int found = findForward(1, 0, m_leafCount, number + 1, kind, depth);
+        if (found < 0 || found >= m_blocks.size()) {
+            return Unmatched;
+        }
+        for (const Token &token : m_blocks.at(found).tokens) {
+            if (pairs(token)) {
+                return doc->findBlockByNumber(found).position() + token.column;
+            }
+        }
+        return Unmatched;
+    }
+
+    for (auto it = std::make_reverse_iterator(at); it != tokens.crend(); ++it) {
+        if (pairs(*it)) {
+            return block.position() + it->column;
+        }
+    }
+    ensureTree();
+    const int found = findBackward(1, 0, m_leafCount, number, kind, depth);
+    if (found < 0) {
+        return Unmatched;
+    }
+    const QVector<Token> &foundTokens = m_blocks.at(found).tokens;
+    for (auto it = foundTokens.crbegin(); it != foundTokens.crend(); ++it) {
+        if (pairs(*it)) {
+            return doc->findBlockByNumber(found).position() + it->column;
+        }
+    }
+    return Unmatched;
+}
+
+int BracketIndex::prefixDepth(int blocks) const
+{
+    int depth = 0;
+    for (int lo = m_leafCount, hi = m_leafCount + blocks; lo < hi; lo /= 2, hi /= 2) {
+        if (lo & 1) {
+            const Summary &summary = m_tree.at(lo++);
+            depth += summary.delta[0] + summary.delta[1] + summary.delta[2];
+        }
+        if (hi & 1) {
+            const Summary &summary = m_tree.at(--hi);
+            depth += summary.delta[0] + summary.delta[1] + summary.delta[2];
+        }
+    }
+    return depth;
+}
+
+int BracketIndex::depthAt(int position) const
+{
+    QTextDocument *doc = m_document;
+    if (!doc || m_blocks.size() != doc->blockCount()) {
+        return 0;
+    }
+    const QTextBlock block = doc->findBlock(position);
+    if (!block.isValid()) {
+        return 0;
+    }
+
+    ensureTree();
+    const int number = block.blockNumber();
+    const int column = position - block.position();
+    int depth = prefixDepth(number);
+    for (const Token &token : m_blocks.at(number).tokens) {
+        if (token.column >= column) {
+            break;
+        }
+        depth += token.open ? 1 : -1;
+    }
+    return qMax(0, depth);
+}
+
+bool BracketIndex::startsInComment(int block) const
+{
+    return block >= 0 && block < m_blocks.size() && m_blocks.at(block).startsInComment;
+}
+
+} // namespace Fluent
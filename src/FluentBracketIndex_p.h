@@ -0,0 +1,85 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+#include <QtGlobal>
+
+class QString;
+class QTextDocument;
+
+namespace Fluent {
+
+// Bracket positions of a QTextDocument, kept per block and updated from
+// contentsChange, with a segment tree of per-block depth summaries on top so
+// a match is found in O(log n) instead of scanning characters. Brackets in
+// string or character literals and comments are skipped, following the same
+// rules as FluentCppHighlighter: block comments carry over to the next lines,
+// everything else ends with its line.
+class BracketIndex final : public QObject
+{
+public:
+    enum : int {
+        NoBracket = -2, // the position holds no indexed bracket
+        Unmatched = -1,
+    };
+
+    explicit BracketIndex(QTextDocument *document, QObject *parent = nullptr);
+
+    // Position of the bracket pairing with the one at position, Unmatched or
+    // NoBracket.
+    int match(int position) const;
+
+    // Brackets of any kind opened and not yet closed before position; meant
+    // for rainbow brackets and scope guides.
+    int depthAt(int position) const;
+
+    // Whether the block numbered block starts inside a /* */ comment.
+    bool startsInComment(int block) const;
+
+    void rebuild();
+
+private:
+    enum { KindCount = 3 };
+
+    struct Token {
+        int column = 0;
+        quint8 kind = 0;
+        bool open = false;
+    };
+
+    // Per kind, counting an opening bracket +1 and a closing one -1: the
+    // block's total, the lowest running total from its start and the lowest
+    // running total of closing minus opening from its end.
+    struct Summary {
+        int delta[KindCount] = {};
+        int minPrefix[KindCount] = {};
+        int minSuffix[KindCount] = {};
+    };
+
+    struct BlockInfo {
+        QVector<Token> tokens;
+        Summary summary;
+        bool startsInComment = false;
+        bool endsInComment = false;
+    };
+
+    void onContentsChange(int position, int charsRemoved, int charsAdded);
+    static BlockInfo scanBlock(const QString &text, bool startsInComment);
+    static Summary combine(const Summary &left, const Summary &right);
+
+    void ensureTree() const;
+    void updateLeaf(int block) const;
+    int findForward(int node, int lo, int hi, int from, int kind, int &depth) const;
+    int findBackward(int node, int lo, int hi, int to, int kind, int &depth) const;
+    int prefixDepth(int blocks) const;
+
+    QPointer<QTextDocument> m_document;
+    QVector<BlockInfo> m_blocks;
+
+    mutable QVector<Summary> m_tree;
+    mutable int m_leafCount = 0;
+    mutable bool m_treeDirty = true;
+};
+
+} // namespace Fluent
@@ -3,6 +3,8 @@
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
 #include "FluentButtonVisuals_p.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QAbstractAnimation>
 #include <QEvent>
@@ -94,22 +96,8 @@ void FluentButton::initialize()
     setAutoDefault(false);
     setMinimumHeight(Style::metrics().height);
 
-    m_hoverAnim = new QVariantAnimation(this);
-    FluentMotion::configure(m_hoverAnim, FluentMotionRole::Hover);
-    connect(m_hoverAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_hoverLevel = value.toReal();
-        update();
-    });
-
-    m_pressAnim = new QVariantAnimation(this);
-    FluentMotion::configure(m_pressAnim, FluentMotionRole::Press);
-    connect(m_pressAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_pressLevel = value.toReal();
-        update();
-    });
-
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentButton::applyTheme);
+    ThemeRegistry::enroll<&FluentButton::applyTheme>(this);
     connect(this, &QAbstractButton::toggled, this, QOverload<>::of(&FluentButton::update));
 }
 
@@ -249,6 +237,8 @@ void FluentButton::changeEvent(QEvent *event)
 
 void FluentButton::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool pressRunning = m_pressAnim && m_pressAnim->state() == QAbstractAnimation::Running;
     const QVariant hoverEnd = m_hoverAnim ? m_hoverAnim->endValue() : QVariant();
@@ -421,28 +411,16 @@ qreal FluentButton::controlRadiusForRect(const QRectF &rect) const
 
 void FluentButton::startHoverAnimation(qreal endValue)
 {
-    FluentMotion::configure(m_hoverAnim, FluentMotionRole::Hover);
-    m_hoverAnim->stop();
-    if (m_hoverAnim->duration() <= 0) {
-        setHoverLevel(endValue);
-        return;
-    }
-    m_hoverAnim->setStartValue(m_hoverLevel);
-    m_hoverAnim->setEndValue(endValue);
-    m_hoverAnim->start();
+    FluentMotion::animateLevel(this, m_hoverAnim, FluentMotionRole::Hover, m_hoverLevel, endValue, [this](qreal level) {
+        setHoverLevel(level);
+    });
 }
 
 void FluentButton::startPressAnimation(qreal endValue)
 {
-    FluentMotion::configure(m_pressAnim, FluentMotionRole::Press);
-    m_pressAnim->stop();
-    if (m_pressAnim->duration() <= 0) {
-        setPressLevel(endValue);
-        return;
-    }
-    m_pressAnim->setStartValue(m_pressLevel);
-    m_pressAnim->setEndValue(endValue);
-    m_pressAnim->start();
+    FluentMotion::animateLevel(this, m_pressAnim, FluentMotionRole::Press, m_pressLevel, endValue, [this](qreal level) {
+        setPressLevel(level);
+    });
 }
 
 } // namespace Fluent
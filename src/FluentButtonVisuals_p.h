@@ -2,6 +2,7 @@
 
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentSurfaceCache_p.h"
 
 #include <QPainter>
 #include <QPainterPath>
@@ -103,8 +104,10 @@ inline StateColors resolve(const ThemeColors &colors,
 
 inline QColor fillForState(const StateColors &colors, qreal hoverLevel, qreal pressLevel)
 {
-    QColor fill = Style::mix(colors.base, colors.hover, qBound<qreal>(0.0, hoverLevel, 1.0));
-    return Style::mix(fill, colors.pressed, qBound<qreal>(0.0, pressLevel, 1.0));
+    hoverLevel = SurfaceCache::quantizeLevel(qBound<qreal>(0.0, hoverLevel, 1.0));
+    pressLevel = SurfaceCache::quantizeLevel(qBound<qreal>(0.0, pressLevel, 1.0));
+    QColor fill = Style::mix(colors.base, colors.hover, hoverLevel);
+    return Style::mix(fill, colors.pressed, pressLevel);
 }
 
 inline QColor textForState(QColor color, qreal pressLevel, bool enabled)
@@ -149,8 +152,34 @@ inline void paintRoundedControl(QPainter &painter,
                                 const QColor &border,
                                 const QColor &bottomBorder)
 {
-    painter.setPen(border.alpha() > 0 ? QPen(border, 1.0) : Qt::NoPen);
+    // Callers rely on the pen and brush being left set, cached or not.
+    const QPen pen = border.alpha() > 0 ? QPen(border, 1.0) : QPen(Qt::NoPen);
+    painter.setPen(pen);
     painter.setBrush(fill);
+    if (fill.alpha() <= 0 && border.alpha() <= 0 && bottomBorder.alpha() <= 0) {
+        return;
+    }
+
+    SurfaceCache::SurfaceKey key;
+    key.kind = quint32(SurfaceCache::Kind::RoundedControl);
+    key.radius = quint32(qRound(qMax<qreal>(0.0, radius) * 4.0));
+    key.border = border.alpha() > 0 ? 4 : 0;
+    key.fill = fill.rgba();
+    key.stroke = border.rgba();
+    key.accent = bottomBorder.rgba();
+    const bool cached = SurfaceCache::paint(painter, rect, key, qMax<qreal>(0.0, radius) + 2.0,
+                                            [&](QPainter &tile, const QRectF &tileRect) {
+        tile.setPen(pen);
+        tile.setBrush(fill);
+        if (fill.alpha() > 0 || border.alpha() > 0) {
+            tile.drawRoundedRect(tileRect, radius, radius);
+        }
+        paintBottomStroke(tile, tileRect, radius, bottomBorder);
+    });
+    if (cached) {
+        return;
+    }
+
     if (fill.alpha() > 0 || border.alpha() > 0) {
         painter.drawRoundedRect(rect, radius, radius);
     }
@@ -3,6 +3,8 @@
 #include "Fluent/datePicker/FluentCalendarPopup.h"
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 #include "FluentInputVisuals_p.h"
 
 #include <QAbstractAnimation>
@@ -71,7 +73,7 @@ FluentCalendarPicker::FluentCalendarPicker(QWidget *parent)
     }
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentCalendarPicker::applyTheme);
+    ThemeRegistry::enroll<&FluentCalendarPicker::applyTheme>(this);
 }
 
 qreal FluentCalendarPicker::hoverLevel() const
@@ -134,6 +136,8 @@ void FluentCalendarPicker::changeEvent(QEvent *event)
 
 void FluentCalendarPicker::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool focusRunning = m_focusAnim && m_focusAnim->state() == QAbstractAnimation::Running;
     const QVariant hoverEnd = m_hoverAnim ? m_hoverAnim->endValue() : QVariant();
@@ -157,9 +161,7 @@ void FluentCalendarPicker::applyTheme()
                                             "QDateEdit:disabled { color: %2; }")
             .arg(textColor.name(QColor::HexArgb),
                  colors.disabledText.name(QColor::HexArgb));
-        if (styleSheet() != next) {
-            setStyleSheet(next);
-        }
+        ThemeProfiler::setStyleSheetIfChanged(this, next);
     }
     const auto &colors = ThemeManager::instance().colors();
     const auto &tokens = ThemeManager::instance().tokens();
@@ -181,9 +183,7 @@ void FluentCalendarPicker::applyTheme()
                  selectionBg.name(QColor::HexArgb),
                  colors.text.name(QColor::HexArgb),
                  colors.disabledText.name(QColor::HexArgb));
-        if (lineEdit->styleSheet() != next) {
-            lineEdit->setStyleSheet(next);
-        }
+        ThemeProfiler::setStyleSheetIfChanged(lineEdit, next);
 
         QPalette pal = lineEdit->palette();
         pal.setColor(QPalette::WindowText, textColor);
@@ -8,6 +8,8 @@
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
 #include "Fluent/FluentToolButton.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QAbstractAnimation>
 #include <QAbstractButton>
@@ -167,7 +169,7 @@ FluentCard::FluentCard(QWidget *parent)
     });
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentCard::applyTheme);
+    ThemeRegistry::enroll<&FluentCard::applyTheme>(this);
 }
 
 void FluentCard::setCollapsible(bool on)
@@ -383,6 +385,8 @@ bool FluentCard::eventFilter(QObject *watched, QEvent *event)
 
 void FluentCard::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const QVariant hoverEnd = m_hoverAnim ? m_hoverAnim->endValue() : QVariant();
     const bool collapseRunning = m_collapseAnim
@@ -2,6 +2,8 @@
 #include "Fluent/FluentMotion.h"
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QAbstractAnimation>
 #include <QEvent>
@@ -17,41 +19,18 @@ FluentCheckBox::FluentCheckBox(QWidget *parent)
     setAttribute(Qt::WA_Hover, true);
     setFocusPolicy(Qt::StrongFocus);
 
-    m_hoverAnim = new QVariantAnimation(this);
-    connect(m_hoverAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_hoverLevel = value.toReal();
-        update();
-    });
-
-    m_focusAnim = new QVariantAnimation(this);
-    connect(m_focusAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_focusLevel = value.toReal();
-        update();
-    });
-
-    m_checkAnim = new QVariantAnimation(this);
-    connect(m_checkAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_checkLevel = value.toReal();
-        update();
-    });
     connect(this, &QCheckBox::stateChanged, this, [this](int state) {
-        FluentMotion::configure(m_checkAnim, FluentMotionRole::Selection);
-        m_checkAnim->stop();
         const Qt::CheckState nextState = static_cast<Qt::CheckState>(state);
         const qreal target = nextState == Qt::Unchecked ? 0.0 : 1.0;
-        if (m_checkAnim->duration() <= 0) {
-            m_checkLevel = target;
+        FluentMotion::animateLevel(this, m_checkAnim, FluentMotionRole::Selection, m_checkLevel, target, [this](qreal level) {
+            m_checkLevel = level;
             update();
-        } else {
-            m_checkAnim->setStartValue(m_checkLevel);
-            m_checkAnim->setEndValue(target);
-            m_checkAnim->start();
-        }
+        });
     });
     m_checkLevel = checkState() == Qt::Unchecked ? 0.0 : 1.0;
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentCheckBox::applyTheme);
+    ThemeRegistry::enroll<&FluentCheckBox::applyTheme>(this);
 }
 
 FluentCheckBox::FluentCheckBox(const QString &text, QWidget *parent)
@@ -61,41 +40,18 @@ FluentCheckBox::FluentCheckBox(const QString &text, QWidget *parent)
     setAttribute(Qt::WA_Hover, true);
     setFocusPolicy(Qt::StrongFocus);
 
-    m_hoverAnim = new QVariantAnimation(this);
-    connect(m_hoverAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_hoverLevel = value.toReal();
-        update();
-    });
-
-    m_focusAnim = new QVariantAnimation(this);
-    connect(m_focusAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_focusLevel = value.toReal();
-        update();
-    });
-
-    m_checkAnim = new QVariantAnimation(this);
-    connect(m_checkAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_checkLevel = value.toReal();
-        update();
-    });
     connect(this, &QCheckBox::stateChanged, this, [this](int state) {
-        FluentMotion::configure(m_checkAnim, FluentMotionRole::Selection);
-        m_checkAnim->stop();
         const Qt::CheckState nextState = static_cast<Qt::CheckState>(state);
         const qreal target = nextState == Qt::Unchecked ? 0.0 : 1.0;
-        if (m_checkAnim->duration() <= 0) {
-            m_checkLevel = target;
+        FluentMotion::animateLevel(this, m_checkAnim, FluentMotionRole::Selection, m_checkLevel, target, [this](qreal level) {
+            m_checkLevel = level;
             update();
-        } else {
-            m_checkAnim->setStartValue(m_checkLevel);
-            m_checkAnim->setEndValue(target);
-            m_checkAnim->start();
-        }
+        });
     });
     m_checkLevel = checkState() == Qt::Unchecked ? 0.0 : 1.0;
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentCheckBox::applyTheme);
+    ThemeRegistry::enroll<&FluentCheckBox::applyTheme>(this);
 }
 
 QSize FluentCheckBox::sizeHint() const
@@ -147,6 +103,8 @@ void FluentCheckBox::changeEvent(QEvent *event)
 
 void FluentCheckBox::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool snapHover = m_hoverAnim &&
         m_hoverAnim->state() == QAbstractAnimation::Running &&
         FluentMotion::duration(FluentMotionRole::Hover) <= 0;
@@ -321,28 +279,16 @@ void FluentCheckBox::focusOutEvent(QFocusEvent *event)
 
 void FluentCheckBox::startHoverAnimation(qreal endValue)
 {
-    FluentMotion::configure(m_hoverAnim, FluentMotionRole::Hover);
-    m_hoverAnim->stop();
-    if (m_hoverAnim->duration() <= 0) {
-        setHoverLevel(endValue);
-        return;
-    }
-    m_hoverAnim->setStartValue(m_hoverLevel);
-    m_hoverAnim->setEndValue(endValue);
-    m_hoverAnim->start();
+    FluentMotion::animateLevel(this, m_hoverAnim, FluentMotionRole::Hover, m_hoverLevel, endValue, [this](qreal level) {
+        setHoverLevel(level);
+    });
 }
 
 void FluentCheckBox::startFocusAnimation(qreal endValue)
 {
-    FluentMotion::configure(m_focusAnim, FluentMotionRole::Focus);
-    m_focusAnim->stop();
-    if (m_focusAnim->duration() <= 0) {
-        setFocusLevel(endValue);
-        return;
-    }
-    m_focusAnim->setStartValue(m_focusLevel);
-    m_focusAnim->setEndValue(endValue);
-    m_focusAnim->start();
+    FluentMotion::animateLevel(this, m_focusAnim, FluentMotionRole::Focus, m_focusLevel, endValue, [this](qreal level) {
+        setFocusLevel(level);
+    });
 }
 
 } // namespace Fluent
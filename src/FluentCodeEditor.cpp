@@ -6,29 +6,52 @@
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
 #include "Fluent/FluentToolTip.h"
+#include "FluentBracketIndex_p.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentTextDiff_p.h"
 
 #include <QAbstractAnimation>
+#include <QAbstractTextDocumentLayout>
 #include <QAction>
+#include <QAtomicInt>
+#include <QCache>
+#include <QCoreApplication>
+#include <QCryptographicHash>
 #include <QEvent>
 #include <QFileInfo>
 #include <QFocusEvent>
+#include <QHash>
 #include <QInputMethodEvent>
 #include <QKeyEvent>
+#include <QMetaObject>
 #include <QPainter>
 #include <QPainterPath>
 #include <QPen>
+#include <QPixmap>
+#include <QPointer>
 #include <QProcess>
 #include <QRegularExpression>
 #include <QResizeEvent>
+#include <QRunnable>
 #include <QScrollBar>
+#include <QSharedPointer>
 #include <QShowEvent>
+#include <QSignalBlocker>
 #include <QStandardPaths>
+#include <QStaticText>
 #include <QTextBlock>
 #include <QTextCursor>
+#include <QTextDocument>
+#include <QTextLayout>
+#include <QThreadPool>
 #include <QTimer>
 #include <QToolTip>
 #include <QVariantAnimation>
 
+#include <algorithm>
+#include <functional>
+#include <utility>
+
 namespace Fluent {
 
 namespace {
@@ -141,42 +164,177 @@ public:
 
     QSize sizeHint() const override { return {m_editor->lineNumberAreaWidth(), 0}; }
 
+    void invalidate()
+    {
+        layer.valid = false;
+        numbers.clear();
+        currentNumbers.clear();
+    }
+
+    // Line fills and numbers of the visible lines, repainted only when what
+    // they show changes and shifted on scroll; paint events composite it over
+    // the cached background path.
+    struct Layer {
+        QPixmap pixmap;
+        bool valid = false;
+        int pendingDy = 0;
+        QSize size;
+        qreal dpr = 0.0;
+        int revision = -1;
+        int blockCount = -1;
+        int viewportWidth = -1;
+        QSizeF documentSize;
+        int cursorPosition = -1;
+        int cursorAnchor = -1;
+        int firstBlock = -1;
+        int firstTop = 0;
+        int currentLine = -1;
+        int selectionStart = -1;
+        int selectionEnd = -1;
+    } layer;
+
+    QPainterPath backgroundPath;
+    QSize backgroundSize;
+    qreal backgroundRadius = -1.0;
+
+    QHash<int, QStaticText> numbers;
+    QHash<int, QStaticText> currentNumbers;
+
 protected:
     void paintEvent(QPaintEvent *event) override { m_editor->lineNumberAreaPaintEvent(event); }
 
+    void changeEvent(QEvent *event) override
+    {
+        QWidget::changeEvent(event);
+        if (event->type() == QEvent::FontChange) {
+            invalidate();
+        }
+    }
+
 private:
     FluentCodeEditor *m_editor = nullptr;
 };
 
 namespace {
 
-static bool isOpenBracket(QChar c)
+class FormatJobTask final : public QRunnable
 {
-    return c == QLatin1Char('(') || c == QLatin1Char('{') || c == QLatin1Char('[');
+public:
+    explicit FormatJobTask(std::function<void()> work)
+        : m_work(std::move(work))
+    {
+        setAutoDelete(true);
+    }
+
+    void run() override
+    {
+        m_work();
+    }
+
+private:
+    std::function<void()> m_work;
+};
+
+void postToGuiThread(std::function<void()> fn)
+{
+    if (QCoreApplication *app = QCoreApplication::instance()) {
+        QMetaObject::invokeMethod(app, std::move(fn), Qt::QueuedConnection);
+    }
 }
 
-static bool isCloseBracket(QChar c)
+// clang-format output of recent runs, shared by every editor and costed in
+// bytes. Keyed by executable, arguments and input text, so formatting content
+// that was formatted before does not start a process.
+QCache<QByteArray, QByteArray> &formatResultCache()
 {
-    return c == QLatin1Char(')') || c == QLatin1Char('}') || c == QLatin1Char(']');
+    static QCache<QByteArray, QByteArray> cache(8 * 1024 * 1024);
+    return cache;
 }
 
-static QChar matchingBracket(QChar c)
+QByteArray formatCacheKey(const QString &program, const QStringList &arguments, const QByteArray &input)
 {
-    switch (c.unicode()) {
-    case '(':
-        return QLatin1Char(')');
-    case ')':
-        return QLatin1Char('(');
-    case '{':
-        return QLatin1Char('}');
-    case '}':
-        return QLatin1Char('{');
-    case '[':
-        return QLatin1Char(']');
-    case ']':
-        return QLatin1Char('[');
-    default:
-        return QChar();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(program.toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(arguments.join(QLatin1Char('\n')).toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(input);
+    return hash.result();
+}
+
+// Edits the document from oldLines (one per block) to newLines. Hunks are
+// applied back to front so the block numbers of earlier ones stay valid; a
+// hunk that swaps lines one for one rewrites only the differing middle of
+// each line, so those blocks survive with their layout and highlighter state.
+void applyLineHunks(QTextCursor &cursor,
+                    const QStringList &oldLines,
+                    const QStringList &newLines,
+                    const QVector<TextDiff::Hunk> &hunks)
+{
+    QTextDocument *document = cursor.document();
+    const int lineCount = static_cast<int>(oldLines.size());
+
+    for (int i = static_cast<int>(hunks.size()) - 1; i >= 0; --i) {
+        const TextDiff::Hunk &hunk = hunks.at(i);
+
+        if (hunk.oldCount == hunk.newCount) {
+            for (int line = 0; line < hunk.oldCount; ++line) {
+                const QString &from = oldLines.at(hunk.oldStart + line);
+                const QString &to = newLines.at(hunk.newStart + line);
+                const int fromSize = static_cast<int>(from.size());
+                const int toSize = static_cast<int>(to.size());
+                const int shorter = qMin(fromSize, toSize);
+                int prefix = 0;
+                while (prefix < shorter && from.at(prefix) == to.at(prefix)) {
+                    ++prefix;
+                }
+                int suffix = 0;
+                while (suffix < shorter - prefix && from.at(fromSize - 1 - suffix) == to.at(toSize - 1 - suffix)) {
+                    ++suffix;
+                }
+                if (prefix == fromSize && prefix == toSize) {
+                    continue;
+                }
+                const int start = document->findBlockByNumber(hunk.oldStart + line).position();
+                cursor.setPosition(start + prefix);
+                cursor.setPosition(start + fromSize - suffix, QTextCursor::KeepAnchor);
+                cursor.insertText(to.mid(prefix, toSize - prefix - suffix));
+            }
+            continue;
+        }
+
+        const QString text = newLines.mid(hunk.newStart, hunk.newCount).join(QLatin1Char('\n'));
+        if (hunk.oldCount == 0) {
+            if (hunk.oldStart < lineCount) {
+                cursor.setPosition(document->findBlockByNumber(hunk.oldStart).position());
+                cursor.insertText(text + QLatin1Char('\n'));
+            } else {
+                cursor.movePosition(QTextCursor::End);
+                cursor.insertText(QLatin1Char('\n') + text);
+            }
+            continue;
+        }
+
+        const QTextBlock first = document->findBlockByNumber(hunk.oldStart);
+        const QTextBlock last = document->findBlockByNumber(hunk.oldStart + hunk.oldCount - 1);
+        int from = first.position();
+        int to = last.position() + last.length() - 1;
+        if (hunk.newCount == 0) {
+            // Removed lines take one line break with them: their own, or the
+            // one before them when they run to the end of the document.
+            if (hunk.oldStart + hunk.oldCount < lineCount) {
+                ++to;
+            } else {
+                --from;
+            }
+        }
+        cursor.setPosition(from);
+        cursor.setPosition(to, QTextCursor::KeepAnchor);
+        if (hunk.newCount == 0) {
+            cursor.removeSelectedText();
+        } else {
+            cursor.insertText(text);
+        }
     }
 }
 
@@ -262,6 +420,8 @@ FluentCodeEditor::FluentCodeEditor(QWidget *parent)
     m_borderOverlay->setGeometry(rect());
     m_borderOverlay->hide();
 
+    m_bracketIndex = new BracketIndex(document(), this);
+
     connect(this, &QPlainTextEdit::blockCountChanged, this, [this] { updateLineNumberAreaWidth(); });
     connect(this, &QPlainTextEdit::updateRequest, this, &FluentCodeEditor::updateLineNumberArea);
     connect(this, &QPlainTextEdit::cursorPositionChanged, this, [this] { updateExtraSelections(); });
@@ -278,32 +438,6 @@ FluentCodeEditor::FluentCodeEditor(QWidget *parent)
 
     m_clangFormatPath = findDefaultClangFormat();
 
-    m_hoverAnim = new QVariantAnimation(this);
-    FluentMotion::configure(m_hoverAnim, FluentMotionRole::Hover);
-    connect(m_hoverAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &v) {
-        m_hoverLevel = qBound<qreal>(0.0, v.toReal(), 1.0);
-        update();
-        if (m_lineNumberArea) {
-            m_lineNumberArea->update();
-        }
-        if (m_borderOverlay) {
-            m_borderOverlay->update();
-        }
-    });
-
-    m_focusAnim = new QVariantAnimation(this);
-    FluentMotion::configure(m_focusAnim, FluentMotionRole::Focus);
-    connect(m_focusAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &v) {
-        m_focusLevel = qBound<qreal>(0.0, v.toReal(), 1.0);
-        update();
-        if (m_lineNumberArea) {
-            m_lineNumberArea->update();
-        }
-        if (m_borderOverlay) {
-            m_borderOverlay->update();
-        }
-    });
-
     connect(this, &FluentCodeEditor::clangFormatAvailabilityChanged, this, [this](bool available) {
         if (!m_formatAction) {
             return;
@@ -323,6 +457,7 @@ FluentCodeEditor::FluentCodeEditor(QWidget *parent)
         updateExtraSelections();
         viewport()->update();
         if (m_lineNumberArea) {
+            m_lineNumberArea->invalidate();
             m_lineNumberArea->update();
         }
     });
@@ -331,6 +466,24 @@ FluentCodeEditor::FluentCodeEditor(QWidget *parent)
     m_autoFormatTimer->setSingleShot(true);
     m_autoFormatTimer->setInterval(m_autoFormatDebounceMs);
 
+    m_visibleHighlightTimer = new QTimer(this);
+    m_visibleHighlightTimer->setSingleShot(true);
+    m_visibleHighlightTimer->setInterval(0);
+    connect(m_visibleHighlightTimer, &QTimer::timeout, this, &FluentCodeEditor::highlightVisibleBlocks);
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, this, [this] { scheduleVisibleHighlight(); });
+
+    // Connected ahead of the highlighter, so a document that just became
+    // large is taken from it before it formats every block.
+    connect(document(), &QTextDocument::contentsChange, this, [this](int position, int, int charsAdded) {
+        if (m_loading && !m_internalChange) {
+            // Someone else replaced or edited the text mid-load.
+            endLoad();
+        }
+        updateLargeFileMode();
+        trackDirtyLines(position, charsAdded);
+        scheduleVisibleHighlight();
+    });
+
     connect(this, &QPlainTextEdit::textChanged, this, [this] {
         if (m_internalChange) {
             return;
@@ -341,7 +494,7 @@ FluentCodeEditor::FluentCodeEditor(QWidget *parent)
     });
 
     connect(m_autoFormatTimer, &QTimer::timeout, this, [this] {
-        if (!m_autoFormatEnabled) {
+        if (!m_autoFormatEnabled || m_largeFileMode) {
             return;
         }
         if (isReadOnly()) {
@@ -353,10 +506,17 @@ FluentCodeEditor::FluentCodeEditor(QWidget *parent)
             m_autoFormatTimer->start();
             return;
         }
-        if (document()->characterCount() > m_maxAutoFormatChars) {
+        if (m_dirtyLines.isEmpty()) {
+            // Nothing was edited since the last format.
             return;
         }
-        formatDocumentNow();
+        // clang-format only rewrites the edited lines, so the size limit
+        // guards whole-document formatting with the basic formatter.
+        const bool changedLinesOnly = clangFormatAvailable();
+        if (!changedLinesOnly && document()->characterCount() > m_maxAutoFormatChars) {
+            return;
+        }
+        startFormat(changedLinesOnly);
     });
 
     ensureHighlighter();
@@ -410,6 +570,8 @@ void FluentCodeEditor::setFocusLevel(qreal value)
 
 void FluentCodeEditor::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool focusRunning = m_focusAnim && m_focusAnim->state() == QAbstractAnimation::Running;
     const QVariant hoverEnd = m_hoverAnim ? m_hoverAnim->endValue() : QVariant();
@@ -443,9 +605,7 @@ void FluentCodeEditor::applyTheme()
              colors.text.name(QColor::HexArgb),
              colors.disabledText.name(QColor::HexArgb));
 
-    if (styleSheet() != next) {
-        setStyleSheet(next);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(this, next);
 
     QPalette pal = palette();
     pal.setColor(QPalette::Base, QColor(Qt::transparent));
@@ -542,40 +702,23 @@ void FluentCodeEditor::showEvent(QShowEvent *event)
     if (m_borderOverlay) {
         m_borderOverlay->raise();
     }
+    scheduleVisibleHighlight();
 }
 
 void FluentCodeEditor::startHoverAnimation(qreal to)
 {
-    if (!m_hoverAnim) {
-        setHoverLevel(to);
-        return;
-    }
-    FluentMotion::configure(m_hoverAnim, FluentMotionRole::Hover);
-    m_hoverAnim->stop();
-    if (m_hoverAnim->duration() <= 0) {
-        setHoverLevel(to);
-        return;
-    }
-    m_hoverAnim->setStartValue(m_hoverLevel);
-    m_hoverAnim->setEndValue(qBound<qreal>(0.0, to, 1.0));
-    m_hoverAnim->start();
+    const qreal target = qBound<qreal>(0.0, to, 1.0);
+    FluentMotion::animateLevel(this, m_hoverAnim, FluentMotionRole::Hover, m_hoverLevel, target, [this](qreal level) {
+        setHoverLevel(level);
+    });
 }
 
 void FluentCodeEditor::startFocusAnimation(qreal to)
 {
-    if (!m_focusAnim) {
-        setFocusLevel(to);
-        return;
-    }
-    FluentMotion::configure(m_focusAnim, FluentMotionRole::Focus);
-    m_focusAnim->stop();
-    if (m_focusAnim->duration() <= 0) {
-        setFocusLevel(to);
-        return;
-    }
-    m_focusAnim->setStartValue(m_focusLevel);
-    m_focusAnim->setEndValue(qBound<qreal>(0.0, to, 1.0));
-    m_focusAnim->start();
+    const qreal target = qBound<qreal>(0.0, to, 1.0);
+    FluentMotion::animateLevel(this, m_focusAnim, FluentMotionRole::Focus, m_focusLevel, target, [this](qreal level) {
+        setFocusLevel(level);
+    });
 }
 
 void FluentCodeEditor::focusInEvent(QFocusEvent *event)
@@ -659,19 +802,252 @@ bool FluentCodeEditor::bracketMatchHighlightEnabled() const
     return m_bracketMatchHighlightEnabled;
 }
 
+int FluentCodeEditor::bracketDepthAt(int position) const
+{
+    return m_bracketIndex->depthAt(position);
+}
+
 void FluentCodeEditor::ensureHighlighter()
 {
-    if (!m_cppHighlightingEnabled) {
-        if (m_highlighter) {
-            delete m_highlighter;
-            m_highlighter = nullptr;
+    // In large-file mode nothing is attached to the document;
+    // highlightVisibleBlocks() formats the lines on screen instead.
+    const bool attached = m_cppHighlightingEnabled && !m_largeFileMode;
+    if (!attached && m_highlighter) {
+        releaseHighlighter();
+    }
+    if (!m_largeFileMode && m_parkedHighlighter) {
+        delete m_parkedHighlighter;
+    }
+    if (attached && !m_highlighter) {
+        m_highlighter = new FluentCppHighlighter(document());
+    }
+
+    const bool visibleOnly = m_cppHighlightingEnabled && m_largeFileMode;
+    if (visibleOnly && !m_visibleHighlighter) {
+        m_visibleHighlighter = new FluentCppHighlighter(nullptr);
+        m_visibleHighlighter->setParent(this);
+    } else if (!visibleOnly && m_visibleHighlighter) {
+        delete m_visibleHighlighter;
+        m_visibleHighlighter = nullptr;
+    }
+    scheduleVisibleHighlight();
+}
+
+void FluentCodeEditor::releaseHighlighter()
+{
+    if (!m_largeFileMode || document()->isEmpty()) {
+        delete m_highlighter;
+        m_highlighter = nullptr;
+        return;
+    }
+
+    // Deleting a QSyntaxHighlighter clears the formats of every block, which
+    // creates a layout for each of them; cut it loose from a document that
+    // just became large instead and delete it once the document is small.
+    // The posted call is the full rehighlight it queues when attached to a
+    // document that has text.
+    disconnect(document(), nullptr, m_highlighter, nullptr);
+    disconnect(&ThemeManager::instance(), nullptr, m_highlighter, nullptr);
+    QCoreApplication::removePostedEvents(m_highlighter, QEvent::MetaCall);
+    m_parkedHighlighter = m_highlighter;
+    m_highlighter = nullptr;
+}
+
+void FluentCodeEditor::setLargeFileCharacterThreshold(int chars)
+{
+    m_largeFileCharThreshold = qMax(0, chars);
+    updateLargeFileMode();
+}
+
+int FluentCodeEditor::largeFileCharacterThreshold() const
+{
+    return m_largeFileCharThreshold;
+}
+
+void FluentCodeEditor::setLargeFileLineThreshold(int lines)
+{
+    m_largeFileLineThreshold = qMax(0, lines);
+    updateLargeFileMode();
+}
+
+int FluentCodeEditor::largeFileLineThreshold() const
+{
+    return m_largeFileLineThreshold;
+}
+
+bool FluentCodeEditor::largeFileMode() const
+{
+    return m_largeFileMode;
+}
+
+void FluentCodeEditor::updateLargeFileMode()
+{
+    if (m_loading) {
+        return;
+    }
+    const QTextDocument *doc = document();
+    const bool large = (m_largeFileCharThreshold > 0 && doc->characterCount() > m_largeFileCharThreshold)
+                       || (m_largeFileLineThreshold > 0 && doc->blockCount() > m_largeFileLineThreshold);
+    setLargeFileMode(large);
+}
+
+void FluentCodeEditor::setLargeFileMode(bool enabled)
+{
+    if (m_largeFileMode == enabled) {
+        return;
+    }
+    m_largeFileMode = enabled;
+
+    if (!enabled && !m_cppHighlightingEnabled) {
+        // Lines highlighted while they were visible keep their formats;
+        // the document is small enough again to sweep them all.
+        const QSignalBlocker blocker(document());
+        for (QTextBlock block = document()->begin(); block.isValid(); block = block.next()) {
+            if (!block.layout()->formats().isEmpty()) {
+                block.layout()->clearFormats();
+                document()->markContentsDirty(block.position(), block.length());
+            }
         }
+    }
+    ensureHighlighter();
+    if (enabled) {
+        m_autoFormatTimer->stop();
+    }
+    emit largeFileModeChanged(enabled);
+}
+
+void FluentCodeEditor::scheduleVisibleHighlight()
+{
+    if (m_largeFileMode && m_visibleHighlightTimer) {
+        m_visibleHighlightTimer->start();
+    }
+}
+
+void FluentCodeEditor::highlightVisibleBlocks()
+{
+    if (!m_largeFileMode) {
         return;
     }
 
-    if (!m_highlighter) {
-        m_highlighter = new FluentCppHighlighter(document());
+    QTextDocument *doc = document();
+    QTextBlock block = firstVisibleBlock();
+    if (!block.isValid()) {
+        return;
+    }
+    // The bracket index follows the same comment rules, so it knows the
+    // state the first visible line starts in without highlighting above it.
+    int state = m_bracketIndex->startsInComment(block.blockNumber()) ? 1 : 0;
+    const QPointF offset = contentOffset();
+    const qreal bottom = viewport()->height();
+
+    // Only the layouts change; the text, and so everyone listening to the
+    // document, is unaffected.
+    const QSignalBlocker blocker(doc);
+    QVector<QTextLayout::FormatRange> ranges;
+    for (; block.isValid(); block = block.next()) {
+        if (blockBoundingGeometry(block).translated(offset).top() > bottom) {
+            break;
+        }
+        // Without highlighting, lines keep losing formats left from before
+        // it was turned off as they scroll into view.
+        if (m_visibleHighlighter) {
+            state = m_visibleHighlighter->formatLine(block.text(), state, &ranges);
+        }
+        QTextLayout *layout = block.layout();
+        if (layout->formats() != ranges) {
+            layout->setFormats(ranges);
+            doc->markContentsDirty(block.position(), block.length());
+        }
+    }
+}
+
+void FluentCodeEditor::loadPlainText(const QString &text)
+{
+    if (m_loading) {
+        endLoad();
+    }
+
+    const qint64 total = text.size();
+    const int lines = static_cast<int>(text.count(QLatin1Char('\n'))) + 1;
+    const bool large = (m_largeFileCharThreshold > 0 && total + 1 > m_largeFileCharThreshold)
+                       || (m_largeFileLineThreshold > 0 && lines > m_largeFileLineThreshold);
+    if (!large) {
+        setPlainText(text);
+        emit loadProgress(total, total);
+        emit loadFinished();
+        return;
+    }
+
+    m_loadReadOnly = isReadOnly();
+    m_loading = true;
+
+    // Empty the document and drop the highlighter before any of the text
+    // arrives, so neither has to walk the whole file.
+    m_internalChange = true;
+    clear();
+    m_internalChange = false;
+    setLargeFileMode(true);
+
+    m_loadText = text;
+    m_loadOffset = 0;
+    document()->setUndoRedoEnabled(false);
+    setReadOnly(true);
+    emit loadProgress(0, total);
+    QTimer::singleShot(0, this, [this, token = m_loadToken] {
+        if (token == m_loadToken) {
+            loadNextChunk();
+        }
+    });
+}
+
+bool FluentCodeEditor::isLoading() const
+{
+    return m_loading;
+}
+
+void FluentCodeEditor::loadNextChunk()
+{
+    // Whole lines only, so each chunk just appends blocks.
+    const int total = static_cast<int>(m_loadText.size());
+    int end = qMin(total, m_loadOffset + 256 * 1024);
+    if (end < total) {
+        const int newline = static_cast<int>(m_loadText.indexOf(QLatin1Char('\n'), end));
+        end = newline < 0 ? total : newline + 1;
+    }
+
+    QTextCursor cursor(document());
+    cursor.movePosition(QTextCursor::End);
+    m_internalChange = true;
+    cursor.insertText(m_loadText.mid(m_loadOffset, end - m_loadOffset));
+    m_internalChange = false;
+    m_loadOffset = end;
+    emit loadProgress(end, total);
+
+    if (end < total) {
+        QTimer::singleShot(0, this, [this, token = m_loadToken] {
+            if (token == m_loadToken) {
+                loadNextChunk();
+            }
+        });
+        return;
     }
+
+    endLoad();
+    document()->setModified(false);
+    m_dirtyLines.clear();
+    moveCursor(QTextCursor::Start);
+    updateLargeFileMode();
+    emit loadFinished();
+}
+
+void FluentCodeEditor::endLoad()
+{
+    ++m_loadToken;
+    m_loading = false;
+    m_loadText.clear();
+    m_loadOffset = 0;
+    document()->setUndoRedoEnabled(true);
+    setReadOnly(m_loadReadOnly);
 }
 
 void FluentCodeEditor::setCppHighlightingEnabled(bool enabled)
@@ -802,7 +1178,7 @@ int FluentCodeEditor::maxAutoFormatCharacters() const
 
 void FluentCodeEditor::scheduleAutoFormat()
 {
-    if (!m_autoFormatEnabled) {
+    if (!m_autoFormatEnabled || m_largeFileMode) {
         return;
     }
     if (isReadOnly()) {
@@ -817,16 +1193,23 @@ void FluentCodeEditor::scheduleAutoFormat()
 
 void FluentCodeEditor::formatDocumentNow()
 {
-    if (m_clangProc && m_clangProc->state() != QProcess::NotRunning) {
+    startFormat(false);
+}
+
+void FluentCodeEditor::startFormat(bool changedLinesOnly)
+{
+    if ((m_clangProc && m_clangProc->state() != QProcess::NotRunning) || m_formatJobRunning) {
         m_formatPending = true;
         return;
     }
 
     snapshotCursor(this, m_cursorBlock, m_cursorColumn, m_anchorBlock, m_anchorColumn, m_hadSelection);
     m_formatStartRevision = document()->revision();
+    m_formatTimer.start();
+    emit formatStarted();
 
     if (clangFormatAvailable()) {
-        runClangFormatAsync();
+        runClangFormatAsync(changedLinesOnly);
         m_manualFormatTriggered = false;
         return;
     }
@@ -843,10 +1226,7 @@ void FluentCodeEditor::formatDocumentNow()
         }
     }
 
-    const QString input = toPlainText();
-    const QString formatted = runBasicFormatter(input);
-    const bool applied = applyFormattedText(formatted);
-    emit formatFinished(applied);
+    startFormatJob(QString(), true);
 }
 
 int FluentCodeEditor::lineNumberAreaWidth() const
@@ -888,11 +1268,14 @@ void FluentCodeEditor::updateLineNumberArea(const QRect &rect, int dy)
     }
     const int yOffset = viewport() ? viewport()->geometry().top() : 0;
     if (dy) {
-        m_lineNumberArea->scroll(0, dy);
+        // The gutter is translucent, so QWidget::scroll() could not blit it
+        // anyway; shift the cached line layer instead.
+        m_lineNumberArea->layer.pendingDy += dy;
+        m_lineNumberArea->update();
     } else {
         m_lineNumberArea->update(0, rect.y() + yOffset, m_lineNumberArea->width(), rect.height());
     }
-    if (rect.contains(viewport()->rect())) {
+    if (rect.contains(viewport()->rect()) && lineNumberAreaWidth() != m_lineNumberArea->width()) {
         updateLineNumberAreaWidth();
     }
 }
@@ -903,6 +1286,7 @@ void FluentCodeEditor::resizeEvent(QResizeEvent *event)
     if (m_borderOverlay) {
         m_borderOverlay->setGeometry(rect());
     }
+    scheduleVisibleHighlight();
     if (!m_lineNumberArea) {
         return;
     }
@@ -916,53 +1300,97 @@ void FluentCodeEditor::lineNumberAreaPaintEvent(QPaintEvent *event)
         return;
     }
 
-    QPainter painter(m_lineNumberArea);
-    painter.setRenderHint(QPainter::Antialiasing, false);
-
-    const auto tokens = ThemeManager::instance().tokens();
-    const auto colors = tokens.legacyColors;
+    FluentCodeEditorLineNumberArea *area = m_lineNumberArea;
+    const auto &tokens = ThemeManager::instance().tokens();
     const auto m = Style::metrics();
-    const QColor gutter = codeEditorGutterFill(tokens);
 
-    const QRectF gutterRect = QRectF(m_lineNumberArea->rect());
+    const QRectF gutterRect = QRectF(area->rect());
     const qreal radius = qMax<qreal>(0.0, qMin<qreal>(m.radius, gutterRect.height() * 0.5));
-
-    QPainterPath gutterPath;
-    gutterPath.moveTo(gutterRect.topRight());
-    gutterPath.lineTo(gutterRect.topLeft() + QPointF(radius, 0.0));
-    gutterPath.quadTo(gutterRect.topLeft(), gutterRect.topLeft() + QPointF(0.0, radius));
-    gutterPath.lineTo(gutterRect.bottomLeft() + QPointF(0.0, -radius));
-    gutterPath.quadTo(gutterRect.bottomLeft(), gutterRect.bottomLeft() + QPointF(radius, 0.0));
-    gutterPath.lineTo(gutterRect.bottomRight());
-    gutterPath.closeSubpath();
+    if (area->backgroundSize != area->size() || area->backgroundRadius != radius) {
+        QPainterPath gutterPath;
+        gutterPath.moveTo(gutterRect.topRight());
+        gutterPath.lineTo(gutterRect.topLeft() + QPointF(radius, 0.0));
+        gutterPath.quadTo(gutterRect.topLeft(), gutterRect.topLeft() + QPointF(0.0, radius));
+        gutterPath.lineTo(gutterRect.bottomLeft() + QPointF(0.0, -radius));
+        gutterPath.quadTo(gutterRect.bottomLeft(), gutterRect.bottomLeft() + QPointF(radius, 0.0));
+        gutterPath.lineTo(gutterRect.bottomRight());
+        gutterPath.closeSubpath();
+        area->backgroundPath = gutterPath;
+        area->backgroundSize = area->size();
+        area->backgroundRadius = radius;
+    }
+
+    updateLineNumberLayer();
+
+    QPainter painter(area);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.fillPath(area->backgroundPath, codeEditorGutterFill(tokens));
+    painter.setRenderHint(QPainter::Antialiasing, false);
 
     painter.save();
-    painter.setRenderHint(QPainter::Antialiasing, true);
-    painter.fillPath(gutterPath, gutter);
+    painter.setClipPath(area->backgroundPath);
+    painter.drawPixmap(0, 0, area->layer.pixmap);
     painter.restore();
 
-    painter.save();
-    painter.setClipPath(gutterPath);
+    // subtle divider line
+    painter.setPen(tokens.neutral.strokeSubtle);
+    painter.drawLine(area->width() - 1, event->rect().top(), area->width() - 1, event->rect().bottom());
+}
 
-    const QColor selectionBg = codeEditorSelectionFill(tokens, tokens.dark ? 0.28 : 0.18);
-    const QColor currentLineBg = codeEditorLineFill(tokens, tokens.dark ? 0.24 : 0.18);
+void FluentCodeEditor::updateLineNumberLayer()
+{
+    FluentCodeEditorLineNumberArea::Layer &layer = m_lineNumberArea->layer;
+    const QSize size = m_lineNumberArea->size();
+    const qreal dpr = m_lineNumberArea->devicePixelRatioF();
+    const QTextCursor cursor = textCursor();
+    const int revision = document()->revision();
+    // Rewrapping changes line heights without touching the text.
+    const int viewportWidth = viewport() ? viewport()->width() : 0;
+    const QSizeF documentSize = document()->documentLayout()->documentSize();
 
-    QTextBlock block = firstVisibleBlock();
-    int blockNumber = block.blockNumber();
+    const QTextBlock first = firstVisibleBlock();
     const int yOffset = viewport() ? viewport()->geometry().top() : 0;
-    int top = qRound(blockBoundingGeometry(block).translated(contentOffset()).top()) + yOffset;
-    int bottom = top + qRound(blockBoundingRect(block).height());
+    const int firstTop = qRound(blockBoundingGeometry(first).translated(contentOffset()).top()) + yOffset;
+
+    const int dy = layer.pendingDy;
+    layer.pendingDy = 0;
+    const bool sameLines = layer.valid && layer.size == size && qFuzzyCompare(layer.dpr, dpr)
+                           && layer.revision == revision && layer.blockCount == blockCount()
+                           && layer.viewportWidth == viewportWidth && layer.documentSize == documentSize
+                           && layer.cursorPosition == cursor.position() && layer.cursorAnchor == cursor.anchor();
+    const bool sameScroll = layer.firstBlock == first.blockNumber() && layer.firstTop == firstTop;
+    if (sameLines && sameScroll) {
+        return;
+    }
 
-    const int currentLine = textCursor().blockNumber();
-    int selStartBlock = -1;
-    int selEndBlock = -1;
-    {
-        const QTextCursor cur = textCursor();
-        if (cur.hasSelection()) {
-            const int a = cur.anchor();
-            const int p = cur.position();
-            int s = qMin(a, p);
-            int e = qMax(a, p);
+    layer.firstBlock = first.blockNumber();
+    layer.firstTop = firstTop;
+
+    // Only scrolled: move what is already painted and fill in the lines that
+    // came into view, when the move lands on whole device pixels.
+    const qreal deviceDy = dy * dpr;
+    if (sameLines && dy != 0 && qAbs(dy) < size.height() && qFuzzyCompare(deviceDy, qreal(qRound(deviceDy)))) {
+        layer.pixmap.scroll(0, qRound(deviceDy), layer.pixmap.rect());
+        paintLineNumbers(dy > 0 ? QRect(0, 0, size.width(), dy) : QRect(0, size.height() + dy, size.width(), -dy));
+        return;
+    }
+
+    if (layer.size != size || !qFuzzyCompare(layer.dpr, dpr) || layer.pixmap.isNull()) {
+        layer.pixmap = QPixmap(size * dpr);
+        layer.pixmap.setDevicePixelRatio(dpr);
+        layer.size = size;
+        layer.dpr = dpr;
+    }
+    if (layer.revision != revision || layer.cursorPosition != cursor.position() || layer.cursorAnchor != cursor.anchor()) {
+        layer.revision = revision;
+        layer.cursorPosition = cursor.position();
+        layer.cursorAnchor = cursor.anchor();
+        layer.currentLine = cursor.blockNumber();
+        layer.selectionStart = -1;
+        layer.selectionEnd = -1;
+        if (cursor.hasSelection()) {
+            const int s = cursor.selectionStart();
+            int e = cursor.selectionEnd();
 
             // If selection ends exactly at the start of a block, don't include that next block.
             if (e > 0) {
@@ -972,49 +1400,87 @@ void FluentCodeEditor::lineNumberAreaPaintEvent(QPaintEvent *event)
                 }
             }
 
-            selStartBlock = document()->findBlock(s).blockNumber();
-            selEndBlock = document()->findBlock(e).blockNumber();
-            if (selStartBlock > selEndBlock) {
-                qSwap(selStartBlock, selEndBlock);
-            }
+            layer.selectionStart = document()->findBlock(s).blockNumber();
+            layer.selectionEnd = document()->findBlock(e).blockNumber();
         }
     }
-    const QFont baseFont = painter.font();
+    layer.blockCount = blockCount();
+    layer.viewportWidth = viewportWidth;
+    layer.documentSize = documentSize;
+    layer.valid = true;
+    paintLineNumbers(QRect(QPoint(0, 0), size));
+}
+
+void FluentCodeEditor::paintLineNumbers(const QRect &rect)
+{
+    FluentCodeEditorLineNumberArea *area = m_lineNumberArea;
+    const FluentCodeEditorLineNumberArea::Layer &layer = area->layer;
+    const auto &tokens = ThemeManager::instance().tokens();
+    const auto &colors = tokens.legacyColors;
+
+    QPainter painter(&area->layer.pixmap);
+    painter.setClipRect(rect);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.fillRect(rect, Qt::transparent);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+    const QColor selectionBg = codeEditorSelectionFill(tokens, tokens.dark ? 0.28 : 0.18);
+    const QColor currentLineBg = codeEditorLineFill(tokens, tokens.dark ? 0.24 : 0.18);
+
+    const QFont baseFont = area->font();
+    QFont currentFont = baseFont;
+    currentFont.setWeight(QFont::DemiBold);
+    const int lineHeight = fontMetrics().height();
     const int leftPad = 8;
-    const int rightPad = 6;
 
-    while (block.isValid() && top <= event->rect().bottom()) {
-        if (block.isVisible() && bottom >= event->rect().top()) {
-            const QRect lineRect(0, top, m_lineNumberArea->width(), bottom - top);
+    // Numbers are laid out once and kept; a long scroll through a huge file
+    // just starts the cache over.
+    auto numberText = [&](int number, bool current) -> const QStaticText & {
+        QHash<int, QStaticText> &cache = current ? area->currentNumbers : area->numbers;
+        auto it = cache.find(number);
+        if (it == cache.end()) {
+            if (cache.size() >= 1024) {
+                cache.clear();
+            }
+            QStaticText text(QString::number(number));
+            text.setTextFormat(Qt::PlainText);
+            text.setPerformanceHint(QStaticText::AggressiveCaching);
+            text.prepare(QTransform(), current ? currentFont : baseFont);
+            it = cache.insert(number, text);
+        }
+        return it.value();
+    };
+
+    QTextBlock block = firstVisibleBlock();
+    int blockNumber = block.blockNumber();
+    int top = layer.firstTop;
+    int bottom = top + qRound(blockBoundingRect(block).height());
 
-            const bool inSelection = (selStartBlock >= 0 && blockNumber >= selStartBlock && blockNumber <= selEndBlock);
+    while (block.isValid() && top <= rect.bottom()) {
+        if (block.isVisible() && bottom >= rect.top()) {
+            const QRect lineRect(0, top, area->width(), bottom - top);
+
+            const bool current = blockNumber == layer.currentLine;
+            const bool inSelection = (layer.selectionStart >= 0 && blockNumber >= layer.selectionStart
+                                      && blockNumber <= layer.selectionEnd);
             if (inSelection) {
                 painter.fillRect(lineRect, selectionBg);
-            } else if (blockNumber == currentLine) {
+            } else if (current) {
                 painter.fillRect(lineRect, currentLineBg);
             }
 
-            const QString number = QString::number(blockNumber + 1);
-
-            if (blockNumber == currentLine) {
+            if (current) {
                 painter.setPen(tokens.accent.base);
-                QFont f = baseFont;
-                f.setWeight(QFont::DemiBold);
-                painter.setFont(f);
             } else if (inSelection) {
                 painter.setPen(colors.text);
-                painter.setFont(baseFont);
             } else {
                 painter.setPen(colors.subText);
-                painter.setFont(baseFont);
             }
+            painter.setFont(current ? currentFont : baseFont);
 
-            painter.drawText(leftPad,
-                             top,
-                             qMax(0, m_lineNumberArea->width() - leftPad - rightPad),
-                             fontMetrics().height(),
-                             Qt::AlignLeft | Qt::AlignVCenter,
-                             number);
+            const QStaticText &number = numberText(blockNumber + 1, current);
+            const qreal y = top + (lineHeight - number.size().height()) / 2.0;
+            painter.drawStaticText(QPointF(leftPad, y), number);
         }
 
         block = block.next();
@@ -1022,54 +1488,6 @@ void FluentCodeEditor::lineNumberAreaPaintEvent(QPaintEvent *event)
         bottom = top + qRound(blockBoundingRect(block).height());
         ++blockNumber;
     }
-
-    painter.restore();
-
-    // subtle divider line
-    painter.setPen(tokens.neutral.strokeSubtle);
-    painter.drawLine(m_lineNumberArea->width() - 1, event->rect().top(), m_lineNumberArea->width() - 1, event->rect().bottom());
-}
-
-int FluentCodeEditor::findMatchingBracket(int position, QChar bracket) const
-{
-    if (position < 0 || position >= document()->characterCount()) {
-        return -1;
-    }
-    const QChar open = isOpenBracket(bracket) ? bracket : matchingBracket(bracket);
-    const QChar close = isCloseBracket(bracket) ? bracket : matchingBracket(bracket);
-
-    const bool forward = isOpenBracket(bracket);
-    int depth = 0;
-
-    const int docLen = document()->characterCount();
-    int i = position;
-
-    if (forward) {
-        for (i = position + 1; i < docLen; ++i) {
-            const QChar c = document()->characterAt(i);
-            if (c == open) {
-                ++depth;
-            } else if (c == close) {
-                if (depth == 0) {
-                    return i;
-                }
-                --depth;
-            }
-        }
-    } else {
-        for (i = position - 1; i >= 0; --i) {
-            const QChar c = document()->characterAt(i);
-            if (c == close) {
-                ++depth;
-            } else if (c == open) {
-                if (depth == 0) {
-                    return i;
-                }
-                --depth;
-            }
-        }
-    }
-    return -1;
 }
 
 void FluentCodeEditor::updateExtraSelections()
@@ -1087,28 +1505,23 @@ void FluentCodeEditor::updateExtraSelections()
     }
 
     if (m_bracketMatchHighlightEnabled) {
-        const QTextCursor cur = textCursor();
-        const int pos = cur.position();
+        // The index skips brackets inside literals and comments, so a bracket
+        // character it does not know is not one to match.
+        const int pos = textCursor().position();
         int bracketPos = -1;
-        QChar bracket;
-
-        if (pos > 0) {
-            const QChar prev = document()->characterAt(pos - 1);
-            if (isOpenBracket(prev) || isCloseBracket(prev)) {
-                bracketPos = pos - 1;
-                bracket = prev;
+        int matchPos = BracketIndex::NoBracket;
+        for (const int candidate : {pos - 1, pos}) {
+            if (candidate < 0) {
+                continue;
             }
-        }
-        if (bracketPos < 0) {
-            const QChar at = document()->characterAt(pos);
-            if (isOpenBracket(at) || isCloseBracket(at)) {
-                bracketPos = pos;
-                bracket = at;
+            matchPos = m_bracketIndex->match(candidate);
+            if (matchPos != BracketIndex::NoBracket) {
+                bracketPos = candidate;
+                break;
             }
         }
 
         if (bracketPos >= 0) {
-            const int matchPos = findMatchingBracket(bracketPos, bracket);
             auto addMark = [&](int p, const QColor &c) {
                 if (p < 0) {
                     return;
@@ -1136,7 +1549,7 @@ void FluentCodeEditor::updateExtraSelections()
     setExtraSelections(selections);
 }
 
-QString FluentCodeEditor::runBasicFormatter(const QString &input) const
+QString FluentCodeEditor::runBasicFormatter(const QString &input, const QAtomicInt *cancel)
 {
     // Minimal, fast formatting for when clang-format is not available.
     // - normalize indentation based on brace depth
@@ -1211,15 +1624,21 @@ QString FluentCodeEditor::runBasicFormatter(const QString &input) const
     };
 
     for (int idx = 0; idx < lines.size(); ++idx) {
-        QString line = lines[idx];
+        if (cancel && (idx & 0xff) == 0 && cancel->loadAcquire()) {
+            return QString();
+        }
+        const QString &line = lines[idx];
 
         int openCount = 0;
         int closeCount = 0;
         countBraces(line, openCount, closeCount);
 
         // If line starts with '}', reduce indentation for this line first.
-        QString trimmed = line;
-        trimmed.remove(QRegularExpression(QStringLiteral(R"(^\s+)")));
+        int leading = 0;
+        while (leading < line.size() && line.at(leading).isSpace()) {
+            ++leading;
+        }
+        const QString trimmed = line.mid(leading);
 
         int lineIndent = indentLevel;
         if (trimmed.startsWith(QLatin1Char('}'))) {
@@ -1242,7 +1661,56 @@ QString FluentCodeEditor::runBasicFormatter(const QString &input) const
     return out;
 }
 
-void FluentCodeEditor::runClangFormatAsync()
+void FluentCodeEditor::trackDirtyLines(int position, int charsAdded)
+{
+    QTextDocument *doc = document();
+    const int blocks = doc->blockCount();
+    const int delta = blocks - m_trackedBlockCount;
+    m_trackedBlockCount = blocks;
+    if (m_internalChange) {
+        return;
+    }
+    if (m_formatJobCancel) {
+        m_formatJobCancel->storeRelease(1);
+    }
+
+    const int lastPosition = qMax(0, doc->characterCount() - 1);
+    const QTextBlock firstBlock = doc->findBlock(qMin(position, lastPosition));
+    const QTextBlock lastBlock = doc->findBlock(qMin(position + charsAdded, lastPosition));
+    const int first = firstBlock.isValid() ? firstBlock.blockNumber() : blocks - 1;
+    const int last = qMax(first, lastBlock.isValid() ? lastBlock.blockNumber() : blocks - 1);
+    // Old lines first..removedEnd are now first..last; later lines moved by delta.
+    const int removedEnd = last - delta;
+
+    QVector<QPair<int, int>> ranges;
+    ranges.reserve(m_dirtyLines.size() + 1);
+    for (const QPair<int, int> &range : std::as_const(m_dirtyLines)) {
+        if (range.second < first) {
+            ranges.append(range);
+        } else if (range.first > removedEnd) {
+            ranges.append(qMakePair(range.first + delta, range.second + delta));
+        } else {
+            ranges.append(qMakePair(qMin(range.first, first), qMax(last, range.second + delta)));
+        }
+    }
+    ranges.append(qMakePair(first, last));
+    std::sort(ranges.begin(), ranges.end());
+
+    m_dirtyLines.clear();
+    for (const QPair<int, int> &range : std::as_const(ranges)) {
+        if (!m_dirtyLines.isEmpty() && range.first <= m_dirtyLines.last().second + 1) {
+            m_dirtyLines.last().second = qMax(m_dirtyLines.last().second, range.second);
+        } else {
+            m_dirtyLines.append(range);
+        }
+    }
+    if (m_dirtyLines.size() > 32) {
+        // Scattered edits all over a file: format them as one span.
+        m_dirtyLines = {qMakePair(m_dirtyLines.first().first, m_dirtyLines.last().second)};
+    }
+}
+
+void FluentCodeEditor::runClangFormatAsync(bool changedLinesOnly)
 {
     if (m_clangFormatPath.isEmpty()) {
         return;
@@ -1256,61 +1724,126 @@ void FluentCodeEditor::runClangFormatAsync()
                 [this](int exitCode, QProcess::ExitStatus status) {
                     const QByteArray out = m_clangProc->readAllStandardOutput();
                     const bool ok = (status == QProcess::NormalExit && exitCode == 0);
-                    bool applied = false;
+                    if (ok) {
+                        formatResultCache().insert(m_formatCacheKey, new QByteArray(out), qMax(1, int(out.size())));
+                    }
 
                     // If user kept typing, don't apply stale output; just reschedule.
                     if (ok && document()->revision() == m_formatStartRevision) {
-                        applied = applyFormattedText(QString::fromUtf8(out));
-                    } else if (ok) {
-                        m_formatPending = true;
+                        startFormatJob(QString::fromUtf8(out), false);
+                        return;
                     }
-
-                    emit formatFinished(applied);
-
-                    if (m_formatPending) {
-                        m_formatPending = false;
-                        scheduleAutoFormat();
+                    if (ok) {
+                        m_formatPending = true;
                     }
+                    finishFormat(false);
                 });
     }
 
-    emit formatStarted();
-
     m_clangProc->setProgram(m_clangFormatPath);
 
     // Read from stdin; assume C++ for better defaults.
     QStringList args;
     args << QStringLiteral("-assume-filename=code.cpp");
-    m_clangProc->setArguments(args);
+    if (changedLinesOnly) {
+        // clang-format still reads the whole file for context but only
+        // rewrites the edited lines (1-based, inclusive).
+        const int lastLine = blockCount() - 1;
+        for (const QPair<int, int> &range : std::as_const(m_dirtyLines)) {
+            if (range.first <= lastLine) {
+                args << QStringLiteral("-lines=%1:%2").arg(range.first + 1).arg(qMin(range.second, lastLine) + 1);
+            }
+        }
+    }
 
     const QByteArray input = toPlainText().toUtf8();
+    m_formatCacheKey = formatCacheKey(m_clangFormatPath, args, input);
+    if (const QByteArray *cached = formatResultCache().object(m_formatCacheKey)) {
+        startFormatJob(QString::fromUtf8(*cached), false);
+        return;
+    }
+
+    m_clangProc->setArguments(args);
     m_clangProc->start();
     m_clangProc->write(input);
     m_clangProc->closeWriteChannel();
 }
 
-bool FluentCodeEditor::applyFormattedText(const QString &formatted)
-{
-    const QString current = toPlainText();
-    if (formatted == current) {
-        // still restore (in case selection drifted)
-        restoreCursor(this, m_cursorBlock, m_cursorColumn, m_anchorBlock, m_anchorColumn, m_hadSelection);
-        return false;
-    }
+void FluentCodeEditor::startFormatJob(const QString &formatted, bool basicFormatter)
+{
+    QStringList current;
+    current.reserve(blockCount());
+    for (QTextBlock block = document()->begin(); block.isValid(); block = block.next()) {
+        current.append(block.text());
+    }
+
+    // Format (basic formatter) and diff a snapshot on the thread pool, then
+    // edit only the blocks inside the hunks so a large file costs relayout,
+    // rehighlighting and undo memory in proportion to what changed. A user
+    // edit meanwhile cancels the job and its result is dropped as stale.
+    m_formatJobRunning = true;
+    const quint64 token = ++m_formatJobToken;
+    m_formatJobCancel.reset(new QAtomicInt(0));
+    const QSharedPointer<QAtomicInt> cancel = m_formatJobCancel;
+    const QPointer<FluentCodeEditor> guard(this);
+    QThreadPool::globalInstance()->start(new FormatJobTask([guard, token, cancel, current, formatted, basicFormatter]() {
+        QStringList lines;
+        QVector<TextDiff::Hunk> hunks;
+        if (!cancel->loadAcquire()) {
+            const QString text = basicFormatter ? runBasicFormatter(current.join(QLatin1Char('\n')), cancel.data())
+                                                : formatted;
+            lines = text.split(QLatin1Char('\n'));
+        }
+        if (!cancel->loadAcquire() && lines != current) {
+            hunks = TextDiff::diffLines(current, lines);
+        }
+        const bool cancelled = cancel->loadAcquire() != 0;
 
-    m_internalChange = true;
+        postToGuiThread([guard, token, cancelled, current, lines, hunks]() {
+            FluentCodeEditor *self = guard.data();
+            if (!self || self->m_formatJobToken != token) {
+                return;
+            }
+            self->m_formatJobRunning = false;
+            self->m_formatJobCancel.reset();
 
-    QTextCursor c(document());
-    c.beginEditBlock();
-    c.select(QTextCursor::Document);
-    c.insertText(formatted);
-    c.endEditBlock();
+            if (cancelled || self->document()->revision() != self->m_formatStartRevision) {
+                self->m_formatPending = true;
+                self->finishFormat(false);
+                return;
+            }
 
-    m_internalChange = false;
+            if (!hunks.isEmpty()) {
+                self->m_internalChange = true;
+                QTextCursor c(self->document());
+                c.beginEditBlock();
+                applyLineHunks(c, current, lines, hunks);
+                c.endEditBlock();
+                self->m_internalChange = false;
+            }
+            self->m_dirtyLines.clear();
 
-    restoreCursor(this, m_cursorBlock, m_cursorColumn, m_anchorBlock, m_anchorColumn, m_hadSelection);
+            // Restore even when nothing changed, in case the selection drifted.
+            restoreCursor(self,
+                          self->m_cursorBlock,
+                          self->m_cursorColumn,
+                          self->m_anchorBlock,
+                          self->m_anchorColumn,
+                          self->m_hadSelection);
+            self->finishFormat(!hunks.isEmpty());
+        });
+    }));
+}
 
-    return true;
+void FluentCodeEditor::finishFormat(bool applied)
+{
+    emit formatFinished(applied, m_formatTimer.isValid() ? m_formatTimer.elapsed() : 0);
+    m_formatTimer.invalidate();
+
+    if (m_formatPending) {
+        m_formatPending = false;
+        scheduleAutoFormat();
+    }
 }
 
 void FluentCodeEditor::keyPressEvent(QKeyEvent *event)
@@ -14,6 +14,7 @@
 
 #include "colorPicker/EyeDropper.h"
 #include "colorPicker/ColorPickerWidgets.h"
+#include "FluentDiagnostics_p.h"
 
 #include <QApplication>
 #include <QButtonGroup>
@@ -614,7 +615,7 @@ FluentColorDialog::FluentColorDialog(const QColor &initial, QWidget *parent)
 
             const QString next = Theme::dialogStyle(ThemeManager::instance().colors())
                 + QStringLiteral("QDialog{background: transparent; border: none; border-radius: 0px;}");
-            if (styleSheet() != next) setStyleSheet(next);
+            ThemeProfiler::setStyleSheetIfChanged(this, next);
 
             const QString divStyle = separatorStyle();
             const auto separators = findChildren<QWidget *>(QStringLiteral("FluentColorDialogSeparator"));
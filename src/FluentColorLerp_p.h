@@ -0,0 +1,35 @@
+#pragma once
+
+#include <QColor>
+#include <QRgba64>
+#include <QtGlobal>
+
+namespace Fluent {
+namespace ColorLerp {
+
+// Fixed point position along a blend, 0..FractionOne.
+enum : quint32 { FractionOne = 1u << 15 };
+
+inline quint32 fraction(qreal t)
+{
+    return static_cast<quint32>(qRound(qBound<qreal>(0.0, t, 1.0) * FractionOne));
+}
+
+// Straight (non-premultiplied) lerp of all four 16-bit channels at once: red
+// and blue, then green and alpha, share one 64-bit multiply with a 32-bit
+// lane each. A lane tops out at 65535 * 32768 + 16384 < 2^31, so nothing
+// carries into its neighbour.
+inline QRgba64 lerp(QRgba64 a, QRgba64 b, quint32 t)
+{
+    constexpr quint64 lanes = Q_UINT64_C(0x0000ffff0000ffff);
+    constexpr quint64 half = Q_UINT64_C(0x0000400000004000);
+    const quint64 x = a;
+    const quint64 y = b;
+    const quint64 s = FractionOne - t;
+    const quint64 rb = (((x & lanes) * s + (y & lanes) * t + half) >> 15) & lanes;
+    const quint64 ga = ((((x >> 16) & lanes) * s + ((y >> 16) & lanes) * t + half) >> 15) & lanes;
+    return QRgba64::fromRgba64(rb | (ga << 16));
+}
+
+} // namespace ColorLerp
+} // namespace Fluent
@@ -1,6 +1,8 @@
 #include "Fluent/FluentColorPicker.h"
 #include "Fluent/FluentTheme.h"
 #include "Fluent/FluentColorDialog.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QHBoxLayout>
 #include <QLineEdit>
@@ -26,7 +28,7 @@ FluentColorPicker::FluentColorPicker(QWidget *parent)
     layout->addWidget(m_button);
 
     connect(m_button, &QPushButton::clicked, this, &FluentColorPicker::openDialog);
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentColorPicker::applyTheme);
+    ThemeRegistry::enroll<&FluentColorPicker::applyTheme>(this);
 
     setColor(ThemeManager::instance().tokens().accent.base);
     applyTheme();
@@ -74,18 +76,16 @@ void FluentColorPicker::openDialog()
 
 void FluentColorPicker::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const auto &colors = ThemeManager::instance().colors();
     {
         const QString next = Theme::lineEditStyle(colors);
-        if (m_preview->styleSheet() != next) {
-            m_preview->setStyleSheet(next);
-        }
+        ThemeProfiler::setStyleSheetIfChanged(m_preview, next);
     }
     {
         const QString next = Theme::buttonStyle(colors, false);
-        if (m_button->styleSheet() != next) {
-            m_button->setStyleSheet(next);
-        }
+        ThemeProfiler::setStyleSheetIfChanged(m_button, next);
     }
 }
 
@@ -100,9 +100,7 @@ void FluentColorPicker::updatePreview()
         const QString next = QString(
             "%1 QLineEdit { padding-left: 26px; } QLineEdit:disabled { padding-left: 26px; }"
         ).arg(Theme::lineEditStyle(ThemeManager::instance().colors()));
-        if (m_preview->styleSheet() != next) {
-            m_preview->setStyleSheet(next);
-        }
+        ThemeProfiler::setStyleSheetIfChanged(m_preview, next);
     }
 
     QPixmap pix(16, 16);
@@ -6,6 +6,8 @@
 #include "Fluent/FluentScrollBar.h"
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 #include "FluentInputVisuals_p.h"
 #include "FluentPaintSupport.h"
 #include "FluentPopupUtils.h"
@@ -1114,7 +1116,7 @@ FluentComboBox::FluentComboBox(QWidget *parent)
     }
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentComboBox::applyTheme);
+    ThemeRegistry::enroll<&FluentComboBox::applyTheme>(this);
 }
 QSize FluentComboBox::sizeHint() const
 {
@@ -1145,6 +1147,8 @@ void FluentComboBox::changeEvent(QEvent *event)
 
 void FluentComboBox::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const QVariant hoverEnd = m_hoverAnim ? m_hoverAnim->endValue() : QVariant();
 
@@ -1189,9 +1193,7 @@ void FluentComboBox::applyTheme()
                 .arg(colors.text.name(QColor::HexArgb),
                      tokens.neutral.stroke.name(QColor::HexArgb));
 
-        if (view()->styleSheet() != viewNext) {
-            view()->setStyleSheet(viewNext);
-        }
+        ThemeProfiler::setStyleSheetIfChanged(view(), viewNext);
 
         if (m_popup) {
             m_popup->syncFromCombo();
@@ -5,6 +5,8 @@
 #include <QRegularExpression>
 #include <QTextDocument>
 
+#include <algorithm>
+
 namespace Fluent {
 
 static QStringList cppKeywords()
@@ -184,12 +186,52 @@ void FluentCppHighlighter::rebuildRulesIfNeeded()
 }
 
 void FluentCppHighlighter::highlightBlock(const QString &text)
+{
+    const auto apply = [this](int start, int count, const QTextCharFormat &format) { setFormat(start, count, format); };
+    setCurrentBlockState(highlightLine(text, previousBlockState(), apply));
+}
+
+int FluentCppHighlighter::formatLine(const QString &text, int previousState, QVector<QTextLayout::FormatRange> *ranges)
+{
+    // Overlapping formats replace each other per character, as with
+    // QSyntaxHighlighter::setFormat().
+    const int size = static_cast<int>(text.size());
+    QVector<QTextCharFormat> formats(size);
+    const auto apply = [&formats, size](int start, int count, const QTextCharFormat &format) {
+        if (start >= 0 && start < size) {
+            std::fill(formats.begin() + start, formats.begin() + qMin(start + count, size), format);
+        }
+    };
+    const int state = highlightLine(text, previousState, apply);
+
+    ranges->clear();
+    const QTextCharFormat empty;
+    for (int i = 0; i < size;) {
+        if (formats.at(i) == empty) {
+            ++i;
+            continue;
+        }
+        QTextLayout::FormatRange range;
+        range.start = i;
+        range.format = formats.at(i);
+        while (i < size && formats.at(i) == range.format) {
+            ++i;
+        }
+        range.length = i - range.start;
+        ranges->append(range);
+    }
+    return state;
+}
+
+int FluentCppHighlighter::highlightLine(const QString &text,
+                                        int previousState,
+                                        const std::function<void(int, int, const QTextCharFormat &)> &setFormat)
 {
     rebuildRulesIfNeeded();
 
     // Handle multi-line comments with block state
     // state 1: inside /* */ comment
-    int state = previousBlockState();
+    int state = previousState;
     int start = 0;
 
     auto applyInlineComment = [&](int from) {
@@ -203,8 +245,7 @@ void FluentCppHighlighter::highlightBlock(const QString &text)
         int end = text.indexOf(QStringLiteral("*/"));
         if (end < 0) {
             setFormat(0, text.size(), m_commentFmt);
-            setCurrentBlockState(1);
-            return;
+            return 1;
         }
         setFormat(0, end + 2, m_commentFmt);
         start = end + 2;
@@ -259,14 +300,13 @@ void FluentCppHighlighter::highlightBlock(const QString &text)
         int close = text.indexOf(QStringLiteral("*/"), open + 2);
         if (close < 0) {
             setFormat(open, text.size() - open, m_commentFmt);
-            setCurrentBlockState(1);
-            return;
+            return 1;
         }
         setFormat(open, close + 2 - open, m_commentFmt);
         i = close + 2;
     }
 
-    setCurrentBlockState(0);
+    return 0;
 }
 
 } // namespace Fluent
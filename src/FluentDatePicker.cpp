@@ -3,6 +3,8 @@
 #include "Fluent/FluentMotion.h"
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 #include "FluentInputVisuals_p.h"
 #include "datePicker/FluentWheelPickerSupport.h"
 
@@ -88,7 +90,7 @@ FluentDatePicker::FluentDatePicker(QWidget *parent)
     });
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentDatePicker::applyTheme);
+    ThemeRegistry::enroll<&FluentDatePicker::applyTheme>(this);
 }
 
 FluentDatePicker::~FluentDatePicker() = default;
@@ -500,6 +502,8 @@ QSize FluentDatePicker::sizeHint() const
 
 void FluentDatePicker::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool focusRunning = m_focusAnim && m_focusAnim->state() == QAbstractAnimation::Running;
     const QVariant hoverEnd = m_hoverAnim ? m_hoverAnim->endValue() : QVariant();
@@ -3,6 +3,7 @@
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
 #include "Fluent/datePicker/FluentCalendarPopup.h"
+#include "FluentDiagnostics_p.h"
 #include "FluentInputVisuals_p.h"
 
 #include <QAbstractAnimation>
@@ -149,6 +150,8 @@ QString FluentDateRangePicker::buildSideText(const QDate  &date,
 
 void FluentDateRangePicker::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool focusRunning = m_focusAnim && m_focusAnim->state() == QAbstractAnimation::Running;
     const QVariant hoverEnd = m_hoverAnim ? m_hoverAnim->endValue() : QVariant();
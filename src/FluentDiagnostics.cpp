@@ -1,15 +1,35 @@
 #include "Fluent/FluentDiagnostics.h"
+#include "FluentDiagnostics_p.h"
 
 #include <QtGlobal>
 
+#include <algorithm>
 #include <atomic>
 #include <cstdio>
+#include <utility>
 
 #include <QByteArray>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
 #include <QMessageLogContext>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QPointer>
+#include <QRegion>
+#include <QSet>
 #include <QString>
+#include <QTimer>
+#include <QWidget>
+#include <QWindow>
 
 namespace {
 
@@ -44,6 +64,11 @@ static bool shouldAutoInstall()
     return envSuppressKnownWarnings() || !envQtWarningOutputEnabled();
 }
 
+static bool envThemeSwitchProfilingEnabled()
+{
+    return isTruthyEnv(qgetenv("QTFLUENT_THEME_SWITCH_PROFILE"), false);
+}
+
 static bool isKnownNoisyWarning(const QString &msg)
 {
     return msg.contains(QStringLiteral("QWidget::paintEngine: Should no longer be called"))
@@ -94,8 +119,436 @@ struct FluentDiagnosticsInstaller {
 
 static const FluentDiagnosticsInstaller g_installer;
 
+// --- Theme-switch profiler ---------------------------------------------------
+// Receivers run on the GUI thread; the mutex only guards report reads from
+// other threads.
+
+static std::atomic_bool g_themeProfilingEnabled {envThemeSwitchProfilingEnabled()};
+
+struct ThemeProfileFrame {
+    QElapsedTimer timer;
+    qint64 childNs = 0; // time spent in nested receivers
+    int receiver = -1;  // index into ThemeSwitchReport::receivers
+};
+
+struct ThemeProfileState {
+    QMutex mutex;
+    Fluent::ThemeSwitchReport report;
+    QHash<QString, int> receiverIndex;
+    QVector<ThemeProfileFrame> stack;
+    qint64 attributedNs = 0;
+    bool dispatching = false;
+};
+
+static ThemeProfileState &themeProfileState()
+{
+    static ThemeProfileState state;
+    return state;
+}
+
+class ThemeStyleChangeCounter final : public QObject
+{
+public:
+    using QObject::QObject;
+
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (event->type() == QEvent::StyleChange) {
+            ThemeProfileState &state = themeProfileState();
+            if (state.dispatching) {
+                QMutexLocker locker(&state.mutex);
+                ++state.report.styleRecomputeCount;
+            }
+        }
+        return QObject::eventFilter(watched, event);
+    }
+};
+
+static QPointer<ThemeStyleChangeCounter> g_styleChangeCounter;
+
+static void syncStyleChangeCounter()
+{
+    QCoreApplication *app = QCoreApplication::instance();
+    const bool wanted = g_themeProfilingEnabled.load(std::memory_order_acquire) && app;
+    if (wanted && !g_styleChangeCounter) {
+        g_styleChangeCounter = new ThemeStyleChangeCounter(app);
+        app->installEventFilter(g_styleChangeCounter);
+    } else if (!wanted && g_styleChangeCounter) {
+        if (app) {
+            app->removeEventFilter(g_styleChangeCounter);
+        }
+        delete g_styleChangeCounter;
+    }
+}
+
+static double nsToMs(qint64 ns)
+{
+    return static_cast<double>(ns) / 1000000.0;
+}
+
+// --- Paint profiler ----------------------------------------------------------
+// Same threading model as the theme profiler: paints arrive on the GUI thread,
+// the mutex only guards report reads.
+
+static std::atomic_bool g_paintProfilingEnabled {isTruthyEnv(qgetenv("QTFLUENT_PAINT_PROFILE"), false)};
+static std::atomic_bool g_repaintFlashEnabled {isTruthyEnv(qgetenv("QTFLUENT_PAINT_FLASH"), false)};
+
+constexpr int kRepaintFlashMs = 160;
+
+struct PaintWidgetEntry {
+    const QMetaObject *meta = nullptr;
+    Fluent::PaintCost cost;
+};
+
+struct PaintProfileState {
+    QMutex mutex;
+    QHash<const QObject *, int> widgetIndex;
+    QVector<PaintWidgetEntry> widgets;
+    QHash<const QMetaObject *, int> classIndex;
+    QVector<Fluent::PaintCost> classes;
+    int paintCount = 0;
+    qint64 totalNs = 0;
+    qint64 area = 0;
+    QElapsedTimer window;
+};
+
+static PaintProfileState &paintProfileState()
+{
+    static PaintProfileState state;
+    return state;
+}
+
+static qint64 regionArea(const QRegion &region)
+{
+    qint64 area = 0;
+    for (const QRect &rect : region) {
+        area += qint64(rect.width()) * rect.height();
+    }
+    return area;
+}
+
+static void addPaintCost(Fluent::PaintCost &cost, qint64 ns, qint64 area)
+{
+    ++cost.count;
+    cost.totalNs += ns;
+    cost.maxNs = qMax(cost.maxNs, ns);
+    cost.area += area;
+}
+
+static void recordPaint(const QWidget *widget, qint64 ns, qint64 area)
+{
+    PaintProfileState &state = paintProfileState();
+    const QMetaObject *meta = widget->metaObject();
+
+    QMutexLocker locker(&state.mutex);
+    ++state.paintCount;
+    state.totalNs += ns;
+    state.area += area;
+
+    // A destroyed widget's address can be reused by a new one; a class change
+    // starts a fresh row instead of merging two unrelated instances.
+    int index = state.widgetIndex.value(widget, -1);
+    if (index < 0 || state.widgets.at(index).meta != meta) {
+        PaintWidgetEntry entry;
+        entry.meta = meta;
+        entry.cost.className = QString::fromLatin1(meta->className());
+        entry.cost.objectName = widget->objectName();
+        entry.cost.widget = reinterpret_cast<quintptr>(widget);
+        index = state.widgets.size();
+        state.widgets.push_back(entry);
+        state.widgetIndex.insert(widget, index);
+    }
+    addPaintCost(state.widgets[index].cost, ns, area);
+
+    int classIndex = state.classIndex.value(meta, -1);
+    if (classIndex < 0) {
+        Fluent::PaintCost cost;
+        cost.className = QString::fromLatin1(meta->className());
+        classIndex = state.classes.size();
+        state.classes.push_back(cost);
+        state.classIndex.insert(meta, classIndex);
+    }
+    addPaintCost(state.classes[classIndex], ns, area);
+}
+
+// Times a Paint event by delivering it itself: the first pass through the
+// filter re-sends the event and swallows the original, the nested pass lets
+// it through to the widget. Filters installed after this one therefore see
+// each Paint twice while profiling; paint handlers in the library do not
+// depend on that.
+class PaintProbe final : public QObject
+{
+public:
+    using QObject::QObject;
+
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (event->type() != QEvent::Paint || event == m_inFlight || !watched->isWidgetType()) {
+            return QObject::eventFilter(watched, event);
+        }
+
+        auto *widget = static_cast<QWidget *>(watched);
+        const QRegion region = static_cast<QPaintEvent *>(event)->region();
+        // With only the flash on, the paint is delivered here just so the
+        // tint lands on top of it; nothing is recorded.
+        const bool profiling = g_paintProfilingEnabled.load(std::memory_order_relaxed);
+        QEvent *outer = m_inFlight;
+        m_inFlight = event;
+        QElapsedTimer timer;
+        timer.start();
+        QCoreApplication::sendEvent(watched, event);
+        const qint64 elapsed = timer.nsecsElapsed();
+        m_inFlight = outer;
+
+        if (profiling) {
+            recordPaint(widget, elapsed, regionArea(region));
+        }
+        if (g_repaintFlashEnabled.load(std::memory_order_relaxed)) {
+            flash(widget, region);
+        }
+        return true;
+    }
+
+private:
+    struct PendingClear {
+        QPointer<QWidget> widget;
+        QRegion region;
+    };
+
+    void flash(QWidget *widget, const QRegion &region)
+    {
+        // The repaint that removes a flash must not flash again.
+        if (m_clearing.remove(widget)) {
+            return;
+        }
+        const QWidget *window = widget->window();
+        if (!window || !window->isVisible() || window->testAttribute(Qt::WA_DontShowOnScreen) ||
+            widget->testAttribute(Qt::WA_PaintOnScreen) || !widget->testAttribute(Qt::WA_WState_InPaintEvent) ||
+            widget->paintingActive()) {
+            return;
+        }
+        // grab() and render() redirect the widget into their own device; the
+        // tint belongs on screen only, never in a snapshot.
+        if (QPainter::redirected(widget)) {
+            return;
+        }
+
+        {
+            QPainter painter(widget);
+            if (!painter.isActive() || painter.device() != widget) {
+                return;
+            }
+            painter.setClipRegion(region);
+            painter.fillRect(region.boundingRect(), QColor(255, 0, 170, 64));
+            painter.setPen(QColor(255, 0, 170, 200));
+            painter.setBrush(Qt::NoBrush);
+            for (const QRect &rect : region) {
+                painter.drawRect(rect.adjusted(0, 0, -1, -1));
+            }
+        }
+
+        m_pending.push_back({widget, region});
+        if (!m_clearTimer) {
+            m_clearTimer = new QTimer(this);
+            m_clearTimer->setSingleShot(true);
+            m_clearTimer->setInterval(kRepaintFlashMs);
+            QObject::connect(m_clearTimer, &QTimer::timeout, this, [this]() {
+                clearFlashes();
+            });
+        }
+        if (!m_clearTimer->isActive()) {
+            m_clearTimer->start();
+        }
+    }
+
+    void clearFlashes()
+    {
+        const QVector<PendingClear> pending = m_pending;
+        m_pending.clear();
+        for (const PendingClear &entry : pending) {
+            if (!entry.widget) {
+                continue;
+            }
+            m_clearing.insert(entry.widget);
+            entry.widget->update(entry.region);
+        }
+    }
+
+    QEvent *m_inFlight = nullptr;
+    QVector<PendingClear> m_pending;
+    QSet<const QWidget *> m_clearing;
+    QTimer *m_clearTimer = nullptr;
+};
+
+static QPointer<PaintProbe> g_paintProbe;
+
+static void syncPaintProbe()
+{
+    QCoreApplication *app = QCoreApplication::instance();
+    const bool wanted = app && (g_paintProfilingEnabled.load(std::memory_order_acquire) ||
+                                g_repaintFlashEnabled.load(std::memory_order_acquire));
+    if (wanted && !g_paintProbe) {
+        g_paintProbe = new PaintProbe(app);
+        app->installEventFilter(g_paintProbe);
+        PaintProfileState &state = paintProfileState();
+        QMutexLocker locker(&state.mutex);
+        if (!state.window.isValid()) {
+            state.window.start();
+        }
+    } else if (!wanted && g_paintProbe) {
+        if (app) {
+            app->removeEventFilter(g_paintProbe);
+        }
+        delete g_paintProbe;
+    }
+}
+
+// QTFLUENT_PAINT_PROFILE / QTFLUENT_PAINT_FLASH need an application object
+// for the filter.
+static void installPaintProbeFromEnvironment()
+{
+    syncPaintProbe();
+}
+
+// --- Startup trace -----------------------------------------------------------
+// Phases are recorded on the GUI thread; the mutex only guards trace reads.
+// The clock starts during static initialization of the library, so phase
+// times include everything between process start and main() except the
+// dynamic loader itself.
+
+static const QElapsedTimer g_startupClock = []() {
+    QElapsedTimer timer;
+    timer.start();
+    return timer;
+}();
+
+struct StartupTraceState {
+    QMutex mutex;
+    Fluent::StartupTrace trace;
+    bool shown = false;
+    bool exposed = false;
+    bool painted = false;
+};
+
+static StartupTraceState &startupTraceState()
+{
+    static StartupTraceState state;
+    return state;
+}
+
+static void recordStartupPhase(const QString &name)
+{
+    StartupTraceState &state = startupTraceState();
+    QMutexLocker locker(&state.mutex);
+    if (state.trace.complete) {
+        return;
+    }
+    Fluent::StartupPhase phase;
+    phase.name = name;
+    phase.elapsedNs = g_startupClock.nsecsElapsed();
+    state.trace.phases.push_back(phase);
+}
+
+static void logStartupTrace(const Fluent::StartupTrace &trace)
+{
+    if (!Fluent::Diagnostics::startupLog().isInfoEnabled()) {
+        return;
+    }
+    qint64 previousNs = 0;
+    for (const Fluent::StartupPhase &phase : trace.phases) {
+        qCInfo(Fluent::Diagnostics::startupLog).noquote() << QStringLiteral("[Startup] %1 at %2 ms (+%3 ms)")
+                                                                 .arg(phase.name)
+                                                                 .arg(nsToMs(phase.elapsedNs), 0, 'f', 1)
+                                                                 .arg(nsToMs(phase.elapsedNs - previousNs), 0, 'f', 1);
+        previousNs = phase.elapsedNs;
+    }
+}
+
+// Watches for the first shown window, its first Expose and first Paint, then
+// closes the trace on the next event loop pass: the paint is delivered from
+// inside the synchronous backing store sync, so by then the frame has been
+// flushed. The filter removes itself once the trace is complete.
+class StartupProbe final : public QObject
+{
+public:
+    using QObject::QObject;
+
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        StartupTraceState &state = startupTraceState();
+        switch (event->type()) {
+        case QEvent::Show:
+            if (!state.shown && watched->isWidgetType() && static_cast<QWidget *>(watched)->isWindow()) {
+                state.shown = true;
+                recordStartupPhase(QStringLiteral("first window shown"));
+            }
+            break;
+        case QEvent::Expose:
+            if (!state.exposed && watched->isWindowType() && static_cast<QWindow *>(watched)->isExposed()) {
+                state.exposed = true;
+                recordStartupPhase(QStringLiteral("first window exposed"));
+            }
+            break;
+        case QEvent::Paint:
+            if (state.exposed && !state.painted && watched->isWidgetType()) {
+                state.painted = true;
+                recordStartupPhase(QStringLiteral("first paint"));
+                QTimer::singleShot(0, this, [this]() { finish(); });
+            }
+            break;
+        default:
+            break;
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+private:
+    void finish()
+    {
+        recordStartupPhase(QStringLiteral("first frame"));
+        StartupTraceState &state = startupTraceState();
+        Fluent::StartupTrace trace;
+        {
+            QMutexLocker locker(&state.mutex);
+            state.trace.complete = true;
+            state.trace.firstFrameNs = state.trace.phases.isEmpty() ? 0 : state.trace.phases.last().elapsedNs;
+            trace = state.trace;
+        }
+        logStartupTrace(trace);
+        const QString path = qEnvironmentVariable("QTFLUENT_STARTUP_TRACE_FILE");
+        if (!path.isEmpty()) {
+            Fluent::Diagnostics::writeStartupTrace(path);
+        }
+        if (QCoreApplication *app = QCoreApplication::instance()) {
+            app->removeEventFilter(this);
+        }
+        deleteLater();
+    }
+};
+
+static QPointer<StartupProbe> g_startupProbe;
+
+static void armStartupProbe()
+{
+    QCoreApplication *app = QCoreApplication::instance();
+    if (!app || g_startupProbe) {
+        return;
+    }
+    g_startupProbe = new StartupProbe(app);
+    app->installEventFilter(g_startupProbe);
+}
+
+static void beginStartupTrace()
+{
+    recordStartupPhase(QStringLiteral("QCoreApplication constructed"));
+    armStartupProbe();
+}
+
 } // namespace
 
+Q_COREAPP_STARTUP_FUNCTION(installPaintProbeFromEnvironment)
+Q_COREAPP_STARTUP_FUNCTION(beginStartupTrace)
+
 namespace Fluent {
 
 void Diagnostics::installMessageHandler()
@@ -136,4 +589,383 @@ bool Diagnostics::qtWarningOutputEnabled()
     return g_qtWarningOutputEnabled.load(std::memory_order_acquire);
 }
 
+void Diagnostics::setThemeSwitchProfilingEnabled(bool enabled)
+{
+    g_themeProfilingEnabled.store(enabled, std::memory_order_release);
+    syncStyleChangeCounter();
+}
+
+bool Diagnostics::themeSwitchProfilingEnabled()
+{
+    return g_themeProfilingEnabled.load(std::memory_order_acquire);
+}
+
+ThemeSwitchReport Diagnostics::themeSwitchReport()
+{
+    ThemeProfileState &state = themeProfileState();
+    QMutexLocker locker(&state.mutex);
+    ThemeSwitchReport report = state.report;
+    std::stable_sort(report.receivers.begin(), report.receivers.end(),
+                     [](const ThemeReceiverCost &a, const ThemeReceiverCost &b) {
+                         return a.totalNs > b.totalNs;
+                     });
+    return report;
+}
+
+void Diagnostics::resetThemeSwitchReport()
+{
+    ThemeProfileState &state = themeProfileState();
+    QMutexLocker locker(&state.mutex);
+    state.report = ThemeSwitchReport();
+    state.receiverIndex.clear();
+}
+
+QByteArray Diagnostics::themeSwitchReportJson()
+{
+    const ThemeSwitchReport report = themeSwitchReport();
+
+    QJsonArray receivers;
+    for (const auto &receiver : report.receivers) {
+        QJsonObject entry;
+        entry.insert(QStringLiteral("className"), receiver.className);
+        entry.insert(QStringLiteral("objectName"), receiver.objectName);
+        entry.insert(QStringLiteral("count"), receiver.count);
+        entry.insert(QStringLiteral("totalMs"), nsToMs(receiver.totalNs));
+        entry.insert(QStringLiteral("maxMs"), nsToMs(receiver.maxNs));
+        receivers.append(entry);
+    }
+
+    QJsonObject root;
+    root.insert(QStringLiteral("dispatchCount"), report.dispatchCount);
+    root.insert(QStringLiteral("dispatchMs"), nsToMs(report.dispatchNs));
+    root.insert(QStringLiteral("lastDispatchMs"), nsToMs(report.lastDispatchNs));
+    root.insert(QStringLiteral("unattributedMs"), nsToMs(report.unattributedNs));
+    root.insert(QStringLiteral("styleSheetCount"), report.styleSheetCount);
+    root.insert(QStringLiteral("styleSheetMs"), nsToMs(report.styleSheetNs));
+    root.insert(QStringLiteral("styleRecomputeCount"), report.styleRecomputeCount);
+    root.insert(QStringLiteral("receivers"), receivers);
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+bool Diagnostics::writeThemeSwitchReport(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    const QByteArray json = themeSwitchReportJson();
+    return file.write(json) == json.size();
+}
+
+void Diagnostics::setPaintProfilingEnabled(bool enabled)
+{
+    g_paintProfilingEnabled.store(enabled, std::memory_order_release);
+    syncPaintProbe();
+}
+
+bool Diagnostics::paintProfilingEnabled()
+{
+    return g_paintProfilingEnabled.load(std::memory_order_acquire);
+}
+
+PaintReport Diagnostics::paintReport()
+{
+    PaintProfileState &state = paintProfileState();
+    QMutexLocker locker(&state.mutex);
+    PaintReport report;
+    report.paintCount = state.paintCount;
+    report.totalNs = state.totalNs;
+    report.area = state.area;
+    report.elapsedMs = state.window.isValid() ? state.window.elapsed() : 0;
+    report.widgets.reserve(state.widgets.size());
+    for (const PaintWidgetEntry &entry : std::as_const(state.widgets)) {
+        report.widgets.push_back(entry.cost);
+    }
+    report.classes = state.classes;
+    locker.unlock();
+
+    const auto byTime = [](const PaintCost &a, const PaintCost &b) {
+        return a.totalNs > b.totalNs;
+    };
+    std::stable_sort(report.widgets.begin(), report.widgets.end(), byTime);
+    std::stable_sort(report.classes.begin(), report.classes.end(), byTime);
+    return report;
+}
+
+void Diagnostics::resetPaintReport()
+{
+    PaintProfileState &state = paintProfileState();
+    QMutexLocker locker(&state.mutex);
+    state.widgetIndex.clear();
+    state.widgets.clear();
+    state.classIndex.clear();
+    state.classes.clear();
+    state.paintCount = 0;
+    state.totalNs = 0;
+    state.area = 0;
+    if (g_paintProbe) {
+        state.window.start();
+    } else {
+        state.window.invalidate();
+    }
+}
+
+QByteArray Diagnostics::paintReportJson()
+{
+    const PaintReport report = paintReport();
+
+    const auto costsToJson = [](const QVector<PaintCost> &costs, bool instances) {
+        QJsonArray array;
+        for (const PaintCost &cost : costs) {
+            QJsonObject entry;
+            entry.insert(QStringLiteral("className"), cost.className);
+            if (instances) {
+                entry.insert(QStringLiteral("objectName"), cost.objectName);
+                entry.insert(QStringLiteral("widget"), QStringLiteral("0x%1").arg(cost.widget, 0, 16));
+            }
+            entry.insert(QStringLiteral("count"), cost.count);
+            entry.insert(QStringLiteral("totalMs"), nsToMs(cost.totalNs));
+            entry.insert(QStringLiteral("maxMs"), nsToMs(cost.maxNs));
+            entry.insert(QStringLiteral("area"), static_cast<double>(cost.area));
+            array.append(entry);
+        }
+        return array;
+    };
+
+    QJsonObject root;
+    root.insert(QStringLiteral("paintCount"), report.paintCount);
+    root.insert(QStringLiteral("totalMs"), nsToMs(report.totalNs));
+    root.insert(QStringLiteral("area"), static_cast<double>(report.area));
+    root.insert(QStringLiteral("elapsedMs"), static_cast<double>(report.elapsedMs));
+    root.insert(QStringLiteral("classes"), costsToJson(report.classes, false));
+    root.insert(QStringLiteral("widgets"), costsToJson(report.widgets, true));
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+bool Diagnostics::writePaintReport(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    const QByteArray json = paintReportJson();
+    return file.write(json) == json.size();
+}
+
+void Diagnostics::setRepaintFlashEnabled(bool enabled)
+{
+    g_repaintFlashEnabled.store(enabled, std::memory_order_release);
+    syncPaintProbe();
+}
+
+bool Diagnostics::repaintFlashEnabled()
+{
+    return g_repaintFlashEnabled.load(std::memory_order_acquire);
+}
+
+void Diagnostics::markStartupPhase(const QString &name)
+{
+    recordStartupPhase(name);
+}
+
+StartupTrace Diagnostics::startupTrace()
+{
+    StartupTraceState &state = startupTraceState();
+    QMutexLocker locker(&state.mutex);
+    return state.trace;
+}
+
+void Diagnostics::resetStartupTrace()
+{
+    StartupTraceState &state = startupTraceState();
+    {
+        QMutexLocker locker(&state.mutex);
+        state.trace = StartupTrace();
+        state.shown = false;
+        state.exposed = false;
+        state.painted = false;
+    }
+    if (g_startupProbe) {
+        if (QCoreApplication *app = QCoreApplication::instance()) {
+            app->removeEventFilter(g_startupProbe);
+        }
+        delete g_startupProbe;
+    }
+    armStartupProbe();
+}
+
+QByteArray Diagnostics::startupTraceJson()
+{
+    const StartupTrace trace = startupTrace();
+
+    QJsonArray phases;
+    qint64 previousNs = 0;
+    for (const StartupPhase &phase : trace.phases) {
+        QJsonObject entry;
+        entry.insert(QStringLiteral("name"), phase.name);
+        entry.insert(QStringLiteral("ms"), nsToMs(phase.elapsedNs));
+        entry.insert(QStringLiteral("deltaMs"), nsToMs(phase.elapsedNs - previousNs));
+        phases.append(entry);
+        previousNs = phase.elapsedNs;
+    }
+
+    QJsonObject root;
+    root.insert(QStringLiteral("complete"), trace.complete);
+    root.insert(QStringLiteral("firstFrameMs"), nsToMs(trace.firstFrameNs));
+    root.insert(QStringLiteral("phases"), phases);
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+bool Diagnostics::writeStartupTrace(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    const QByteArray json = startupTraceJson();
+    return file.write(json) == json.size();
+}
+
+const QLoggingCategory &Diagnostics::themeSwitchLog()
+{
+    static QLoggingCategory category("qtfluent.themeswitch", QtWarningMsg);
+    static const bool envApplied = []() {
+        if (isTruthyEnv(qgetenv("QTFLUENT_THEME_SWITCH_LOG"), false)) {
+            category.setEnabled(QtInfoMsg, true);
+        }
+        return true;
+    }();
+    Q_UNUSED(envApplied)
+    return category;
+}
+
+const QLoggingCategory &Diagnostics::startupLog()
+{
+    static QLoggingCategory category("qtfluent.startup", QtWarningMsg);
+    static const bool envApplied = []() {
+        if (isTruthyEnv(qgetenv("QTFLUENT_STARTUP_TRACE"), false)) {
+            category.setEnabled(QtInfoMsg, true);
+        }
+        return true;
+    }();
+    Q_UNUSED(envApplied)
+    return category;
+}
+
+namespace ThemeProfiler {
+
+void beginDispatch()
+{
+    if (!g_themeProfilingEnabled.load(std::memory_order_acquire)) {
+        return;
+    }
+    syncStyleChangeCounter();
+
+    ThemeProfileState &state = themeProfileState();
+    state.stack.clear();
+    state.attributedNs = 0;
+    state.dispatching = true;
+}
+
+void endDispatch(qint64 elapsedNs)
+{
+    ThemeProfileState &state = themeProfileState();
+    if (!state.dispatching) {
+        return;
+    }
+    state.dispatching = false;
+    state.stack.clear();
+
+    QMutexLocker locker(&state.mutex);
+    ++state.report.dispatchCount;
+    state.report.dispatchNs += elapsedNs;
+    state.report.lastDispatchNs = elapsedNs;
+    state.report.unattributedNs += qMax<qint64>(0, elapsedNs - state.attributedNs);
+}
+
+ReceiverScope::ReceiverScope(const QObject *receiver)
+{
+    ThemeProfileState &state = themeProfileState();
+    if (!state.dispatching || !receiver) {
+        return;
+    }
+
+    const QString className = QString::fromLatin1(receiver->metaObject()->className());
+    const QString objectName = receiver->objectName();
+    const QString key = className + QLatin1Char('\n') + objectName;
+
+    ThemeProfileFrame frame;
+    {
+        QMutexLocker locker(&state.mutex);
+        int index = state.receiverIndex.value(key, -1);
+        if (index < 0) {
+            ThemeReceiverCost cost;
+            cost.className = className;
+            cost.objectName = objectName;
+            index = state.report.receivers.size();
+            state.receiverIndex.insert(key, index);
+            state.report.receivers.push_back(cost);
+        }
+        frame.receiver = index;
+    }
+
+    m_active = true;
+    state.stack.push_back(frame);
+    state.stack.last().timer.start();
+}
+
+ReceiverScope::~ReceiverScope()
+{
+    if (!m_active) {
+        return;
+    }
+
+    ThemeProfileState &state = themeProfileState();
+    if (state.stack.isEmpty()) {
+        return;
+    }
+
+    const ThemeProfileFrame frame = state.stack.takeLast();
+    const qint64 inclusiveNs = frame.timer.nsecsElapsed();
+    const qint64 exclusiveNs = qMax<qint64>(0, inclusiveNs - frame.childNs);
+    if (state.stack.isEmpty()) {
+        state.attributedNs += inclusiveNs;
+    } else {
+        state.stack.last().childNs += inclusiveNs;
+    }
+
+    QMutexLocker locker(&state.mutex);
+    if (frame.receiver < 0 || frame.receiver >= state.report.receivers.size()) {
+        return;
+    }
+    ThemeReceiverCost &cost = state.report.receivers[frame.receiver];
+    ++cost.count;
+    cost.totalNs += exclusiveNs;
+    cost.maxNs = qMax(cost.maxNs, exclusiveNs);
+}
+
+void setStyleSheetIfChanged(QWidget *widget, const QString &styleSheet)
+{
+    if (!widget || widget->styleSheet() == styleSheet) {
+        return;
+    }
+
+    ThemeProfileState &state = themeProfileState();
+    if (!state.dispatching) {
+        widget->setStyleSheet(styleSheet);
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    widget->setStyleSheet(styleSheet);
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    QMutexLocker locker(&state.mutex);
+    ++state.report.styleSheetCount;
+    state.report.styleSheetNs += elapsed;
+}
+
+} // namespace ThemeProfiler
+
 } // namespace Fluent
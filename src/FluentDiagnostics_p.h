@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Fluent/FluentDiagnostics.h"
+
+#include <QLoggingCategory>
+#include <QString>
+#include <QtGlobal>
+
+class QObject;
+class QWidget;
+
+namespace Fluent {
+namespace ThemeProfiler {
+
+// Called by ThemeManager around the themeChanged emission.
+void beginDispatch();
+void endDispatch(qint64 elapsedNs);
+
+// Place at the top of a themeChanged handler to attribute its time to receiver.
+class ReceiverScope final
+{
+public:
+    explicit ReceiverScope(const QObject *receiver);
+    ~ReceiverScope();
+
+    ReceiverScope(const ReceiverScope &) = delete;
+    ReceiverScope &operator=(const ReceiverScope &) = delete;
+
+private:
+    bool m_active = false;
+};
+
+// Applies styleSheet only when it differs from the current one; timed while profiling.
+void setStyleSheetIfChanged(QWidget *widget, const QString &styleSheet);
+
+} // namespace ThemeProfiler
+} // namespace Fluent
@@ -4,6 +4,7 @@
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
 #include "Fluent/FluentToolButton.h"
+#include "FluentDiagnostics_p.h"
 
 #include <QEvent>
 #include <QPainter>
@@ -293,6 +294,8 @@ void FluentDialog::teardownMaskOverlay()
 
 void FluentDialog::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     // Skip animation while hidden to avoid painting on an unready surface.
     if (isVisible()) {
         m_border.onThemeChanged();
@@ -304,9 +307,7 @@ void FluentDialog::applyTheme()
     const QString next =
         "QDialog { background: transparent; }"
         "QDialog QWidget { background: transparent; }";
-    if (styleSheet() != next) {
-        setStyleSheet(next);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(this, next);
 
     updateTitleBarContent();
     updateWindowControlIcons();
@@ -590,9 +591,7 @@ void FluentDialog::updateTitleBarContent()
         "#FluentDialogTitleBarHost { background: transparent; %1 border-top: none; }"
         "#FluentDialogTitle { color: %2; font-weight: 600; }"
     ).arg(bottomRule, colors.text.name(QColor::HexArgb));
-    if (m_titleBarHost->styleSheet() != next) {
-        m_titleBarHost->setStyleSheet(next);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(m_titleBarHost, next);
 }
 
 void FluentDialog::updateWindowControlIcons()
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <QList>
+#include <QObject>
+#include <QPainter>
+#include <QPixmap>
+#include <QPointer>
+#include <QRect>
+#include <QSizePolicy>
+#include <QWidget>
+#include <QtGlobal>
+
+#include <utility>
+
+namespace Fluent {
+
+// Fades a widget from a cached layer instead of a QGraphicsOpacityEffect.
+// begin() renders the live children into one pixmap and hides them while
+// keeping their layout space; during the fade the host paints its own chrome
+// with opacity() and calls paint() to blit the layer, and end() swaps the live
+// children back in. A frame therefore costs the host's own paint plus one
+// blit, where the effect re-rendered the whole subtree offscreen every frame.
+class FluentFadeLayer final : public QObject
+{
+public:
+    explicit FluentFadeLayer(QWidget *host)
+        : QObject(host)
+        , m_host(host)
+    {
+        setObjectName(QStringLiteral("FluentFadeLayer"));
+    }
+
+    bool isActive() const { return m_active; }
+    qreal opacity() const { return m_active ? m_opacity : 1.0; }
+    int captureCount() const { return m_captureCount; }
+
+    void begin(qreal opacity)
+    {
+        if (!m_host) {
+            return;
+        }
+        if (m_active) {
+            setOpacity(opacity);
+            return;
+        }
+
+        m_active = true;
+        m_opacity = qBound<qreal>(0.0, opacity, 1.0);
+        capture();
+        m_host->update();
+    }
+
+    void setOpacity(qreal opacity)
+    {
+        opacity = qBound<qreal>(0.0, opacity, 1.0);
+        if (!m_active || qFuzzyCompare(m_opacity, opacity)) {
+            return;
+        }
+        m_opacity = opacity;
+        m_host->update();
+    }
+
+    // Re-renders the layer, e.g. when a theme switch restyled the children mid-fade.
+    void refresh()
+    {
+        if (!m_active) {
+            return;
+        }
+        restoreChildren();
+        capture();
+        m_host->update();
+    }
+
+    void end()
+    {
+        if (!m_active) {
+            return;
+        }
+        m_active = false;
+        m_opacity = 1.0;
+        m_layer = QPixmap();
+        restoreChildren();
+        if (m_host) {
+            m_host->update();
+        }
+    }
+
+    // Draws the cached children; the layer keeps its capture size, so a host
+    // that collapses while fading simply clips it.
+    void paint(QPainter &painter) const
+    {
+        if (!m_active || m_layer.isNull() || m_opacity <= 0.0) {
+            return;
+        }
+        painter.save();
+        painter.setOpacity(m_opacity);
+        painter.setClipRect(m_host->rect(), Qt::IntersectClip);
+        painter.drawPixmap(0, 0, m_layer);
+        painter.restore();
+    }
+
+private:
+    struct HiddenChild {
+        QPointer<QWidget> widget;
+        bool retainSize = false;
+    };
+
+    void capture()
+    {
+        m_layer = QPixmap();
+        m_hidden.clear();
+
+        QList<QWidget *> children;
+        QRect bounds = m_host->rect();
+        const auto candidates = m_host->findChildren<QWidget *>(QString(), Qt::FindDirectChildrenOnly);
+        for (QWidget *child : candidates) {
+            if (!child || child->isWindow() || child->isHidden()) {
+                continue;
+            }
+            children.append(child);
+            bounds |= child->geometry();
+        }
+
+        ++m_captureCount;
+        if (children.isEmpty() || bounds.isEmpty()) {
+            return;
+        }
+
+        qreal dpr = m_host->devicePixelRatioF();
+        if (dpr <= 0.0) {
+            dpr = 1.0;
+        }
+        const QSize size(bounds.right() + 1, bounds.bottom() + 1);
+        QPixmap layer(size * dpr);
+        layer.setDevicePixelRatio(dpr);
+        layer.fill(Qt::transparent);
+        for (QWidget *child : std::as_const(children)) {
+            child->render(&layer, child->pos());
+        }
+        m_layer = layer;
+
+        for (QWidget *child : std::as_const(children)) {
+            QSizePolicy policy = child->sizePolicy();
+            m_hidden.append({child, policy.retainSizeWhenHidden()});
+            policy.setRetainSizeWhenHidden(true);
+            child->setSizePolicy(policy);
+            child->hide();
+        }
+    }
+
+    void restoreChildren()
+    {
+        const auto hidden = m_hidden;
+        m_hidden.clear();
+        for (const HiddenChild &entry : hidden) {
+            if (!entry.widget) {
+                continue;
+            }
+            entry.widget->show();
+            QSizePolicy policy = entry.widget->sizePolicy();
+            policy.setRetainSizeWhenHidden(entry.retainSize);
+            entry.widget->setSizePolicy(policy);
+        }
+    }
+
+    QWidget *m_host = nullptr;
+    QPixmap m_layer;
+    QList<HiddenChild> m_hidden;
+    qreal m_opacity = 1.0;
+    bool m_active = false;
+    int m_captureCount = 0;
+};
+
+} // namespace Fluent
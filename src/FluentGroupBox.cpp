@@ -1,6 +1,8 @@
 #include "Fluent/FluentGroupBox.h"
 #include "Fluent/FluentFramePainter.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QEvent>
 #include <QPainter>
@@ -71,7 +73,7 @@ FluentGroupBox::FluentGroupBox(QWidget *parent)
 {
     initializeGroupBox(this);
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentGroupBox::applyTheme);
+    ThemeRegistry::enroll<&FluentGroupBox::applyTheme>(this);
 }
 
 FluentGroupBox::FluentGroupBox(const QString &title, QWidget *parent)
@@ -79,7 +81,7 @@ FluentGroupBox::FluentGroupBox(const QString &title, QWidget *parent)
 {
     initializeGroupBox(this);
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentGroupBox::applyTheme);
+    ThemeRegistry::enroll<&FluentGroupBox::applyTheme>(this);
 }
 
 void FluentGroupBox::changeEvent(QEvent *event)
@@ -139,6 +141,8 @@ void FluentGroupBox::paintEvent(QPaintEvent *event)
 
 void FluentGroupBox::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     update();
 }
 
@@ -873,6 +873,31 @@ bool paintNativeIcon(QPainter *painter, FluentIconType type, const QRectF &rect,
     return true;
 }
 
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+using HashValue = size_t;
+#else
+using HashValue = uint;
+#endif
+
+// All 32-bit fields, so the bytes carry no padding. The icon state is left
+// out: it does not change the rendering.
+struct IconPixmapKey {
+    int width = 0;
+    int height = 0;
+    int mode = 0;
+    int scale = 0; // device pixel ratio in 1/100
+
+    bool operator==(const IconPixmapKey &other) const
+    {
+        return width == other.width && height == other.height && mode == other.mode && scale == other.scale;
+    }
+};
+
+inline HashValue qHash(const IconPixmapKey &key, HashValue seed = 0)
+{
+    return qHashBits(&key, sizeof(IconPixmapKey), seed);
+}
+
 class FluentIconEngine final : public QIconEngine
 {
 public:
@@ -887,26 +912,88 @@ public:
         return new FluentIconEngine(m_type, m_options);
     }
 
+    QString key() const override
+    {
+        return QStringLiteral("FluentIconEngine");
+    }
+
+    // Vector icons render exactly at any requested size.
+    QSize actualSize(const QSize &size, QIcon::Mode /*mode*/, QIcon::State /*state*/) override
+    {
+        return size;
+    }
+
     void paint(QPainter *painter, const QRect &rect, QIcon::Mode mode, QIcon::State /*state*/) override
     {
         FluentIcon(m_type).paint(painter, QRectF(rect), m_options, mode);
     }
 
-    QPixmap pixmap(const QSize &size, QIcon::Mode mode, QIcon::State state) override
+    QPixmap pixmap(const QSize &size, QIcon::Mode mode, QIcon::State /*state*/) override
     {
-        Q_UNUSED(state);
+        return cachedPixmap(size, mode, 1.0);
+    }
 
-        QPixmap pm(size);
-        pm.fill(Qt::transparent);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    QPixmap scaledPixmap(const QSize &size, QIcon::Mode mode, QIcon::State /*state*/, qreal scale) override
+    {
+        if (scale <= 0.0) {
+            scale = 1.0;
+        }
+#if QT_VERSION >= QT_VERSION_CHECK(6, 8, 0)
+        // The size is device independent.
+        return cachedPixmap(QSize(qRound(size.width() * scale), qRound(size.height() * scale)), mode, scale);
+#else
+        // QIcon::pixmap() already scaled the size to device pixels.
+        return cachedPixmap(size, mode, scale);
+#endif
+    }
+#endif
+
+private:
+    struct CachedPixmap {
+        QPixmap pixmap;
+        QRgb color = 0;
+    };
+
+    // Item views and tool buttons ask for the same pixmap on every paint;
+    // handing back the cached QPixmap also keeps its cacheKey() stable for
+    // callers that key QPixmapCache on it. An entry is dropped once the
+    // resolved color moves away from the one it was rendered with, which is
+    // how a theme switch reaches icons that follow the theme.
+    QPixmap cachedPixmap(const QSize &deviceSize, QIcon::Mode mode, qreal scale)
+    {
+        if (deviceSize.isEmpty()) {
+            return {};
+        }
 
-        QPainter painter(&pm);
-        FluentIcon(m_type).paint(&painter, QRectF(QPointF(0, 0), QSizeF(size)), m_options, mode);
+        const QRgb color = FluentIcon::resolveColor(m_options, mode).rgba();
+        const IconPixmapKey key{deviceSize.width(), deviceSize.height(), static_cast<int>(mode), qRound(scale * 100.0)};
+        const auto it = m_cache.constFind(key);
+        if (it != m_cache.constEnd()) {
+            if (it->color == color) {
+                return it->pixmap;
+            }
+            // The theme changed; every other entry is stale as well.
+            m_cache.clear();
+        }
+        if (m_cache.size() >= 32) {
+            m_cache.clear();
+        }
+
+        QPixmap pm(deviceSize);
+        pm.fill(Qt::transparent);
+        {
+            QPainter painter(&pm);
+            FluentIcon(m_type).paint(&painter, QRectF(QPointF(0, 0), QSizeF(deviceSize)), m_options, mode);
+        }
+        pm.setDevicePixelRatio(scale);
+        m_cache.insert(key, {pm, color});
         return pm;
     }
 
-private:
     FluentIconType m_type;
     FluentIconOptions m_options;
+    QHash<IconPixmapKey, CachedPixmap> m_cache;
 };
 
 } // namespace
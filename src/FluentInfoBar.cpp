@@ -8,10 +8,12 @@
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
 #include "Fluent/FluentToolButton.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
+#include "FluentFadeLayer_p.h"
 
 #include <QEvent>
 #include <QBoxLayout>
-#include <QGraphicsOpacityEffect>
 #include <QHBoxLayout>
 #include <QParallelAnimationGroup>
 #include <QPainter>
@@ -19,6 +21,7 @@
 #include <QPropertyAnimation>
 #include <QSizePolicy>
 #include <QShowEvent>
+#include <QVariantAnimation>
 #include <QVBoxLayout>
 
 namespace Fluent {
@@ -133,9 +136,7 @@ FluentInfoBar::FluentInfoBar(QWidget *parent)
     setAutoFillBackground(false);
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
 
-    m_opacityEffect = new QGraphicsOpacityEffect(this);
-    m_opacityEffect->setOpacity(1.0);
-    setGraphicsEffect(m_opacityEffect);
+    m_fade = new FluentFadeLayer(this);
 
     m_layout = new QHBoxLayout(this);
 
@@ -183,7 +184,7 @@ FluentInfoBar::FluentInfoBar(QWidget *parent)
     updateLayoutMode();
     applyTheme();
     updateContent();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentInfoBar::applyTheme);
+    ThemeRegistry::enroll<&FluentInfoBar::applyTheme>(this);
 }
 
 FluentInfoBar::FluentInfoBar(Severity severity, const QString &title, const QString &message, QWidget *parent)
@@ -307,6 +308,8 @@ void FluentInfoBar::showEvent(QShowEvent *event)
 
 void FluentInfoBar::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     if (m_dismissInProgress && m_dismissGroup && FluentMotion::duration(FluentMotionRole::PopupClose) <= 0) {
         finishDismissImmediately();
         return;
@@ -339,10 +342,6 @@ void FluentInfoBar::dismiss()
     m_preDismissMinimumHeight = minimumHeight();
     m_preDismissMaximumHeight = maximumHeight();
 
-    if (m_opacityEffect) {
-        m_opacityEffect->setOpacity(1.0);
-    }
-
     const int duration = FluentMotion::duration(FluentMotionRole::PopupClose);
     if (duration <= 0 || !isVisible()) {
         hide();
@@ -358,13 +357,15 @@ void FluentInfoBar::dismiss()
     auto *group = new QParallelAnimationGroup(this);
     m_dismissGroup = group;
 
-    if (m_opacityEffect) {
-        auto *fade = new QPropertyAnimation(m_opacityEffect, "opacity", group);
-        FluentMotion::configure(fade, FluentMotionRole::PopupClose);
-        fade->setStartValue(m_opacityEffect->opacity());
-        fade->setEndValue(0.0);
-        group->addAnimation(fade);
-    }
+    m_fade->begin(1.0);
+    auto *fade = new QVariantAnimation(group);
+    FluentMotion::configure(fade, FluentMotionRole::PopupClose);
+    fade->setStartValue(1.0);
+    fade->setEndValue(0.0);
+    connect(fade, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
+        m_fade->setOpacity(value.toReal());
+    });
+    group->addAnimation(fade);
 
     auto *collapse = new QPropertyAnimation(this, "maximumHeight", group);
     FluentMotion::configure(collapse, FluentMotionRole::PopupClose);
@@ -416,9 +417,7 @@ void FluentInfoBar::restoreDismissGeometry()
         setMaximumHeight(m_preDismissMaximumHeight);
         m_hasDismissGeometry = false;
     }
-    if (m_opacityEffect) {
-        m_opacityEffect->setOpacity(1.0);
-    }
+    m_fade->end();
 }
 
 void FluentInfoBar::updateLayoutMode()
@@ -473,6 +472,7 @@ void FluentInfoBar::paintEvent(QPaintEvent *event)
     if (!p.isActive()) {
         return;
     }
+    p.setOpacity(m_fade->opacity());
 
     const QRectF r = QRectF(rect()).adjusted(0.5, 0.5, -0.5, -0.5);
     FluentSurfaceSpec surface;
@@ -493,6 +493,8 @@ void FluentInfoBar::paintEvent(QPaintEvent *event)
     }
     p.setBrush(stripe);
     p.drawRoundedRect(QRectF(r.left() + 1.0, r.top() + 8.0, 3.0, r.height() - 16.0), 1.5, 1.5);
+
+    m_fade->paint(p);
 }
 
 } // namespace Fluent
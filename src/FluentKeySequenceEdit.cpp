@@ -3,6 +3,8 @@
 #include "Fluent/FluentMotion.h"
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 #include "FluentInputVisuals_p.h"
 
 #include <QAbstractAnimation>
@@ -177,7 +179,7 @@ void FluentKeySequenceEdit::initializeControl()
 
     ensureEditor();
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentKeySequenceEdit::applyTheme);
+    ThemeRegistry::enroll<&FluentKeySequenceEdit::applyTheme>(this);
 }
 
 void FluentKeySequenceEdit::ensureEditor()
@@ -199,6 +201,8 @@ void FluentKeySequenceEdit::ensureEditor()
 
 void FluentKeySequenceEdit::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool focusRunning = m_focusAnim && m_focusAnim->state() == QAbstractAnimation::Running;
     const QVariant hoverEnd = m_hoverAnim ? m_hoverAnim->endValue() : QVariant();
@@ -225,9 +229,7 @@ void FluentKeySequenceEdit::applyTheme()
 
     const QString hostStyle = QStringLiteral(
         "QKeySequenceEdit { background: transparent; border: none; padding: 0px; }");
-    if (styleSheet() != hostStyle) {
-        setStyleSheet(hostStyle);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(this, hostStyle);
 
     if (m_editor != nullptr) {
         const QColor textColor = isEnabled() ? colors.text : colors.disabledText;
@@ -248,9 +250,7 @@ void FluentKeySequenceEdit::applyTheme()
                  selectionBg.name(QColor::HexArgb),
                  colors.text.name(QColor::HexArgb),
                  colors.disabledText.name(QColor::HexArgb));
-        if (m_editor->styleSheet() != editorStyle) {
-            m_editor->setStyleSheet(editorStyle);
-        }
+        ThemeProfiler::setStyleSheetIfChanged(m_editor, editorStyle);
 
         QPalette palette = m_editor->palette();
         // QSS owns text color; QPalette::Text is left for the native caret color.
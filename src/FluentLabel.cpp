@@ -1,5 +1,7 @@
 #include "Fluent/FluentLabel.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QEvent>
 
@@ -24,14 +26,14 @@ FluentLabel::FluentLabel(QWidget *parent)
     : QLabel(parent)
 {
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentLabel::applyTheme);
+    ThemeRegistry::enroll<&FluentLabel::applyTheme>(this);
 }
 
 FluentLabel::FluentLabel(const QString &text, QWidget *parent)
     : QLabel(text, parent)
 {
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentLabel::applyTheme);
+    ThemeRegistry::enroll<&FluentLabel::applyTheme>(this);
 }
 
 void FluentLabel::setStyleSheet(const QString &styleSheet)
@@ -54,6 +56,8 @@ void FluentLabel::changeEvent(QEvent *event)
 
 void FluentLabel::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const auto &colors = ThemeManager::instance().colors();
 
     // Don't clobber user styles (e.g. font-weight) on theme changes.
@@ -3,6 +3,8 @@
 #include "Fluent/FluentQtCompat.h"
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 #include "FluentInputVisuals_p.h"
 
 #include <QAbstractAnimation>
@@ -22,22 +24,8 @@ FluentLineEdit::FluentLineEdit(QWidget *parent)
     setMouseTracking(true);
     setAttribute(Qt::WA_Hover, true);
 
-    m_hoverAnim = new QVariantAnimation(this);
-    FluentMotion::configure(m_hoverAnim, FluentMotionRole::Hover);
-    connect(m_hoverAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_hoverLevel = value.toReal();
-        update();
-    });
-
-    m_focusAnim = new QVariantAnimation(this);
-    FluentMotion::configure(m_focusAnim, FluentMotionRole::Focus);
-    connect(m_focusAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_focusLevel = value.toReal();
-        update();
-    });
-
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentLineEdit::applyTheme);
+    ThemeRegistry::enroll<&FluentLineEdit::applyTheme>(this);
 }
 
 FluentLineEdit::FluentLineEdit(const QString &text, QWidget *parent)
@@ -50,22 +38,8 @@ FluentLineEdit::FluentLineEdit(const QString &text, QWidget *parent)
     setMouseTracking(true);
     setAttribute(Qt::WA_Hover, true);
 
-    m_hoverAnim = new QVariantAnimation(this);
-    FluentMotion::configure(m_hoverAnim, FluentMotionRole::Hover);
-    connect(m_hoverAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_hoverLevel = value.toReal();
-        update();
-    });
-
-    m_focusAnim = new QVariantAnimation(this);
-    FluentMotion::configure(m_focusAnim, FluentMotionRole::Focus);
-    connect(m_focusAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_focusLevel = value.toReal();
-        update();
-    });
-
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentLineEdit::applyTheme);
+    ThemeRegistry::enroll<&FluentLineEdit::applyTheme>(this);
 }
 
 qreal FluentLineEdit::hoverLevel() const
@@ -101,6 +75,8 @@ void FluentLineEdit::changeEvent(QEvent *event)
 
 void FluentLineEdit::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool focusRunning = m_focusAnim && m_focusAnim->state() == QAbstractAnimation::Running;
     const QVariant hoverEnd = m_hoverAnim ? m_hoverAnim->endValue() : QVariant();
@@ -133,9 +109,7 @@ void FluentLineEdit::applyTheme()
              selectionBg.name(QColor::HexArgb),
              colors.text.name(QColor::HexArgb),
              colors.disabledText.name(QColor::HexArgb));
-    if (styleSheet() != next) {
-        setStyleSheet(next);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(this, next);
 
     // QSS owns text color; QPalette::Text is left for the native caret color.
     QPalette pal = palette();
@@ -207,28 +181,16 @@ void FluentLineEdit::focusOutEvent(QFocusEvent *event)
 
 void FluentLineEdit::startHoverAnimation(qreal endValue)
 {
-    FluentMotion::configure(m_hoverAnim, FluentMotionRole::Hover);
-    m_hoverAnim->stop();
-    if (m_hoverAnim->duration() <= 0) {
-        setHoverLevel(endValue);
-        return;
-    }
-    m_hoverAnim->setStartValue(m_hoverLevel);
-    m_hoverAnim->setEndValue(endValue);
-    m_hoverAnim->start();
+    FluentMotion::animateLevel(this, m_hoverAnim, FluentMotionRole::Hover, m_hoverLevel, endValue, [this](qreal level) {
+        setHoverLevel(level);
+    });
 }
 
 void FluentLineEdit::startFocusAnimation(qreal endValue)
 {
-    FluentMotion::configure(m_focusAnim, FluentMotionRole::Focus);
-    m_focusAnim->stop();
-    if (m_focusAnim->duration() <= 0) {
-        setFocusLevel(endValue);
-        return;
-    }
-    m_focusAnim->setStartValue(m_focusLevel);
-    m_focusAnim->setEndValue(endValue);
-    m_focusAnim->start();
+    FluentMotion::animateLevel(this, m_focusAnim, FluentMotionRole::Focus, m_focusLevel, endValue, [this](qreal level) {
+        setFocusLevel(level);
+    });
 }
 
 } // namespace Fluent
@@ -6,6 +6,8 @@
 #include "FluentItemEditorSupport.h"
 #include "FluentItemViewPaintSupport.h"
 #include "FluentViewPaletteSupport.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QAbstractItemModel>
 #include <QEvent>
@@ -129,38 +131,8 @@ FluentListView::FluentListView(QWidget *parent)
     setVerticalScrollBar(new FluentScrollBar(Qt::Vertical, this));
     setHorizontalScrollBar(new FluentScrollBar(Qt::Horizontal, this));
 
-    m_hoverAnim = new QVariantAnimation(this);
-    FluentMotion::configure(m_hoverAnim, FluentMotionRole::Hover);
-    connect(m_hoverAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_hoverLevel = value.toReal();
-        viewport()->update();
-    });
-
-    m_selAnim = new QVariantAnimation(this);
-    FluentMotion::configure(m_selAnim, FluentMotionRole::Selection);
-    connect(m_selAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        const qreal t = value.toReal();
-        const qreal tt = qBound<qreal>(0.0, t, 1.0);
-        m_selRect = QRectF(
-            m_selStartRect.x() + (m_selTargetRect.x() - m_selStartRect.x()) * tt,
-            m_selStartRect.y() + (m_selTargetRect.y() - m_selStartRect.y()) * tt,
-            m_selStartRect.width() + (m_selTargetRect.width() - m_selStartRect.width()) * tt,
-            m_selStartRect.height() + (m_selTargetRect.height() - m_selStartRect.height()) * tt);
-        m_selOpacity = m_selStartOpacity + (m_selTargetOpacity - m_selStartOpacity) * tt;
-        viewport()->update();
-    });
-    connect(m_selAnim, &QVariantAnimation::finished, this, [this]() {
-        if (m_selTargetOpacity <= 0.0) {
-            m_selRect = QRectF();
-            m_selOpacity = 0.0;
-        } else {
-            m_selOpacity = 1.0;
-        }
-        viewport()->update();
-    });
-
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentListView::applyTheme);
+    ThemeRegistry::enroll<&FluentListView::applyTheme>(this);
 
     // Model may be set after construction.
     QTimer::singleShot(0, this, [this]() { hookSelectionModel(); });
@@ -246,6 +218,8 @@ void FluentListView::leaveEvent(QEvent *event)
 
 void FluentListView::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool selectionRunning = m_selAnim && m_selAnim->state() == QAbstractAnimation::Running;
     const QVariant hoverEnd = m_hoverAnim ? m_hoverAnim->endValue() : QVariant();
@@ -271,9 +245,7 @@ void FluentListView::applyTheme()
 
     const auto &colors = ThemeManager::instance().colors();
     const QString next = Theme::listViewStyle(colors);
-    if (styleSheet() != next) {
-        setStyleSheet(next);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(this, next);
     Detail::applyFluentViewPalette(this, viewport(), colors);
 }
 
@@ -328,22 +300,27 @@ void FluentListView::startSelectionAnimation(const QModelIndex &from, const QMod
     const QRectF targetRect = selectionRectForIndex(to);
     const bool targetValid = targetRect.isValid();
     const auto startSelectionMotion = [this]() {
-        FluentMotion::configure(m_selAnim, FluentMotionRole::Selection);
-        m_selAnim->stop();
-        if (m_selAnim->duration() <= 0) {
-            if (m_selTargetOpacity <= 0.0) {
-                m_selRect = QRectF();
-                m_selOpacity = 0.0;
+        FluentMotion::animateLevel(this, m_selAnim, FluentMotionRole::Selection, 0.0, 1.0, [this](qreal t) {
+            const qreal tt = qBound<qreal>(0.0, t, 1.0);
+            if (tt >= 1.0) {
+                // Settled: a fade-out drops the indicator, anything else lands opaque.
+                if (m_selTargetOpacity <= 0.0) {
+                    m_selRect = QRectF();
+                    m_selOpacity = 0.0;
+                } else {
+                    m_selRect = m_selTargetRect;
+                    m_selOpacity = 1.0;
+                }
             } else {
-                m_selRect = m_selTargetRect;
-                m_selOpacity = 1.0;
+                m_selRect = QRectF(
+                    m_selStartRect.x() + (m_selTargetRect.x() - m_selStartRect.x()) * tt,
+                    m_selStartRect.y() + (m_selTargetRect.y() - m_selStartRect.y()) * tt,
+                    m_selStartRect.width() + (m_selTargetRect.width() - m_selStartRect.width()) * tt,
+                    m_selStartRect.height() + (m_selTargetRect.height() - m_selStartRect.height()) * tt);
+                m_selOpacity = m_selStartOpacity + (m_selTargetOpacity - m_selStartOpacity) * tt;
             }
             viewport()->update();
-            return;
-        }
-        m_selAnim->setStartValue(0.0);
-        m_selAnim->setEndValue(1.0);
-        m_selAnim->start();
+        });
     };
 
     // Fade out when selection clears.
@@ -396,16 +373,10 @@ void FluentListView::startSelectionAnimation(const QModelIndex &from, const QMod
 
 void FluentListView::startHoverAnimation(qreal endValue)
 {
-    FluentMotion::configure(m_hoverAnim, FluentMotionRole::Hover);
-    m_hoverAnim->stop();
-    if (m_hoverAnim->duration() <= 0) {
-        m_hoverLevel = qBound<qreal>(0.0, endValue, 1.0);
+    FluentMotion::animateLevel(this, m_hoverAnim, FluentMotionRole::Hover, m_hoverLevel, endValue, [this](qreal level) {
+        m_hoverLevel = qBound<qreal>(0.0, level, 1.0);
         viewport()->update();
-        return;
-    }
-    m_hoverAnim->setStartValue(m_hoverLevel);
-    m_hoverAnim->setEndValue(endValue);
-    m_hoverAnim->start();
+    });
 }
 
 } // namespace Fluent
@@ -7,20 +7,31 @@
 
 #include <rlottie.h>
 
+#include <QCache>
+#include <QCoreApplication>
 #include <QCryptographicHash>
 #include <QEvent>
 #include <QFile>
 #include <QFileInfo>
 #include <QHash>
 #include <QImage>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QPainter>
 #include <QPaintEvent>
 #include <QPixmap>
+#include <QPointer>
 #include <QResizeEvent>
+#include <QRunnable>
+#include <QThreadPool>
 #include <QTimer>
+#include <QVector>
 
+#include <climits>
 #include <cmath>
 #include <cstdint>
+#include <functional>
+#include <iterator>
 #include <tuple>
 
 namespace Fluent {
@@ -151,11 +162,237 @@ bool widgetHasVisibleArea(const QWidget *widget)
     return true;
 }
 
+using LottieModel = std::shared_ptr<rlottie::Animation>;
+
+QString lottieFileKey(const QString &path)
+{
+    return QFileInfo(path).absoluteFilePath();
+}
+
+QString lottieDataKey(const QByteArray &json, const QString &cacheKey)
+{
+    return cacheKey.isEmpty()
+               ? QString::fromLatin1(QCryptographicHash::hash(json, QCryptographicHash::Sha1).toHex())
+               : cacheKey;
+}
+
+class LottieParseTask final : public QRunnable
+{
+public:
+    explicit LottieParseTask(std::function<void()> work)
+        : m_work(std::move(work))
+    {
+        setAutoDelete(true);
+    }
+
+    void run() override
+    {
+        m_work();
+    }
+
+private:
+    std::function<void()> m_work;
+};
+
+// Keeps about this much Lottie JSON worth of recently used models alive
+// without a widget holding them.
+constexpr qint64 kDefaultModelCacheLimit = 16 * 1024 * 1024;
+
+// Parsed rlottie models shared by every FluentLottieWidget. Each source (file
+// path or cache key) is parsed once, off the GUI thread when requested
+// asynchronously; widgets then render the same rlottie::Animation, which is
+// only ever touched on the GUI thread once published here.
+//
+// Sources are tracked weakly, so a model dies with the last widget using it;
+// a small LRU, costed by JSON size, keeps recently used and preloaded models
+// around in between.
+class LottieModelRegistry
+{
+public:
+    // Runs on the worker thread that finished the parse.
+    using Callback = std::function<void(const LottieModel &model, bool readFailed)>;
+
+    static LottieModelRegistry &instance()
+    {
+        // Leaked on purpose: a worker may still publish a model during shutdown.
+        static auto *registry = new LottieModelRegistry;
+        return *registry;
+    }
+
+    LottieModel find(const QString &key)
+    {
+        QMutexLocker locker(&m_mutex);
+        return lookup(key, nullptr);
+    }
+
+    // In-memory sources may reuse a cache key for different JSON, so the
+    // content fingerprint has to match as well.
+    LottieModel find(const QString &key, const QByteArray &json)
+    {
+        QMutexLocker locker(&m_mutex);
+        return lookup(key, &json);
+    }
+
+    LottieModel parse(const QByteArray &json, const QString &key, const QString &resourcePath, bool matchData)
+    {
+        if (LottieModel cached = matchData ? find(key, json) : find(key)) {
+            return cached;
+        }
+
+        // rlottie's own model cache is bypassed; this registry owns sharing.
+        std::unique_ptr<rlottie::Animation> animation =
+            rlottie::Animation::loadFromData(toStdString(json), toStdString(key), toStdString(resourcePath), false);
+        if (!animation) {
+            return {};
+        }
+
+        LottieModel model(std::move(animation));
+        QMutexLocker locker(&m_mutex);
+        pruneExpired();
+        Entry &entry = m_models[key];
+        entry.model = model;
+        entry.dataSize = json.size();
+        entry.dataHash = static_cast<size_t>(qHash(json));
+        m_retained.insert(key, new LottieModel(model), retainCost(json.size()));
+        return model;
+    }
+
+    void requestFile(const QString &path, Callback callback)
+    {
+        const QString key = lottieFileKey(path);
+        {
+            // Concurrent requests for one file share a single parse.
+            QMutexLocker locker(&m_mutex);
+            auto it = m_pendingFiles.find(key);
+            if (it != m_pendingFiles.end()) {
+                it->push_back(std::move(callback));
+                return;
+            }
+            m_pendingFiles.insert(key, QVector<Callback>{std::move(callback)});
+        }
+
+        start([this, path, key]() {
+            LottieModel model;
+            bool readFailed = false;
+            QFile file(path);
+            if (file.open(QIODevice::ReadOnly)) {
+                model = parse(file.readAll(), key, QFileInfo(path).absolutePath(), false);
+            } else {
+                readFailed = true;
+            }
+
+            QVector<Callback> callbacks;
+            {
+                QMutexLocker locker(&m_mutex);
+                callbacks = m_pendingFiles.take(key);
+            }
+            for (const Callback &callback : callbacks) {
+                if (callback) {
+                    callback(model, readFailed);
+                }
+            }
+        });
+    }
+
+    void requestData(const QByteArray &json, const QString &cacheKey, const QString &resourcePath, Callback callback)
+    {
+        start([this, json, cacheKey, resourcePath, callback]() {
+            const LottieModel model = parse(json, lottieDataKey(json, cacheKey), resourcePath, true);
+            if (callback) {
+                callback(model, false);
+            }
+        });
+    }
+
+    void clear()
+    {
+        QMutexLocker locker(&m_mutex);
+        m_retained.clear();
+        m_models.clear();
+    }
+
+    void setRetainLimit(qint64 bytes)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_retainLimit = qMax<qint64>(0, bytes);
+        m_retained.setMaxCost(static_cast<int>(qMin<qint64>(m_retainLimit / 1024, INT_MAX)));
+        pruneExpired();
+    }
+
+    qint64 retainLimit() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_retainLimit;
+    }
+
+private:
+    struct Entry {
+        std::weak_ptr<rlottie::Animation> model;
+        qsizetype dataSize = -1;
+        size_t dataHash = 0;
+    };
+
+    // Costs are in KiB so that the budget fits QCache's int.
+    static int retainCost(qsizetype bytes)
+    {
+        return static_cast<int>(qMin<qsizetype>((bytes + 1023) / 1024, INT_MAX));
+    }
+
+    // Called with m_mutex held. A hit also refreshes the model's LRU slot.
+    LottieModel lookup(const QString &key, const QByteArray *json)
+    {
+        const auto it = m_models.find(key);
+        if (it == m_models.end()) {
+            return {};
+        }
+        LottieModel model = it->model.lock();
+        if (!model) {
+            m_models.erase(it);
+            return {};
+        }
+        if (json && (it->dataSize != json->size() || it->dataHash != static_cast<size_t>(qHash(*json)))) {
+            return {};
+        }
+        if (!m_retained.object(key)) {
+            m_retained.insert(key, new LottieModel(model), retainCost(it->dataSize));
+        }
+        return model;
+    }
+
+    void pruneExpired()
+    {
+        for (auto it = m_models.begin(); it != m_models.end();) {
+            it = it->model.expired() ? m_models.erase(it) : std::next(it);
+        }
+    }
+
+    void start(std::function<void()> work)
+    {
+        QThreadPool::globalInstance()->start(new LottieParseTask(std::move(work)));
+    }
+
+    mutable QMutex m_mutex;
+    QHash<QString, Entry> m_models;
+    qint64 m_retainLimit = kDefaultModelCacheLimit;
+    QCache<QString, LottieModel> m_retained{static_cast<int>(kDefaultModelCacheLimit / 1024)};
+    QHash<QString, QVector<Callback>> m_pendingFiles;
+};
+
+// Hops a worker-thread result back to the GUI thread.
+void postToGuiThread(std::function<void()> fn)
+{
+    if (QCoreApplication *app = QCoreApplication::instance()) {
+        QMetaObject::invokeMethod(app, std::move(fn), Qt::QueuedConnection);
+    }
+}
+
 } // namespace
 
 struct FluentLottieWidget::Private
 {
-    std::unique_ptr<rlottie::Animation> animation;
+    LottieModel animation;
+    quint64 loadToken = 0;
+    bool loading = false;
     QString source;
     QString errorString;
     QSize animationSize;
@@ -223,21 +460,25 @@ void FluentLottieWidget::setSource(const QString &path)
 
 bool FluentLottieWidget::load(const QString &path)
 {
-    QFile file(path);
-    if (!file.open(QIODevice::ReadOnly)) {
-        d->animation.reset();
-        d->source = path;
-        setError(tr("Failed to open Lottie file: %1").arg(path));
-        emit sourceChanged(d->source);
-        update();
-        return false;
+    ++d->loadToken;
+    const QFileInfo info(path);
+    const QString key = info.absoluteFilePath();
+    LottieModelRegistry &registry = LottieModelRegistry::instance();
+    LottieModel model = registry.find(key);
+    if (!model) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            d->animation.reset();
+            d->source = path;
+            finishLoad(tr("Failed to open Lottie file: %1").arg(path));
+            emit sourceChanged(d->source);
+            return false;
+        }
+        model = registry.parse(file.readAll(), key, info.absolutePath(), false);
     }
 
-    const QFileInfo info(path);
-    const QByteArray data = file.readAll();
-    const QString cacheKey = info.absoluteFilePath();
-    const QString resourcePath = info.absolutePath();
-    const bool ok = loadData(data, cacheKey, resourcePath);
+    d->animation = std::move(model);
+    const bool ok = finishLoad(tr("Failed to parse Lottie data."));
 
     if (d->source != path) {
         d->source = path;
@@ -249,40 +490,112 @@ bool FluentLottieWidget::load(const QString &path)
 
 bool FluentLottieWidget::loadData(const QByteArray &json, const QString &cacheKey, const QString &resourcePath)
 {
-    const QString key = cacheKey.isEmpty()
-                            ? QString::fromLatin1(QCryptographicHash::hash(json, QCryptographicHash::Sha1).toHex())
-                            : cacheKey;
+    ++d->loadToken;
+    d->animation = LottieModelRegistry::instance().parse(json, lottieDataKey(json, cacheKey), resourcePath, true);
+    return finishLoad(tr("Failed to parse Lottie data."));
+}
 
-    std::unique_ptr<rlottie::Animation> animation =
-        rlottie::Animation::loadFromData(toStdString(json), toStdString(key), toStdString(resourcePath), true);
+void FluentLottieWidget::loadAsync(const QString &path)
+{
+    const quint64 token = ++d->loadToken;
+    if (d->source != path) {
+        d->source = path;
+        emit sourceChanged(d->source);
+    }
 
-    if (!animation) {
-        d->animation.reset();
-        d->animationSize = {};
-        d->totalFrames = 0;
-        d->markers.clear();
-        d->currentFrame = 0;
-        d->playbackRequested = false;
-        d->playing = false;
-        d->timer->stop();
-        setError(tr("Failed to parse Lottie data."));
-        update();
+    LottieModelRegistry &registry = LottieModelRegistry::instance();
+    if (LottieModel model = registry.find(lottieFileKey(path))) {
+        d->animation = std::move(model);
+        finishLoad(QString());
+        return;
+    }
+
+    d->loading = true;
+    const QPointer<FluentLottieWidget> guard(this);
+    registry.requestFile(path, [guard, token, path](const LottieModel &model, bool readFailed) {
+        postToGuiThread([guard, token, path, model, readFailed]() {
+            if (!guard || guard->d->loadToken != token) {
+                return;
+            }
+            guard->d->animation = model;
+            guard->finishLoad(readFailed ? tr("Failed to open Lottie file: %1").arg(path)
+                                         : tr("Failed to parse Lottie data."));
+        });
+    });
+}
+
+void FluentLottieWidget::loadDataAsync(const QByteArray &json, const QString &cacheKey, const QString &resourcePath)
+{
+    const quint64 token = ++d->loadToken;
+
+    // Without a cache key the SHA1 key is computed on the worker as well.
+    LottieModelRegistry &registry = LottieModelRegistry::instance();
+    if (!cacheKey.isEmpty()) {
+        if (LottieModel model = registry.find(cacheKey, json)) {
+            d->animation = std::move(model);
+            finishLoad(QString());
+            return;
+        }
+    }
+
+    d->loading = true;
+    const QPointer<FluentLottieWidget> guard(this);
+    registry.requestData(json, cacheKey, resourcePath, [guard, token](const LottieModel &model, bool) {
+        postToGuiThread([guard, token, model]() {
+            if (!guard || guard->d->loadToken != token) {
+                return;
+            }
+            guard->d->animation = model;
+            guard->finishLoad(tr("Failed to parse Lottie data."));
+        });
+    });
+}
+
+bool FluentLottieWidget::isLoading() const
+{
+    return d->loading;
+}
+
+void FluentLottieWidget::preload(const QStringList &paths)
+{
+    LottieModelRegistry &registry = LottieModelRegistry::instance();
+    for (const QString &path : paths) {
+        if (!path.isEmpty() && !registry.find(lottieFileKey(path))) {
+            registry.requestFile(path, {});
+        }
+    }
+}
+
+void FluentLottieWidget::preloadData(const QByteArray &json, const QString &cacheKey, const QString &resourcePath)
+{
+    LottieModelRegistry &registry = LottieModelRegistry::instance();
+    if (cacheKey.isEmpty() || !registry.find(cacheKey, json)) {
+        registry.requestData(json, cacheKey, resourcePath, {});
+    }
+}
+
+bool FluentLottieWidget::isModelCached(const QString &pathOrCacheKey)
+{
+    if (pathOrCacheKey.isEmpty()) {
         return false;
     }
+    LottieModelRegistry &registry = LottieModelRegistry::instance();
+    return registry.find(pathOrCacheKey) || registry.find(lottieFileKey(pathOrCacheKey));
+}
 
-    d->animation = std::move(animation);
-    d->errorString.clear();
-    d->segmentActive = false;
-    d->currentFrame = 0;
-    syncAnimationMetadata();
-    syncTimerState();
-    clearRenderCache();
+void FluentLottieWidget::clearModelCache()
+{
+    LottieModelRegistry::instance().clear();
+}
 
-    emit currentFrameChanged(d->currentFrame);
-    emit progressChanged(progress());
-    emit loaded();
-    update();
-    return true;
+void FluentLottieWidget::setModelCacheLimit(qint64 bytes)
+{
+    LottieModelRegistry::instance().setRetainLimit(bytes);
+}
+
+qint64 FluentLottieWidget::modelCacheLimit()
+{
+    return LottieModelRegistry::instance().retainLimit();
 }
 
 bool FluentLottieWidget::isLoaded() const
@@ -924,6 +1237,37 @@ void FluentLottieWidget::syncAnimationMetadata()
     }
 }
 
+bool FluentLottieWidget::finishLoad(const QString &failureMessage)
+{
+    d->loading = false;
+    if (!d->animation) {
+        d->animationSize = {};
+        d->totalFrames = 0;
+        d->markers.clear();
+        d->currentFrame = 0;
+        d->playbackRequested = false;
+        d->playing = false;
+        d->timer->stop();
+        clearRenderCache();
+        setError(failureMessage);
+        update();
+        return false;
+    }
+
+    d->errorString.clear();
+    d->segmentActive = false;
+    d->currentFrame = 0;
+    syncAnimationMetadata();
+    syncTimerState();
+    clearRenderCache();
+
+    emit currentFrameChanged(d->currentFrame);
+    emit progressChanged(progress());
+    emit loaded();
+    update();
+    return true;
+}
+
 void FluentLottieWidget::setError(const QString &error)
 {
     d->errorString = error;
@@ -1,5 +1,6 @@
 ﻿#include "Fluent/FluentMainWindow.h"
 
+#include "Fluent/FluentDiagnostics.h"
 #include "Fluent/FluentFramePainter.h"
 #include "Fluent/FluentMenuBar.h"
 #include "Fluent/FluentResizeHelper.h"
@@ -8,6 +9,8 @@
 #include "Fluent/FluentTheme.h"
 #include "Fluent/FluentToolBar.h"
 #include "Fluent/FluentToolButton.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentPageTransition_p.h"
 
 #include <QAbstractButton>
 #include <QActionEvent>
@@ -17,6 +20,7 @@
 #include <QEvent>
 #include <QHBoxLayout>
 #include <QLabel>
+#include <QLoggingCategory>
 #include <QMenu>
 #include <QMenuBar>
 #include <QMouseEvent>
@@ -530,14 +534,9 @@ FluentMainWindow::FluentMainWindow(QWidget *parent)
     m_frameHost = new WindowFrameHost(this);
     m_frameHost->setObjectName("FluentMainWindowFrameHost");
 
-    // Create the border overlay as a direct child of the MainWindow so it
-    // covers the ENTIRE content area (title bar + central widget).
-    m_borderOverlay = new WindowBorderOverlay(this);
-    m_borderOverlay->setObjectName("FluentMainWindowBorderOverlay");
-    if (auto *overlay = dynamic_cast<WindowBorderOverlay *>(m_borderOverlay)) {
-        overlay->setBorderEffect(&m_border);
-    }
-
+    // The title bar, the border overlay and the resize helper are created on
+    // first show (ensureTitleBar / ensureWindowChrome), so a window that is
+    // built but not yet shown costs no extra widgets or event filters.
     m_border.syncFromTheme();
     m_border.setRequestUpdate([this]() {
         updateFrameHost();
@@ -750,6 +749,17 @@ void FluentMainWindow::setCentralWidget(QWidget *widget)
     }
 
     QWidget *oldWidget = m_userCentralWidget;
+
+    // Snapshot the outgoing content while it is still laid out and visible.
+    QPixmap outgoing;
+    QRect contentRect;
+    const bool animate = m_contentTransition != FluentPageTransition::None && isVisible() && oldWidget
+        && widget && oldWidget->isVisible() && FluentMotion::duration(FluentMotionRole::Page) > 0;
+    if (animate) {
+        outgoing = oldWidget->grab();
+        contentRect = oldWidget->geometry();
+    }
+
     while (layout->count() > 0) {
         QLayoutItem *it = layout->takeAt(0);
         if (it) {
@@ -775,6 +785,35 @@ void FluentMainWindow::setCentralWidget(QWidget *widget)
 
 
     updateFrameHost();
+
+    if (animate) {
+        layout->activate();
+        if (!m_contentTransitionOverlay) {
+            m_contentTransitionOverlay = new FluentPageTransitionOverlay(m_frameHost);
+        }
+        const QRect targetRect = widget->geometry().isEmpty() ? contentRect : widget->geometry();
+        m_contentTransitionOverlay->start(m_contentTransition,
+                                          targetRect,
+                                          FluentPageTransitionOverlay::grabBackdrop(m_frameHost, targetRect),
+                                          outgoing,
+                                          widget->grab(),
+                                          true);
+    } else if (m_contentTransitionOverlay) {
+        m_contentTransitionOverlay->finish();
+    }
+}
+
+void FluentMainWindow::setContentTransition(FluentPageTransition transition)
+{
+    m_contentTransition = transition;
+    if (transition == FluentPageTransition::None && m_contentTransitionOverlay) {
+        m_contentTransitionOverlay->finish();
+    }
+}
+
+FluentPageTransition FluentMainWindow::contentTransition() const
+{
+    return m_contentTransition;
 }
 
 void FluentMainWindow::setFluentTitleBarTitle(const QString &title)
@@ -1297,10 +1336,10 @@ void FluentMainWindow::setFluentMenuBar(FluentMenuBar *menuBar)
     qint64 last = 0;
     auto mark = [&](const QString &step) {
         const qint64 now = timer.elapsed();
-        qInfo().noquote() << QStringLiteral("[DemoStartup] FluentMainWindow::setFluentMenuBar %1 +%2 ms, total %3 ms")
-                                 .arg(step)
-                                 .arg(now - last)
-                                 .arg(now);
+        qCInfo(Diagnostics::startupLog).noquote() << QStringLiteral("[Startup] FluentMainWindow::setFluentMenuBar %1 +%2 ms, total %3 ms")
+                                                         .arg(step)
+                                                         .arg(now - last)
+                                                         .arg(now);
         last = now;
     };
 
@@ -1369,6 +1408,9 @@ void FluentMainWindow::changeEvent(QEvent *event)
 
 void FluentMainWindow::resizeEvent(QResizeEvent *event)
 {
+    if (m_contentTransitionOverlay) {
+        m_contentTransitionOverlay->finish();
+    }
     QMainWindow::resizeEvent(event);
     updateTitleBarContent();
 
@@ -1380,6 +1422,7 @@ void FluentMainWindow::showEvent(QShowEvent *event)
     QMainWindow::showEvent(event);
     adoptNativeMenuBarIfNeeded();
     ensureTitleBar();
+    ensureWindowChrome();
 
     // Allow painting after the first event loop cycle.
     if (!property("_fluentPaintReady").toBool()) {
@@ -1721,21 +1764,23 @@ bool FluentMainWindow::nativeEvent(const QByteArray &eventType, void *message, l
 
 void FluentMainWindow::applyThemeToApplication()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     QElapsedTimer timer;
     timer.start();
     qint64 last = 0;
     auto mark = [&](const QString &step) {
         const qint64 now = timer.elapsed();
-        qInfo().noquote() << QStringLiteral("[ThemeSwitch] FluentMainWindow::applyThemeToApplication %1 +%2 ms, total %3 ms")
-                                 .arg(step)
-                                 .arg(now - last)
-                                 .arg(now);
+        qCInfo(Diagnostics::themeSwitchLog).noquote() << QStringLiteral("[ThemeSwitch] FluentMainWindow::applyThemeToApplication %1 +%2 ms, total %3 ms")
+                                                             .arg(step)
+                                                             .arg(now - last)
+                                                             .arg(now);
         last = now;
     };
 
-    qInfo().noquote() << QStringLiteral("[ThemeSwitch] FluentMainWindow::applyThemeToApplication begin visible=%1, windowTitle=\"%2\"")
-                             .arg(isVisible() ? QStringLiteral("true") : QStringLiteral("false"))
-                             .arg(windowTitle());
+    qCInfo(Diagnostics::themeSwitchLog).noquote() << QStringLiteral("[ThemeSwitch] FluentMainWindow::applyThemeToApplication begin visible=%1, windowTitle=\"%2\"")
+                                                         .arg(isVisible() ? QStringLiteral("true") : QStringLiteral("false"))
+                                                         .arg(windowTitle());
 
     // Keep border + trace animation in sync with theme.
     if (isVisible()) {
@@ -1757,23 +1802,23 @@ void FluentMainWindow::applyThemeToApplication()
             paletteTimer.start();
             applyApplicationPalette(app, colors);
             s_lastApplicationPaletteSignature = paletteSignature;
-            qInfo().noquote() << QStringLiteral("[ThemeSwitch] QApplication::setPalette +%1 ms")
-                                     .arg(paletteTimer.elapsed());
+            qCInfo(Diagnostics::themeSwitchLog).noquote() << QStringLiteral("[ThemeSwitch] QApplication::setPalette +%1 ms")
+                                                                 .arg(paletteTimer.elapsed());
             mark(QStringLiteral("application palette"));
 
             QElapsedTimer polishTimer;
             polishTimer.start();
             const int polished = refreshPaletteDrivenStyleSheets(this);
-            qInfo().noquote() << QStringLiteral("[ThemeSwitch] palette-driven stylesheet polish %1 widgets +%2 ms")
-                                     .arg(polished)
-                                     .arg(polishTimer.elapsed());
+            qCInfo(Diagnostics::themeSwitchLog).noquote() << QStringLiteral("[ThemeSwitch] palette-driven stylesheet polish %1 widgets +%2 ms")
+                                                                 .arg(polished)
+                                                                 .arg(polishTimer.elapsed());
             mark(QStringLiteral("palette-driven stylesheet polish"));
         }
 
         static QString s_lastApplicationStyleSignature;
         const QString styleSignature = applicationStyleSignature(colors);
         if (s_lastApplicationStyleSignature == styleSignature) {
-            qInfo().noquote() << QStringLiteral("[ThemeSwitch] QApplication::setStyleSheet skipped, base signature unchanged");
+            qCInfo(Diagnostics::themeSwitchLog).noquote() << QStringLiteral("[ThemeSwitch] QApplication::setStyleSheet skipped, base signature unchanged");
             mark(QStringLiteral("base stylesheet skipped"));
         } else {
             const QString next = Theme::baseStyleSheet(colors);
@@ -1783,11 +1828,11 @@ void FluentMainWindow::applyThemeToApplication()
                 styleTimer.start();
                 app->setStyleSheet(next);
                 s_lastApplicationStyleSignature = styleSignature;
-                qInfo().noquote() << QStringLiteral("[ThemeSwitch] QApplication::setStyleSheet +%1 ms")
-                                         .arg(styleTimer.elapsed());
+                qCInfo(Diagnostics::themeSwitchLog).noquote() << QStringLiteral("[ThemeSwitch] QApplication::setStyleSheet +%1 ms")
+                                                                     .arg(styleTimer.elapsed());
             } else {
                 s_lastApplicationStyleSignature = styleSignature;
-                qInfo().noquote() << QStringLiteral("[ThemeSwitch] QApplication::setStyleSheet skipped, unchanged");
+                qCInfo(Diagnostics::themeSwitchLog).noquote() << QStringLiteral("[ThemeSwitch] QApplication::setStyleSheet skipped, unchanged");
             }
         }
     }
@@ -1807,8 +1852,26 @@ void FluentMainWindow::applyThemeToApplication()
     mark(QStringLiteral("DWM attributes"));
 #endif
 
-    qInfo().noquote() << QStringLiteral("[ThemeSwitch] FluentMainWindow::applyThemeToApplication done at %1 ms")
-                             .arg(timer.elapsed());
+    qCInfo(Diagnostics::themeSwitchLog).noquote() << QStringLiteral("[ThemeSwitch] FluentMainWindow::applyThemeToApplication done at %1 ms")
+                                                         .arg(timer.elapsed());
+}
+
+void FluentMainWindow::ensureWindowChrome()
+{
+    if (m_borderOverlay) {
+        return;
+    }
+
+    // A direct child of the MainWindow so it covers the ENTIRE content area
+    // (title bar + central widget). Children created inside showEvent are not
+    // shown along with the window, hence the explicit show().
+    auto *overlay = new WindowBorderOverlay(this);
+    overlay->setObjectName("FluentMainWindowBorderOverlay");
+    overlay->setBorderEffect(&m_border);
+    m_borderOverlay = overlay;
+    m_borderOverlay->show();
+
+    updateResizeHelperState();
 }
 
 void FluentMainWindow::ensureTitleBar()
@@ -1822,10 +1885,10 @@ void FluentMainWindow::ensureTitleBar()
     qint64 last = 0;
     auto mark = [&](const QString &step) {
         const qint64 now = timer.elapsed();
-        qInfo().noquote() << QStringLiteral("[DemoStartup] FluentMainWindow::ensureTitleBar %1 +%2 ms, total %3 ms")
-                                 .arg(step)
-                                 .arg(now - last)
-                                 .arg(now);
+        qCInfo(Diagnostics::startupLog).noquote() << QStringLiteral("[Startup] FluentMainWindow::ensureTitleBar %1 +%2 ms, total %3 ms")
+                                                         .arg(step)
+                                                         .arg(now - last)
+                                                         .arg(now);
         last = now;
     };
 
@@ -2017,8 +2080,8 @@ void FluentMainWindow::updateTitleBarContent()
     };
     auto flushSlowTrace = [&]() {
         if (traceTimer.elapsed() >= 20) {
-            qInfo().noquote() << QStringLiteral("[DemoStartup] FluentMainWindow::updateTitleBarContent slow: %1")
-                                     .arg(traceParts.join(QStringLiteral(" | ")));
+            qCInfo(Diagnostics::startupLog).noquote() << QStringLiteral("[Startup] FluentMainWindow::updateTitleBarContent slow: %1")
+                                                             .arg(traceParts.join(QStringLiteral(" | ")));
         }
     };
 
@@ -2207,6 +2270,10 @@ void FluentMainWindow::updateResizeHelperState()
 
     if (shouldEnable) {
         if (!m_resizeHelper) {
+            if (!m_borderOverlay) {
+                // Not shown yet; ensureWindowChrome() comes back here.
+                return;
+            }
             m_resizeHelper = new FluentResizeHelper(this);
         }
         m_resizeHelper->setBorderWidth(effectiveResizeBorderWidth());
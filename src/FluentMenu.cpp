@@ -5,6 +5,7 @@
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
 #include "FluentMenuPopupHost.h"
+#include "FluentDiagnostics_p.h"
 
 #include <QApplication>
 #include <QAction>
@@ -517,6 +518,8 @@ void FluentMenu::ensureSubMenusFluent()
 
 void FluentMenu::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const auto &tokens = ThemeManager::instance().tokens();
     const auto &colors = tokens.legacyColors;
     if ((m_popupFadeAnim || m_popupSlideAnim) && FluentMotion::duration(FluentMotionRole::PopupOpen) <= 0) {
@@ -547,9 +550,7 @@ void FluentMenu::applyTheme()
                  colors.disabledText.name(QColor::HexArgb),
                  menuSeparatorColor(tokens).name(QColor::HexArgb));
 
-    if (styleSheet() != next) {
-        setStyleSheet(next);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(this, next);
 
     update();
 }
@@ -5,6 +5,8 @@
 #include "Fluent/FluentTheme.h"
 #include "Fluent/FluentMenu.h"
 #include "FluentMenuPopupHost.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QAbstractAnimation>
 #include <QActionEvent>
@@ -156,7 +158,7 @@ FluentMenuBar::FluentMenuBar(QWidget *parent)
     });
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentMenuBar::applyTheme);
+    ThemeRegistry::enroll<&FluentMenuBar::applyTheme>(this);
 }
 
 void FluentMenuBar::childEvent(QChildEvent *event)
@@ -231,6 +233,8 @@ void FluentMenuBar::actionEvent(QActionEvent *event)
 
 void FluentMenuBar::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool highlightRunning = m_highlightAnim
         && m_highlightAnim->state() == QAbstractAnimation::Running;
@@ -3,6 +3,7 @@
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
 #include "Fluent/FluentButton.h"
+#include "FluentDiagnostics_p.h"
 
 #include <QGridLayout>
 #include <QHBoxLayout>
@@ -882,6 +883,8 @@ bool FluentMessageBox::eventFilter(QObject *watched, QEvent *event)
 
 void FluentMessageBox::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     if (isVisible()) {
         m_border.onThemeChanged();
     } else {
@@ -907,37 +910,27 @@ void FluentMessageBox::applyTheme()
     m_titleLabel->setFont(titleFont);
     const auto tokens = ThemeManager::instance().tokens();
     const QString titleStyle = QStringLiteral("color: %1;").arg(colors.text.name(QColor::HexArgb));
-    if (m_titleLabel->styleSheet() != titleStyle) {
-        m_titleLabel->setStyleSheet(titleStyle);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(m_titleLabel, titleStyle);
 
     const QString messageStyle = QStringLiteral("color: %1;").arg(colors.text.name(QColor::HexArgb));
-    if (m_messageLabel->styleSheet() != messageStyle) {
-        m_messageLabel->setStyleSheet(messageStyle);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(m_messageLabel, messageStyle);
 
     if (m_detailEdit) {
         // Subdued body color; no border/background (Fluent dialogs don't box the body).
         const QString detailStyle = QStringLiteral("color: %1;").arg(colors.subText.name(QColor::HexArgb));
-        if (m_detailEdit->styleSheet() != detailStyle) {
-            m_detailEdit->setStyleSheet(detailStyle);
-        }
+        ThemeProfiler::setStyleSheetIfChanged(m_detailEdit, detailStyle);
     }
 
     if (m_divider) {
         const QString dividerStyle = QStringLiteral("background: %1;")
             .arg(tokens.neutral.strokeSubtle.name(QColor::HexArgb));
-        if (m_divider->styleSheet() != dividerStyle) {
-            m_divider->setStyleSheet(dividerStyle);
-        }
+        ThemeProfiler::setStyleSheetIfChanged(m_divider, dividerStyle);
     }
 
     if (m_linkLabel) {
         // Base stylesheet already styles #FluentLink, but keep explicit for dialogs.
         const QString linkStyle = QStringLiteral("color: %1;").arg(tokens.accent.base.name(QColor::HexArgb));
-        if (m_linkLabel->styleSheet() != linkStyle) {
-            m_linkLabel->setStyleSheet(linkStyle);
-        }
+        ThemeProfiler::setStyleSheetIfChanged(m_linkLabel, linkStyle);
     }
 
     // Icon
@@ -15,10 +15,13 @@
 #include <QPainter>
 #include <QPainterPath>
 #include <QPointer>
+#include <QPixmap>
 #include <QResizeEvent>
 #include <QSet>
+#include <QStaticText>
 #include <QVariantAnimation>
 #include <QWheelEvent>
+#include <QtMath>
 
 #include <algorithm>
 #include <cmath>
@@ -93,6 +96,51 @@ QIcon fallbackIconForItem(const FluentNavigationItem &item)
     return QIcon();
 }
 
+bool hasChildItems(const FluentNavigationItem &item)
+{
+    return !item.children.empty() || item.hasLazyChildren;
+}
+
+void paintStaticItemIcon(QPainter &p,
+                         const QRectF &iconRect,
+                         const FluentNavigationItem &item,
+                         const QColor &color,
+                         bool enabled,
+                         const QFont &baseFont)
+{
+    if (item.hasFluentIcon) {
+        FluentIconOptions options;
+        options.color = color;
+        FluentIcon::paintIcon(&p, item.fluentIcon, iconRect, options);
+    } else if (!item.iconGlyph.isEmpty()) {
+        QFont iconFont = baseFont;
+        iconFont.setFamily(item.iconFontFamily.isEmpty() ? defaultGlyphFontFamily() : item.iconFontFamily);
+        iconFont.setPixelSize(kIconSize);
+        iconFont.setStyleStrategy(QFont::PreferAntialias);
+
+        p.save();
+        p.setFont(iconFont);
+        p.setPen(color);
+        p.drawText(iconRect, Qt::AlignCenter, item.iconGlyph);
+        p.restore();
+    } else if (!item.icon.isNull()) {
+        item.icon.paint(&p,
+                        QRect(static_cast<int>(iconRect.left()),
+                              static_cast<int>(iconRect.top()),
+                              static_cast<int>(iconRect.width()),
+                              static_cast<int>(iconRect.height())),
+                        Qt::AlignCenter,
+                        enabled ? QIcon::Normal : QIcon::Disabled);
+    }
+}
+
+QFont navigationLabelFont(const QFont &baseFont)
+{
+    QFont textFont = baseFont;
+    textFont.setPixelSize(14);
+    return textFont;
+}
+
 QString animatedIconFingerprint(const FluentNavigationItem &item)
 {
     if (!item.animatedIconData.isEmpty()) {
@@ -227,6 +275,8 @@ struct FluentNavigationView::Private
     QWidget *observedParent = nullptr;
     QPointer<FluentMenu> itemFlyout;
     QString itemFlyoutParentKey;
+    QPoint itemFlyoutPos;
+    bool itemFlyoutOpen = false;
     QHash<QString, QPointer<FluentAnimatedIcon>> animatedIconWidgets;
     QHash<QString, QString> animatedIconFingerprints;
     QSet<QString> animatedIconActiveKeys;
@@ -252,6 +302,27 @@ struct FluentNavigationView::Private
     bool footerVisible = true;
     QString paneTitle;
 
+    // --- Per-item render cache -------------------------------------------
+    // Elided labels and rasterized static icons survive across paints (hover,
+    // selection and pane width frames). Entries are keyed by item address, so
+    // every mutation of items / footerItems must call clearRenderCache().
+    struct LabelCache {
+        QString source;
+        int width = -1;
+        QStaticText text;
+    };
+    struct IconCache {
+        QRgb color = 0;
+        qreal dpr = 0.0;
+        bool enabled = true;
+        QPixmap pixmap;
+    };
+    QHash<const FluentNavigationItem *, LabelCache> labelCache;
+    QHash<const FluentNavigationItem *, IconCache> iconCache;
+    LabelCache paneTitleCache;
+
+    FluentNavigationView::ChildrenProvider childrenProvider;
+
     // --- Vertical scrolling (Left / LeftCompact modes) -------------------
     int scrollOffset = 0;        // pixels scrolled from top of scrollable area
     bool scrollHover = false;    // cursor over the scrollbar track/thumb
@@ -274,6 +345,126 @@ struct FluentNavigationView::Private
         return std::find(expandedGroups.begin(), expandedGroups.end(), key) != expandedGroups.end();
     }
 
+    void clearRenderCache()
+    {
+        labelCache.clear();
+        iconCache.clear();
+        paneTitleCache = LabelCache();
+    }
+
+    static const QStaticText &cachedLabel(LabelCache &cache, const QString &source, int width, const QFont &font)
+    {
+        if (cache.width != width || cache.source != source) {
+            const QFontMetrics fm(font);
+            cache.source = source;
+            cache.width = width;
+            cache.text = QStaticText(fm.elidedText(source, Qt::ElideRight, width));
+            cache.text.setTextFormat(Qt::PlainText);
+            cache.text.setPerformanceHint(QStaticText::AggressiveCaching);
+            cache.text.prepare(QTransform(), font);
+        }
+        return cache.text;
+    }
+
+    const QPixmap &cachedItemIcon(const FluentNavigationItem &item,
+                                  const QColor &color,
+                                  bool enabled,
+                                  qreal dpr,
+                                  const QFont &baseFont)
+    {
+        IconCache &cache = iconCache[&item];
+        if (cache.pixmap.isNull() || cache.color != color.rgba() || cache.enabled != enabled
+            || !qFuzzyCompare(cache.dpr, dpr)) {
+            cache.color = color.rgba();
+            cache.enabled = enabled;
+            cache.dpr = dpr;
+            const int side = qCeil(kIconSize * dpr);
+            cache.pixmap = QPixmap(side, side);
+            cache.pixmap.setDevicePixelRatio(dpr);
+            cache.pixmap.fill(Qt::transparent);
+            QPainter ip(&cache.pixmap);
+            ip.setRenderHint(QPainter::Antialiasing, true);
+            ip.setRenderHint(QPainter::SmoothPixmapTransform, true);
+            paintStaticItemIcon(ip, QRectF(0, 0, kIconSize, kIconSize), item, color, enabled, baseFont);
+        }
+        return cache.pixmap;
+    }
+
+    // Locates the sibling vector holding key (items or footerItems, at any
+    // depth of the materialized tree).
+    std::vector<FluentNavigationItem> *findSiblings(const QString &key, int *index)
+    {
+        if (key.isEmpty()) {
+            return nullptr;
+        }
+
+        std::function<std::vector<FluentNavigationItem> *(std::vector<FluentNavigationItem> &)> find;
+        find = [&](std::vector<FluentNavigationItem> &source) -> std::vector<FluentNavigationItem> * {
+            for (int i = 0; i < static_cast<int>(source.size()); ++i) {
+                auto &item = source[static_cast<size_t>(i)];
+                if (item.key == key) {
+                    if (index) {
+                        *index = i;
+                    }
+                    return &source;
+                }
+                if (auto *found = find(item.children)) {
+                    return found;
+                }
+            }
+            return nullptr;
+        };
+
+        if (auto *found = find(items)) {
+            return found;
+        }
+        return find(footerItems);
+    }
+
+    FluentNavigationItem *findItem(const QString &key)
+    {
+        int index = -1;
+        auto *siblings = findSiblings(key, &index);
+        return siblings ? &(*siblings)[static_cast<size_t>(index)] : nullptr;
+    }
+
+    // Whether key is item itself or one of its materialized descendants.
+    static bool subtreeContains(const FluentNavigationItem &item, const QString &key)
+    {
+        if (item.key == key) {
+            return true;
+        }
+        for (const auto &child : item.children) {
+            if (subtreeContains(child, key)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool materializeChildren(FluentNavigationItem &item)
+    {
+        if (!item.hasLazyChildren || !childrenProvider) {
+            return false;
+        }
+
+        item.hasLazyChildren = false;
+        item.children = childrenProvider(item.key);
+        return true;
+    }
+
+    void releaseAnimatedIcons(const FluentNavigationItem &item)
+    {
+        if (auto icon = animatedIconWidgets.take(item.key)) {
+            icon->deleteLater();
+        }
+        animatedIconFingerprints.remove(item.key);
+        animatedIconActiveKeys.remove(item.key);
+        for (const auto &child : item.children) {
+            releaseAnimatedIcons(child);
+        }
+    }
+
     void closeItemFlyout()
     {
         if (itemFlyout) {
@@ -282,11 +473,15 @@ struct FluentNavigationView::Private
             itemFlyout = nullptr;
         }
         itemFlyoutParentKey.clear();
+        itemFlyoutOpen = false;
     }
 
     void setGroupExpanded(const QString &key, bool expanded, bool exclusive = true)
     {
         if (expanded) {
+            if (auto *item = findItem(key)) {
+                materializeChildren(*item);
+            }
             if (exclusive) {
                 expandedGroups.clear();
             }
@@ -328,7 +523,7 @@ struct FluentNavigationView::Private
                 row.isFooter = footer;
                 row.depth = depth;
                 row.item = &item;
-                row.isExpander = !item.children.empty();
+                row.isExpander = hasChildItems(item);
                 row.expanded = row.isExpander && isGroupExpanded(item.key);
                 rows.push_back(row);
 
@@ -683,7 +878,7 @@ struct FluentNavigationView::Private
         }
 
         width += fm.horizontalAdvance(item.text);
-        if (!item.children.empty()) {
+        if (hasChildItems(item)) {
             width += 18;
         }
 
@@ -965,7 +1160,7 @@ struct FluentNavigationView::Private
                 continue;
             }
 
-            if (!child.children.empty()) {
+            if (hasChildItems(child)) {
                 FluentMenu *sub = menu->addFluentMenu(child.text);
                 if (!child.icon.isNull()) {
                     sub->menuAction()->setIcon(child.icon);
@@ -983,7 +1178,21 @@ struct FluentNavigationView::Private
                         });
                 }
 
-                populateFlyoutChildren(owner, sub, child.children);
+                if (child.hasLazyChildren) {
+                    // Nested lazy groups are materialized when their submenu opens.
+                    QObject::connect(sub, &QMenu::aboutToShow, owner,
+                        [owner, this, sub, childKey = child.key]() {
+                            if (!sub->isEmpty()) {
+                                return;
+                            }
+                            FluentNavigationItem *lazy = findItem(childKey);
+                            if (lazy && materializeChildren(*lazy)) {
+                                populateFlyoutChildren(owner, sub, lazy->children);
+                            }
+                        });
+                } else {
+                    populateFlyoutChildren(owner, sub, child.children);
+                }
                 continue;
             }
 
@@ -1015,7 +1224,15 @@ struct FluentNavigationView::Private
 
     void showItemFlyout(FluentNavigationView *owner, const FluentNavigationItem *item, const QPoint &popupPos)
     {
-        if (!owner || !item || item->children.empty()) {
+        if (!owner || !item) {
+            return;
+        }
+        if (item->hasLazyChildren) {
+            if (FluentNavigationItem *lazy = findItem(item->key)) {
+                materializeChildren(*lazy);
+            }
+        }
+        if (item->children.empty()) {
             return;
         }
 
@@ -1030,6 +1247,13 @@ struct FluentNavigationView::Private
         menu->setAttribute(Qt::WA_DeleteOnClose, true);
         itemFlyout = menu;
         itemFlyoutParentKey = item->key;
+        itemFlyoutPos = popupPos;
+        itemFlyoutOpen = true;
+        QObject::connect(menu, &QMenu::aboutToHide, owner, [this, menu]() {
+            if (itemFlyout == menu) {
+                itemFlyoutOpen = false;
+            }
+        });
 
         populateFlyoutChildren(owner, menu, item->children);
 
@@ -1084,24 +1308,34 @@ void FluentNavigationView::Private::syncAnimatedItemIcon(FluentNavigationView *o
         icon->setInteractive(false);
         icon->setFallbackIconSize(QSize(kIconSize, kIconSize));
         icon->setFallbackIcon(fallbackIconForItem(item));
+        // Sources parse on a worker thread; the static glyph stays painted
+        // until the model arrives, then the next paint shows the icon.
+        QObject::connect(icon, &FluentLottieWidget::loaded, owner, [owner]() { owner->update(); });
+        QObject::connect(icon, &FluentLottieWidget::loadFailed, owner, [this, owner, key]() {
+            animatedIconActiveKeys.remove(key);
+            owner->update();
+        });
         animatedIconWidgets.insert(key, icon);
     }
 
     const QString fingerprint = animatedIconFingerprint(item);
-    if (animatedIconFingerprints.value(key) != fingerprint || !icon->isLoaded()) {
+    if (animatedIconFingerprints.value(key) != fingerprint) {
+        // A source that failed stays on the static icon until it changes.
         icon->setFallbackIcon(fallbackIconForItem(item));
-        const bool ok = item.animatedIconData.isEmpty()
-                            ? icon->load(item.animatedIconSource)
-                            : icon->loadData(item.animatedIconData,
-                                             item.animatedIconCacheKey.isEmpty() ? key : item.animatedIconCacheKey,
-                                             item.animatedIconResourcePath);
-        if (!ok) {
-            icon->hide();
-            animatedIconActiveKeys.remove(key);
-            return;
-        }
         animatedIconFingerprints.insert(key, fingerprint);
-        icon->setCurrentFrame(0);
+        if (item.animatedIconData.isEmpty()) {
+            icon->loadAsync(item.animatedIconSource);
+        } else {
+            icon->loadDataAsync(item.animatedIconData,
+                                item.animatedIconCacheKey.isEmpty() ? key : item.animatedIconCacheKey,
+                                item.animatedIconResourcePath);
+        }
+    }
+
+    if (icon->isLoading() || !icon->isLoaded()) {
+        icon->hide();
+        animatedIconActiveKeys.remove(key);
+        return;
     }
 
     const QRect alignedIconRect = iconRect.toAlignedRect();
@@ -1414,6 +1648,7 @@ FluentNavigationView::FluentNavigationView(QWidget *parent)
             d->selStartRect = d->selRect;
             d->selOpacity = 1.0;
         }
+        d->iconCache.clear();
         update();
     });
 
@@ -1426,6 +1661,7 @@ FluentNavigationView::~FluentNavigationView() = default;
 void FluentNavigationView::setItems(const std::vector<FluentNavigationItem> &items)
 {
     d->items = items;
+    d->clearRenderCache();
     d->ensureKeyVisible(d->selectedKey);
     d->rebuildRows();
     d->scrollKeyIntoView(d->selectedKey, height());
@@ -1444,6 +1680,7 @@ std::vector<FluentNavigationItem> FluentNavigationView::items() const
 void FluentNavigationView::addItem(const FluentNavigationItem &item)
 {
     d->items.push_back(item);
+    d->clearRenderCache();
     d->ensureKeyVisible(d->selectedKey);
     d->rebuildRows();
     d->scrollKeyIntoView(d->selectedKey, height());
@@ -1457,6 +1694,7 @@ void FluentNavigationView::addItem(const FluentNavigationItem &item)
 void FluentNavigationView::clearItems()
 {
     d->items.clear();
+    d->clearRenderCache();
     d->expandedGroups.clear();
     d->rebuildRows();
     d->selRect = QRectF();
@@ -1469,6 +1707,7 @@ void FluentNavigationView::clearItems()
 void FluentNavigationView::setFooterItems(const std::vector<FluentNavigationItem> &items)
 {
     d->footerItems = items;
+    d->clearRenderCache();
     d->rebuildRows();
     d->scrollKeyIntoView(d->selectedKey, height());
     d->selRect = d->selectionRectForKey(d->selectedKey, width(), height());
@@ -1486,6 +1725,7 @@ std::vector<FluentNavigationItem> FluentNavigationView::footerItems() const
 void FluentNavigationView::addFooterItem(const FluentNavigationItem &item)
 {
     d->footerItems.push_back(item);
+    d->clearRenderCache();
     d->rebuildRows();
     d->scrollKeyIntoView(d->selectedKey, height());
     d->selRect = d->selectionRectForKey(d->selectedKey, width(), height());
@@ -1498,6 +1738,7 @@ void FluentNavigationView::addFooterItem(const FluentNavigationItem &item)
 void FluentNavigationView::clearFooterItems()
 {
     d->footerItems.clear();
+    d->clearRenderCache();
     d->rebuildRows();
     d->scrollKeyIntoView(d->selectedKey, height());
     d->selRect = d->selectionRectForKey(d->selectedKey, width(), height());
@@ -1507,6 +1748,147 @@ void FluentNavigationView::clearFooterItems()
     update();
 }
 
+bool FluentNavigationView::insertItem(const QString &parentKey, int index, const FluentNavigationItem &item)
+{
+    std::vector<FluentNavigationItem> *siblings = &d->items;
+    if (!parentKey.isEmpty()) {
+        FluentNavigationItem *parent = d->findItem(parentKey);
+        if (!parent) {
+            return false;
+        }
+        // Inserting into a group the provider has not served yet would be
+        // overwritten on first expansion; materialize it first.
+        d->materializeChildren(*parent);
+        parent->hasLazyChildren = false;
+        siblings = &parent->children;
+    }
+
+    const int count = static_cast<int>(siblings->size());
+    const int position = (index < 0 || index > count) ? count : index;
+    siblings->insert(siblings->begin() + position, item);
+
+    d->clearRenderCache();
+    d->rebuildRows();
+    d->selRect = d->selectionRectForKey(d->selectedKey, width(), height());
+    d->selStartRect = d->selRect;
+    d->selTargetRect = d->selRect;
+    updateGeometry();
+    update();
+    return true;
+}
+
+bool FluentNavigationView::removeItem(const QString &key)
+{
+    int index = -1;
+    std::vector<FluentNavigationItem> *siblings = d->findSiblings(key, &index);
+    if (!siblings) {
+        return false;
+    }
+
+    const bool removesSelection = !d->selectedKey.isEmpty()
+        && Private::subtreeContains((*siblings)[static_cast<size_t>(index)], d->selectedKey);
+
+    d->closeItemFlyout();
+    d->releaseAnimatedIcons((*siblings)[static_cast<size_t>(index)]);
+    siblings->erase(siblings->begin() + index);
+    if (removesSelection) {
+        d->selAnim->stop();
+        d->selectedKey.clear();
+    }
+
+    d->clearRenderCache();
+    d->rebuildRows();
+    d->clampScrollOffset(height());
+    d->selRect = d->selectionRectForKey(d->selectedKey, width(), height());
+    d->selStartRect = d->selRect;
+    d->selTargetRect = d->selRect;
+    updateGeometry();
+    if (removesSelection) {
+        emit selectedKeyChanged(QString());
+    }
+    update();
+    return true;
+}
+
+bool FluentNavigationView::setItemText(const QString &key, const QString &text)
+{
+    FluentNavigationItem *item = d->findItem(key);
+    if (!item) {
+        return false;
+    }
+    if (item->text == text) {
+        return true;
+    }
+
+    // Row structure is unchanged; only the cached label of this item is stale.
+    item->text = text;
+    d->labelCache.remove(item);
+    if (d->displayMode == Top) {
+        updateGeometry();
+    }
+
+    // An open flyout lists the item under its own action; reopen it in place
+    // so the menu is rebuilt and resized for the new text.
+    if (d->itemFlyout && d->itemFlyoutOpen && d->itemFlyoutParentKey != key) {
+        const FluentNavigationItem *flyoutParent = d->findItem(d->itemFlyoutParentKey);
+        if (flyoutParent && Private::subtreeContains(*flyoutParent, key)) {
+            const QPoint popupPos = d->itemFlyoutPos;
+            d->closeItemFlyout();
+            d->showItemFlyout(this, flyoutParent, popupPos);
+        }
+    }
+    update();
+    return true;
+}
+
+bool FluentNavigationView::setItemChildren(const QString &parentKey, const std::vector<FluentNavigationItem> &children)
+{
+    FluentNavigationItem *parent = d->findItem(parentKey);
+    if (!parent) {
+        return false;
+    }
+
+    bool removesSelection = false;
+    if (!d->selectedKey.isEmpty() && parent->key != d->selectedKey) {
+        auto holdsSelection = [this](const std::vector<FluentNavigationItem> &list) {
+            return std::any_of(list.cbegin(), list.cend(), [this](const FluentNavigationItem &child) {
+                return Private::subtreeContains(child, d->selectedKey);
+            });
+        };
+        removesSelection = holdsSelection(parent->children) && !holdsSelection(children);
+    }
+
+    d->closeItemFlyout();
+    for (const auto &child : parent->children) {
+        d->releaseAnimatedIcons(child);
+    }
+    parent->children = children;
+    parent->hasLazyChildren = false;
+    if (removesSelection) {
+        d->selAnim->stop();
+        d->selectedKey.clear();
+    }
+
+    d->clearRenderCache();
+    d->ensureKeyVisible(d->selectedKey);
+    d->rebuildRows();
+    d->clampScrollOffset(height());
+    d->selRect = d->selectionRectForKey(d->selectedKey, width(), height());
+    d->selStartRect = d->selRect;
+    d->selTargetRect = d->selRect;
+    updateGeometry();
+    if (removesSelection) {
+        emit selectedKeyChanged(QString());
+    }
+    update();
+    return true;
+}
+
+void FluentNavigationView::setChildrenProvider(ChildrenProvider provider)
+{
+    d->childrenProvider = std::move(provider);
+}
+
 QString FluentNavigationView::selectedKey() const
 {
     return d->selectedKey;
@@ -1968,36 +2350,22 @@ void FluentNavigationView::paintEvent(QPaintEvent * /*event*/)
                               iconOptions(secondaryText));
     };
 
+    const qreal dpr = qMax<qreal>(1.0, devicePixelRatioF());
+    const QFont labelFont = navigationLabelFont(font());
     auto drawItemIcon = [&](const QRectF &iconRect, const FluentNavigationItem &item) {
         if (hasAnimatedIconSource(item) && d->animatedIconLoaded(item.key)) {
             return;
         }
-
-        if (item.hasFluentIcon) {
-            FluentIcon::paintIcon(&p,
-                                  item.fluentIcon,
-                                  iconRect,
-                                  iconOptions(primaryText));
-        } else if (!item.iconGlyph.isEmpty()) {
-            QFont iconFont = font();
-            iconFont.setFamily(item.iconFontFamily.isEmpty() ? defaultGlyphFontFamily() : item.iconFontFamily);
-            iconFont.setPixelSize(kIconSize);
-            iconFont.setStyleStrategy(QFont::PreferAntialias);
-
-            p.save();
-            p.setFont(iconFont);
-            p.setPen(primaryText);
-            p.drawText(iconRect, Qt::AlignCenter, item.iconGlyph);
-            p.restore();
-        } else if (!item.icon.isNull()) {
-            item.icon.paint(&p,
-                            QRect(static_cast<int>(iconRect.left()),
-                                  static_cast<int>(iconRect.top()),
-                                  static_cast<int>(iconRect.width()),
-                                  static_cast<int>(iconRect.height())),
-                            Qt::AlignCenter,
-                            widgetEnabled ? QIcon::Normal : QIcon::Disabled);
+        if (!hasStaticIcon(item)) {
+            return;
         }
+
+        p.drawPixmap(iconRect.topLeft(), d->cachedItemIcon(item, primaryText, widgetEnabled, dpr, font()));
+    };
+
+    auto drawLabel = [&](const QStaticText &label, const QRectF &textRect) {
+        const qreal y = textRect.top() + (textRect.height() - label.size().height()) / 2.0;
+        p.drawStaticText(QPointF(textRect.left(), y), label);
     };
 
     if (d->displayMode == Top) {
@@ -2056,27 +2424,24 @@ void FluentNavigationView::paintEvent(QPaintEvent * /*event*/)
             }
 
             qreal textRight = layout.rect.right() - 12.0;
-            if (!layout.item->children.empty()) {
+            if (hasChildItems(*layout.item)) {
                 textRight -= 14.0;
             }
 
             const int textWidth = qMax(0, static_cast<int>(textRight - x));
             if (textWidth > 0) {
-                QFont textFont = font();
-                textFont.setPixelSize(14);
-                const QFontMetrics fm(textFont);
-                const QString text = fm.elidedText(layout.item->text, Qt::ElideRight, textWidth);
-
+                const QStaticText &label = Private::cachedLabel(d->labelCache[layout.item],
+                                                                layout.item->text,
+                                                                textWidth,
+                                                                labelFont);
                 p.save();
                 p.setPen(primaryText);
-                p.setFont(textFont);
-                p.drawText(QRectF(x, layout.rect.top(), textWidth, layout.rect.height()),
-                           Qt::AlignVCenter | Qt::AlignLeft | Qt::TextSingleLine,
-                           text);
+                p.setFont(labelFont);
+                drawLabel(label, QRectF(x, layout.rect.top(), textWidth, layout.rect.height()));
                 p.restore();
             }
 
-            if (!layout.item->children.empty()) {
+            if (hasChildItems(*layout.item)) {
                 drawChevron(topExpanderHitRect(layout.rect).center(), true);
             }
         }
@@ -2111,6 +2476,17 @@ void FluentNavigationView::paintEvent(QPaintEvent * /*event*/)
         p.restore();
     }
 
+    const QString selectedRowKey = d->displayMode == FluentNavigationView::LeftCompact
+        ? d->visibleKeyForSelection(d->selectedKey)
+        : d->selectedKey;
+    // While the pane width animates, rows keep the layout of the expanded
+    // pane and are clipped by the widget edge, so labels are elided once
+    // instead of on every frame.
+    const bool widthAnimating = d->widthAnim->state() == QAbstractAnimation::Running;
+    const qreal rowLayoutWidth = (widthAnimating && d->isExpandedMode())
+        ? qMax<qreal>(W, d->expandedWidth)
+        : qreal(W);
+
     auto paintRow = [&](int index, const QRectF &rect) {
         const auto &row = d->rows[static_cast<size_t>(index)];
 
@@ -2143,21 +2519,21 @@ void FluentNavigationView::paintEvent(QPaintEvent * /*event*/)
 
             if (labelOpacity > 0.0 && !d->paneTitle.isEmpty()) {
                 const qreal textLeft = hamburgerRect.right() + 10.0;
-                const qreal textRight = rect.right() - 12.0;
+                const qreal textRight = rect.left() + rowLayoutWidth - 12.0;
                 if (textRight > textLeft) {
                     QFont titleFont = font();
                     titleFont.setPixelSize(15);
                     titleFont.setWeight(QFont::DemiBold);
-                    const QFontMetrics fm(titleFont);
-                    const QString text = fm.elidedText(d->paneTitle, Qt::ElideRight, qMax(0, static_cast<int>(textRight - textLeft)));
+                    const QStaticText &title = Private::cachedLabel(d->paneTitleCache,
+                                                                    d->paneTitle,
+                                                                    qMax(0, static_cast<int>(textRight - textLeft)),
+                                                                    titleFont);
 
                     p.save();
                     p.setOpacity(labelOpacity);
                     p.setPen(primaryText);
                     p.setFont(titleFont);
-                    p.drawText(QRectF(textLeft, rect.top(), textRight - textLeft, rect.height()),
-                               Qt::AlignVCenter | Qt::AlignLeft | Qt::TextSingleLine,
-                               text);
+                    drawLabel(title, QRectF(textLeft, rect.top(), textRight - textLeft, rect.height()));
                     p.restore();
                 }
             }
@@ -2170,9 +2546,6 @@ void FluentNavigationView::paintEvent(QPaintEvent * /*event*/)
         }
 
         const bool hovered = widgetEnabled && index == d->hoverRowIndex && d->hoverLevel > 0.0;
-        const QString selectedRowKey = d->displayMode == FluentNavigationView::LeftCompact
-            ? d->visibleKeyForSelection(d->selectedKey)
-            : d->selectedKey;
         const bool selected = row.key() == selectedRowKey;
 
         if (hovered) {
@@ -2190,27 +2563,26 @@ void FluentNavigationView::paintEvent(QPaintEvent * /*event*/)
         drawItemIcon(iconRect, *row.item);
 
         if (labelOpacity > 0.0) {
+            const QRectF layoutRect(rect.left(), rect.top(), rowLayoutWidth, rect.height());
             const int textX = static_cast<int>(rect.left()) + indent + kItemPaddingX + kIconSize + 12;
-            const int textWidth = static_cast<int>(rect.width()) - textX - 32;
+            const int textWidth = static_cast<int>(layoutRect.width()) - textX - 32;
             if (textWidth > 0) {
-                QFont textFont = font();
-                textFont.setPixelSize(14);
-                const QFontMetrics fm(textFont);
-                const QString text = fm.elidedText(row.item->text, Qt::ElideRight, textWidth);
+                const QStaticText &label = Private::cachedLabel(d->labelCache[row.item],
+                                                                row.item->text,
+                                                                textWidth,
+                                                                labelFont);
                 p.save();
                 p.setOpacity(labelOpacity);
                 p.setPen(primaryText);
-                p.setFont(textFont);
-                p.drawText(QRectF(textX, rect.top(), textWidth, rect.height()),
-                           Qt::AlignVCenter | Qt::AlignLeft | Qt::TextSingleLine,
-                           text);
+                p.setFont(labelFont);
+                drawLabel(label, QRectF(textX, rect.top(), textWidth, rect.height()));
                 p.restore();
             }
 
             if (row.isExpander) {
                 p.save();
                 p.setOpacity(labelOpacity);
-                drawChevron(expanderHitRect(rect).center(), !row.expanded);
+                drawChevron(expanderHitRect(layoutRect).center(), !row.expanded);
                 p.restore();
             }
         }
@@ -2232,7 +2604,10 @@ void FluentNavigationView::paintEvent(QPaintEvent * /*event*/)
         for (int i = scrollableStart; i < footerStartRow && i < static_cast<int>(d->rows.size()); ++i) {
             const int rowHeightValue = d->rowHeight(i);
             const QRectF rect(0, sy, W, rowHeightValue);
-            if (rect.bottom() >= scrollTop && rect.top() <= scrollBottom) {
+            if (rect.top() > scrollBottom) {
+                break;
+            }
+            if (rect.bottom() >= scrollTop) {
                 paintRow(i, rect);
             }
             sy += rowHeightValue;
@@ -2328,10 +2703,10 @@ void FluentNavigationView::mousePressEvent(QMouseEvent *event)
                 continue;
             }
 
-            const bool onChevron = !layout.item->children.empty() && topExpanderHitRect(layout.rect).contains(event->pos());
+            const bool onChevron = hasChildItems(*layout.item) && topExpanderHitRect(layout.rect).contains(event->pos());
             const QPoint popupPos = mapToGlobal(QPoint(qRound(layout.rect.left()), qRound(layout.rect.bottom()) + 6));
 
-            if (!layout.item->children.empty()) {
+            if (hasChildItems(*layout.item)) {
                 if (!onChevron && layout.item->selectsOnInvoked && !layout.item->key.isEmpty()) {
                     setSelectedKey(layout.item->key);
                     emit itemInvoked(layout.item->key);
@@ -2594,6 +2969,9 @@ bool FluentNavigationView::event(QEvent *event)
         d->selStartRect = d->selRect;
         d->selTargetRect = d->selRect;
     }
+    if (event->type() == QEvent::FontChange) {
+        d->clearRenderCache();
+    }
 
     return QWidget::event(event);
 }
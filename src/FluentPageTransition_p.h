@@ -0,0 +1,176 @@
+#pragma once
+
+#include "Fluent/FluentMotion.h"
+#include "Fluent/FluentTheme.h"
+
+#include <QPainter>
+#include <QPixmap>
+#include <QRegion>
+#include <QVariantAnimation>
+#include <QWidget>
+#include <QtGlobal>
+
+namespace Fluent {
+
+// Plays a page switch from two offscreen snapshots instead of the live pages,
+// so every frame costs a few pixmap blits no matter how heavy the pages are.
+// The overlay covers the incoming page and hides itself at the end, which is
+// when the live widget becomes visible again.
+class FluentPageTransitionOverlay final : public QWidget
+{
+public:
+    explicit FluentPageTransitionOverlay(QWidget *parent)
+        : QWidget(parent)
+    {
+        setObjectName(QStringLiteral("FluentPageTransitionOverlay"));
+        setAttribute(Qt::WA_TransparentForMouseEvents, true);
+        setAttribute(Qt::WA_OpaquePaintEvent, true);
+        setAttribute(Qt::WA_NoSystemBackground, true);
+        hide();
+
+        m_anim = new QVariantAnimation(this);
+        m_anim->setStartValue(0.0);
+        m_anim->setEndValue(1.0);
+        QObject::connect(m_anim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
+            m_progress = value.toReal();
+            update();
+        });
+        QObject::connect(m_anim, &QVariantAnimation::finished, this, [this]() {
+            finish();
+        });
+        QObject::connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, [this]() {
+            if (!isRunning()) {
+                return;
+            }
+            FluentMotion::configure(m_anim, FluentMotionRole::Page);
+            if (m_anim->duration() <= 0) {
+                finish();
+            }
+        });
+    }
+
+    // Renders only the surface owner itself (no children) over rect, which is
+    // the backdrop the pages are composited on.
+    static QPixmap grabBackdrop(QWidget *owner, const QRect &rect)
+    {
+        if (!owner || rect.isEmpty()) {
+            return QPixmap();
+        }
+        const qreal dpr = owner->devicePixelRatioF();
+        QPixmap pixmap(rect.size() * dpr);
+        pixmap.setDevicePixelRatio(dpr);
+        pixmap.fill(Qt::transparent);
+        owner->render(&pixmap, QPoint(), QRegion(rect), QWidget::DrawWindowBackground);
+        return pixmap;
+    }
+
+    bool isRunning() const
+    {
+        return isVisible() && m_anim->state() == QAbstractAnimation::Running;
+    }
+
+    void start(FluentPageTransition kind,
+               const QRect &geometry,
+               const QPixmap &backdrop,
+               const QPixmap &from,
+               const QPixmap &to,
+               bool forward)
+    {
+        m_anim->stop();
+        FluentMotion::configure(m_anim, FluentMotionRole::Page);
+        if (kind == FluentPageTransition::None || m_anim->duration() <= 0 || geometry.isEmpty() || to.isNull()) {
+            finish();
+            return;
+        }
+
+        m_kind = kind;
+        m_forward = forward;
+        m_backdrop = backdrop;
+        m_from = from;
+        m_to = to;
+        m_progress = 0.0;
+
+        setGeometry(geometry);
+        raise();
+        show();
+        m_anim->start();
+    }
+
+    void finish()
+    {
+        m_anim->stop();
+        hide();
+        m_backdrop = QPixmap();
+        m_from = QPixmap();
+        m_to = QPixmap();
+    }
+
+protected:
+    void paintEvent(QPaintEvent *event) override
+    {
+        Q_UNUSED(event)
+
+        QPainter painter(this);
+        if (!painter.isActive()) {
+            return;
+        }
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+
+        painter.fillRect(rect(), ThemeManager::instance().tokens().neutral.background);
+        if (!m_backdrop.isNull()) {
+            painter.drawPixmap(0, 0, m_backdrop);
+        }
+
+        const qreal t = qBound<qreal>(0.0, m_progress, 1.0);
+        const qreal direction = m_forward ? 1.0 : -1.0;
+
+        switch (m_kind) {
+        case FluentPageTransition::Slide: {
+            const qreal distance = width() / 4.0;
+            drawSnapshot(painter, m_from, 1.0 - t, QPointF(-direction * distance * t, 0.0), 1.0);
+            drawSnapshot(painter, m_to, t, QPointF(direction * distance * (1.0 - t), 0.0), 1.0);
+            break;
+        }
+        case FluentPageTransition::DrillIn: {
+            const qreal outScale = m_forward ? 1.0 + 0.04 * t : 1.0 - 0.06 * t;
+            const qreal inScale = m_forward ? 0.94 + 0.06 * t : 1.04 - 0.04 * t;
+            drawSnapshot(painter, m_from, 1.0 - t, QPointF(), outScale);
+            drawSnapshot(painter, m_to, t, QPointF(), inScale);
+            break;
+        }
+        case FluentPageTransition::Fade:
+        case FluentPageTransition::None:
+        default:
+            drawSnapshot(painter, m_from, 1.0 - t, QPointF(), 1.0);
+            drawSnapshot(painter, m_to, t, QPointF(), 1.0);
+            break;
+        }
+    }
+
+private:
+    void drawSnapshot(QPainter &painter, const QPixmap &pixmap, qreal opacity, const QPointF &offset, qreal scale)
+    {
+        if (pixmap.isNull() || opacity <= 0.0) {
+            return;
+        }
+
+        painter.save();
+        painter.setOpacity(opacity);
+        const QPointF center = QRectF(rect()).center();
+        painter.translate(center + offset);
+        painter.scale(scale, scale);
+        painter.translate(-center);
+        painter.drawPixmap(0, 0, pixmap);
+        painter.restore();
+    }
+
+    QVariantAnimation *m_anim = nullptr;
+    FluentPageTransition m_kind = FluentPageTransition::None;
+    bool m_forward = true;
+    qreal m_progress = 0.0;
+    QPixmap m_backdrop;
+    QPixmap m_from;
+    QPixmap m_to;
+};
+
+} // namespace Fluent
@@ -2,6 +2,8 @@
 #include "Fluent/FluentMotion.h"
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QAbstractAnimation>
 #include <QEvent>
@@ -21,7 +23,7 @@ FluentProgressBar::FluentProgressBar(QWidget *parent)
     m_displayValue = value();
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentProgressBar::applyTheme);
+    ThemeRegistry::enroll<&FluentProgressBar::applyTheme>(this);
     connect(this, &QProgressBar::valueChanged, this, [this](int newValue) {
         FluentMotion::configure(m_valueAnim, FluentMotionRole::Selection);
         m_valueAnim->stop();
@@ -83,6 +85,8 @@ void FluentProgressBar::changeEvent(QEvent *event)
 
 void FluentProgressBar::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool snapValue = m_valueAnim &&
         m_valueAnim->state() == QAbstractAnimation::Running &&
         FluentMotion::duration(FluentMotionRole::Selection) <= 0;
@@ -3,6 +3,8 @@
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
 #include "FluentPaintSupport.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QAbstractAnimation>
 #include <QEvent>
@@ -91,7 +93,7 @@ FluentProgressRing::FluentProgressRing(QWidget *parent)
     });
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentProgressRing::applyTheme);
+    ThemeRegistry::enroll<&FluentProgressRing::applyTheme>(this);
 }
 
 qreal FluentProgressRing::displayValue() const
@@ -197,6 +199,8 @@ void FluentProgressRing::timerEvent(QTimerEvent *event)
 
 void FluentProgressRing::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool snapValue = m_valueAnim &&
         m_valueAnim->state() == QAbstractAnimation::Running &&
         FluentMotion::duration(FluentMotionRole::Selection) <= 0;
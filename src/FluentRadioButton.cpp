@@ -2,6 +2,8 @@
 #include "Fluent/FluentMotion.h"
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QAbstractAnimation>
 #include <QEvent>
@@ -17,40 +19,17 @@ FluentRadioButton::FluentRadioButton(QWidget *parent)
     setAttribute(Qt::WA_Hover, true);
     setFocusPolicy(Qt::StrongFocus);
 
-    m_hoverAnim = new QVariantAnimation(this);
-    connect(m_hoverAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_hoverLevel = value.toReal();
-        update();
-    });
-
-    m_focusAnim = new QVariantAnimation(this);
-    connect(m_focusAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_focusLevel = value.toReal();
-        update();
-    });
-
-    m_checkAnim = new QVariantAnimation(this);
-    connect(m_checkAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_checkLevel = value.toReal();
-        update();
-    });
     connect(this, &QRadioButton::toggled, this, [this](bool checked) {
-        FluentMotion::configure(m_checkAnim, FluentMotionRole::Selection);
-        m_checkAnim->stop();
         const qreal target = checked ? 1.0 : 0.0;
-        if (m_checkAnim->duration() <= 0) {
-            m_checkLevel = target;
+        FluentMotion::animateLevel(this, m_checkAnim, FluentMotionRole::Selection, m_checkLevel, target, [this](qreal level) {
+            m_checkLevel = level;
             update();
-        } else {
-            m_checkAnim->setStartValue(m_checkLevel);
-            m_checkAnim->setEndValue(target);
-            m_checkAnim->start();
-        }
+        });
     });
     m_checkLevel = isChecked() ? 1.0 : 0.0;
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentRadioButton::applyTheme);
+    ThemeRegistry::enroll<&FluentRadioButton::applyTheme>(this);
 }
 
 FluentRadioButton::FluentRadioButton(const QString &text, QWidget *parent)
@@ -60,40 +39,17 @@ FluentRadioButton::FluentRadioButton(const QString &text, QWidget *parent)
     setAttribute(Qt::WA_Hover, true);
     setFocusPolicy(Qt::StrongFocus);
 
-    m_hoverAnim = new QVariantAnimation(this);
-    connect(m_hoverAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_hoverLevel = value.toReal();
-        update();
-    });
-
-    m_focusAnim = new QVariantAnimation(this);
-    connect(m_focusAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_focusLevel = value.toReal();
-        update();
-    });
-
-    m_checkAnim = new QVariantAnimation(this);
-    connect(m_checkAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-        m_checkLevel = value.toReal();
-        update();
-    });
     connect(this, &QRadioButton::toggled, this, [this](bool checked) {
-        FluentMotion::configure(m_checkAnim, FluentMotionRole::Selection);
-        m_checkAnim->stop();
         const qreal target = checked ? 1.0 : 0.0;
-        if (m_checkAnim->duration() <= 0) {
-            m_checkLevel = target;
+        FluentMotion::animateLevel(this, m_checkAnim, FluentMotionRole::Selection, m_checkLevel, target, [this](qreal level) {
+            m_checkLevel = level;
             update();
-        } else {
-            m_checkAnim->setStartValue(m_checkLevel);
-            m_checkAnim->setEndValue(target);
-            m_checkAnim->start();
-        }
+        });
     });
     m_checkLevel = isChecked() ? 1.0 : 0.0;
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentRadioButton::applyTheme);
+    ThemeRegistry::enroll<&FluentRadioButton::applyTheme>(this);
 }
 
 QSize FluentRadioButton::sizeHint() const
@@ -145,6 +101,8 @@ void FluentRadioButton::changeEvent(QEvent *event)
 
 void FluentRadioButton::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool snapHover = m_hoverAnim &&
         m_hoverAnim->state() == QAbstractAnimation::Running &&
         FluentMotion::duration(FluentMotionRole::Hover) <= 0;
@@ -287,28 +245,16 @@ void FluentRadioButton::focusOutEvent(QFocusEvent *event)
 
 void FluentRadioButton::startHoverAnimation(qreal endValue)
 {
-    FluentMotion::configure(m_hoverAnim, FluentMotionRole::Hover);
-    m_hoverAnim->stop();
-    if (m_hoverAnim->duration() <= 0) {
-        setHoverLevel(endValue);
-        return;
-    }
-    m_hoverAnim->setStartValue(m_hoverLevel);
-    m_hoverAnim->setEndValue(endValue);
-    m_hoverAnim->start();
+    FluentMotion::animateLevel(this, m_hoverAnim, FluentMotionRole::Hover, m_hoverLevel, endValue, [this](qreal level) {
+        setHoverLevel(level);
+    });
 }
 
 void FluentRadioButton::startFocusAnimation(qreal endValue)
 {
-    FluentMotion::configure(m_focusAnim, FluentMotionRole::Focus);
-    m_focusAnim->stop();
-    if (m_focusAnim->duration() <= 0) {
-        setFocusLevel(endValue);
-        return;
-    }
-    m_focusAnim->setStartValue(m_focusLevel);
-    m_focusAnim->setEndValue(endValue);
-    m_focusAnim->start();
+    FluentMotion::animateLevel(this, m_focusAnim, FluentMotionRole::Focus, m_focusLevel, endValue, [this](qreal level) {
+        setFocusLevel(level);
+    });
 }
 
 } // namespace Fluent
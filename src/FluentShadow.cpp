@@ -0,0 +1,152 @@
+#include "FluentShadow_p.h"
+
+#include <QPainter>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Fluent {
+namespace Shadow {
+
+namespace {
+
+// Radii of three box blurs whose combined variance matches sigma: the widths
+// are the two odd integers around the ideal one, mixed so the variances add
+// up (Kutskir, "Fastest Gaussian blur").
+void boxRadii(qreal sigma, int radii[3])
+{
+    const qreal ideal = std::sqrt(4.0 * sigma * sigma + 1.0);
+    int lower = static_cast<int>(std::floor(ideal));
+    if (lower % 2 == 0) {
+        --lower;
+    }
+    const int upper = lower + 2;
+    const qreal lowerCount = std::round((12.0 * sigma * sigma - 3.0 * lower * lower - 12.0 * lower - 9.0) / (-4.0 * lower - 4.0));
+    for (int i = 0; i < 3; ++i) {
+        radii[i] = ((i < lowerCount ? lower : upper) - 1) / 2;
+    }
+}
+
+// One box blur down every column at once. The loops over x are plain
+// element-wise adds on whole rows, which compilers turn into SIMD code; the
+// division by the window is a multiply by its 16-bit fixed point inverse.
+void blurColumns(const quint8 *src, quint8 *dst, int width, int height, int radius, std::vector<quint32> &sums)
+{
+    const int window = 2 * radius + 1;
+    const quint32 scale = (65536u + quint32(window) / 2u) / quint32(window);
+    sums.assign(static_cast<size_t>(width), 0u);
+    quint32 *sum = sums.data();
+
+    for (int y = 0; y < qMin(radius, height); ++y) {
+        const quint8 *row = src + static_cast<size_t>(y) * width;
+        for (int x = 0; x < width; ++x) {
+            sum[x] += row[x];
+        }
+    }
+    for (int y = 0; y < height; ++y) {
+        if (y + radius < height) {
+            const quint8 *row = src + static_cast<size_t>(y + radius) * width;
+            for (int x = 0; x < width; ++x) {
+                sum[x] += row[x];
+            }
+        }
+        if (y - radius - 1 >= 0) {
+            const quint8 *row = src + static_cast<size_t>(y - radius - 1) * width;
+            for (int x = 0; x < width; ++x) {
+                sum[x] -= row[x];
+            }
+        }
+        quint8 *out = dst + static_cast<size_t>(y) * width;
+        for (int x = 0; x < width; ++x) {
+            out[x] = static_cast<quint8>(qMin<quint32>(255u, (sum[x] * scale + 0x8000u) >> 16));
+        }
+    }
+}
+
+void transpose(const quint8 *src, quint8 *dst, int width, int height)
+{
+    for (int y = 0; y < height; ++y) {
+        const quint8 *row = src + static_cast<size_t>(y) * width;
+        for (int x = 0; x < width; ++x) {
+            dst[static_cast<size_t>(x) * height + y] = row[x];
+        }
+    }
+}
+
+} // namespace
+
+void blurAlpha(quint8 *alpha, int width, int height, qreal sigma)
+{
+    if (!alpha || width <= 0 || height <= 0 || sigma <= 0.0) {
+        return;
+    }
+
+    int radii[3];
+    boxRadii(sigma, radii);
+
+    // Blur the columns, transpose so the rows become columns, blur again and
+    // transpose back.
+    const size_t count = static_cast<size_t>(width) * height;
+    std::vector<quint8> scratch(count);
+    std::vector<quint32> sums;
+    auto blurPasses = [&](quint8 *data, int w, int h) {
+        for (int radius : radii) {
+            if (radius <= 0) {
+                continue;
+            }
+            blurColumns(data, scratch.data(), w, h, radius, sums);
+            std::copy(scratch.cbegin(), scratch.cend(), data);
+        }
+    };
+    blurPasses(alpha, width, height);
+    std::vector<quint8> transposed(count);
+    transpose(alpha, transposed.data(), width, height);
+    blurPasses(transposed.data(), height, width);
+    transpose(transposed.data(), alpha, height, width);
+}
+
+QImage blurredRoundedRect(const QSize &size, const QRectF &shape, qreal radius, qreal sigma, const QColor &color)
+{
+    if (size.isEmpty()) {
+        return QImage();
+    }
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    {
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(Qt::black);
+        painter.drawRoundedRect(shape, radius, radius);
+    }
+
+    const int width = size.width();
+    const int height = size.height();
+    std::vector<quint8> alpha(static_cast<size_t>(width) * height);
+    for (int y = 0; y < height; ++y) {
+        const QRgb *line = reinterpret_cast<const QRgb *>(image.constScanLine(y));
+        quint8 *row = alpha.data() + static_cast<size_t>(y) * width;
+        for (int x = 0; x < width; ++x) {
+            row[x] = static_cast<quint8>(qAlpha(line[x]));
+        }
+    }
+
+    blurAlpha(alpha.data(), width, height, sigma);
+
+    const QRgb rgb = color.rgb();
+    const int colorAlpha = color.alpha();
+    for (int y = 0; y < height; ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        const quint8 *row = alpha.data() + static_cast<size_t>(y) * width;
+        for (int x = 0; x < width; ++x) {
+            const int a = (row[x] * colorAlpha + 127) / 255;
+            line[x] = qPremultiply(qRgba(qRed(rgb), qGreen(rgb), qBlue(rgb), a));
+        }
+    }
+    return image;
+}
+
+} // namespace Shadow
+} // namespace Fluent
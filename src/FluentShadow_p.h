@@ -0,0 +1,22 @@
+#pragma once
+
+#include <QColor>
+#include <QImage>
+#include <QRectF>
+#include <QSize>
+#include <QtGlobal>
+
+namespace Fluent {
+namespace Shadow {
+
+// Blurs a row-major 8-bit alpha mask in place with a Gaussian of sigma
+// pixels, approximated by three box blurs per axis. Pixels outside the mask
+// count as transparent.
+void blurAlpha(quint8 *alpha, int width, int height, qreal sigma);
+
+// Premultiplied image of size device pixels holding shape (a rounded rect of
+// radius, also in device pixels) filled with color and blurred with sigma.
+QImage blurredRoundedRect(const QSize &size, const QRectF &shape, qreal radius, qreal sigma, const QColor &color);
+
+} // namespace Shadow
+} // namespace Fluent
@@ -2,6 +2,8 @@
 #include "Fluent/FluentMotion.h"
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QAbstractAnimation>
 #include <QEvent>
@@ -64,7 +66,7 @@ FluentSlider::FluentSlider(Qt::Orientation orientation, QWidget *parent)
     setHandlePos((value() - minimum()) * 1.0 / qMax(1, maximum() - minimum()));
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentSlider::applyTheme);
+    ThemeRegistry::enroll<&FluentSlider::applyTheme>(this);
     connect(this, &QSlider::sliderPressed, this, [this]() {
         m_positionAnim->stop();
     });
@@ -127,6 +129,8 @@ void FluentSlider::changeEvent(QEvent *event)
 
 void FluentSlider::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool snapPosition = m_positionAnim &&
         m_positionAnim->state() == QAbstractAnimation::Running &&
         FluentMotion::duration(FluentMotionRole::Selection) <= 0;
@@ -2,6 +2,8 @@
 #include "Fluent/FluentMotion.h"
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 #include "FluentInputVisuals_p.h"
 
 #include <QAbstractAnimation>
@@ -126,7 +128,7 @@ FluentSpinBox::FluentSpinBox(QWidget *parent)
     });
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentSpinBox::applyTheme);
+    ThemeRegistry::enroll<&FluentSpinBox::applyTheme>(this);
 }
 
 QSize FluentSpinBox::sizeHint() const
@@ -177,6 +179,8 @@ void FluentSpinBox::changeEvent(QEvent *event)
 
 void FluentSpinBox::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool focusRunning = m_focusAnim && m_focusAnim->state() == QAbstractAnimation::Running;
     const bool stepperRunning = m_stepperAnim && m_stepperAnim->state() == QAbstractAnimation::Running;
@@ -231,9 +235,7 @@ void FluentSpinBox::applyTheme()
                  selectionBg.name(QColor::HexArgb),
                  colors.text.name(QColor::HexArgb),
                  colors.disabledText.name(QColor::HexArgb));
-        if (m_editor->styleSheet() != next) {
-            m_editor->setStyleSheet(next);
-        }
+        ThemeProfiler::setStyleSheetIfChanged(m_editor, next);
         m_editor->setPalette(pal);
     }
     update();
@@ -631,7 +633,7 @@ FluentDoubleSpinBox::FluentDoubleSpinBox(QWidget *parent)
     });
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentDoubleSpinBox::applyTheme);
+    ThemeRegistry::enroll<&FluentDoubleSpinBox::applyTheme>(this);
 }
 
 QSize FluentDoubleSpinBox::sizeHint() const
@@ -679,6 +681,8 @@ void FluentDoubleSpinBox::changeEvent(QEvent *event)
 
 void FluentDoubleSpinBox::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool focusRunning = m_focusAnim && m_focusAnim->state() == QAbstractAnimation::Running;
     const bool stepperRunning = m_stepperAnim && m_stepperAnim->state() == QAbstractAnimation::Running;
@@ -733,9 +737,7 @@ void FluentDoubleSpinBox::applyTheme()
                  selectionBg.name(QColor::HexArgb),
                  colors.text.name(QColor::HexArgb),
                  colors.disabledText.name(QColor::HexArgb));
-        if (m_editor->styleSheet() != next) {
-            m_editor->setStyleSheet(next);
-        }
+        ThemeProfiler::setStyleSheetIfChanged(m_editor, next);
         m_editor->setPalette(pal);
     }
     update();
@@ -3,6 +3,8 @@
 #include "Fluent/FluentMotion.h"
 #include "Fluent/FluentTheme.h"
 #include "Fluent/FluentQtCompat.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QAbstractAnimation>
 #include <QEvent>
@@ -174,7 +176,7 @@ FluentSplitter::FluentSplitter(Qt::Orientation orientation, QWidget *parent)
     setHandleWidth(8);
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentSplitter::applyTheme);
+    ThemeRegistry::enroll<&FluentSplitter::applyTheme>(this);
 }
 
 FluentSplitter::FluentSplitter(QWidget *parent)
@@ -189,6 +191,8 @@ QSplitterHandle *FluentSplitter::createHandle()
 
 void FluentSplitter::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     // Keep splitter background transparent; handle paints itself.
     setStyleSheet(QStringLiteral("QSplitter { background: transparent; }"));
 }
@@ -1,5 +1,7 @@
 #include "Fluent/FluentStatusBar.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QEvent>
 
@@ -11,7 +13,7 @@ FluentStatusBar::FluentStatusBar(QWidget *parent)
     setSizeGripEnabled(false);
     setAttribute(Qt::WA_StyledBackground, true);
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentStatusBar::applyTheme);
+    ThemeRegistry::enroll<&FluentStatusBar::applyTheme>(this);
 }
 
 void FluentStatusBar::changeEvent(QEvent *event)
@@ -24,10 +26,10 @@ void FluentStatusBar::changeEvent(QEvent *event)
 
 void FluentStatusBar::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const QString next = Theme::statusBarStyle(ThemeManager::instance().colors());
-    if (styleSheet() != next) {
-        setStyleSheet(next);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(this, next);
 }
 
 } // namespace Fluent
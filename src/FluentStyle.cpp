@@ -1,13 +1,220 @@
 #include "Fluent/FluentStyle.h"
-
+#include "FluentColorLerp_p.h"
+#include "FluentShadow_p.h"
+#include "FluentSurfaceCache_p.h"
+
+#include <QApplication>
+#include <QByteArray>
+#include <QCache>
+#include <QTransform>
+#include <QWidget>
 #include <QtMath>
 
 namespace Fluent {
 
 namespace {
 WindowMetrics g_windowMetrics;
+
+void paintSurfaceChrome(QPainter &p,
+                        const QRectF &rect,
+                        qreal radius,
+                        const QColor &fill,
+                        const QColor &stroke,
+                        const QColor &focus)
+{
+    p.save();
+    p.setRenderHint(QPainter::Antialiasing, true);
+
+    // Align strokes to device pixels to reduce jaggies on rounded corners (notably on HiDPI).
+    qreal dpr = 1.0;
+    if (p.device()) {
+        dpr = p.device()->devicePixelRatioF();
+        if (dpr <= 0.0) {
+            dpr = 1.0;
+        }
+    }
+    const qreal px = 0.5 / dpr;
+
+    const QRectF r = rect.adjusted(px, px, -px, -px);
+    p.setPen(QPen(stroke, 1.0));
+    p.setBrush(fill);
+    p.drawPath(Style::roundedRectPath(r, radius));
+
+    if (focus.alpha() > 0) {
+        p.setPen(QPen(focus, 2.0));
+        p.setBrush(Qt::NoBrush);
+        p.drawPath(Style::roundedRectPath(r.adjusted(1.0, 1.0, -1.0, -1.0), radius - 1));
+    }
+
+    p.restore();
+}
+}
+
+namespace SurfaceCache {
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+using HashValue = size_t;
+#else
+using HashValue = uint;
+#endif
+
+// SurfaceKey is all 32-bit fields, so its bytes carry no padding.
+inline HashValue qHash(const SurfaceKey &key, HashValue seed = 0)
+{
+    return qHashBits(&key, sizeof(SurfaceKey), seed);
+}
+
+namespace {
+
+constexpr int kTileCacheBytes = 4 * 1024 * 1024;
+constexpr qreal kLevelSteps = 32.0;
+constexpr int kMarginPx = 1;
+
+bool envEnabled()
+{
+    const QByteArray raw = qgetenv("QTFLUENT_SURFACE_CACHE").trimmed().toLower();
+    return !(raw == "0" || raw == "false" || raw == "off" || raw == "no");
 }
 
+struct CacheState {
+    bool enabled = envEnabled();
+    QCache<SurfaceKey, QPixmap> tiles{kTileCacheBytes};
+    SurfaceCacheStats stats;
+};
+
+CacheState &cacheState()
+{
+    static CacheState state;
+    return state;
+}
+
+// Splits a device coordinate into a whole pixel and a phase in 1/8 px.
+int splitPhase(qreal value, int *base)
+{
+    int whole = qFloor(value);
+    int phase = qRound((value - whole) * 8.0);
+    if (phase >= 8) {
+        ++whole;
+        phase = 0;
+    }
+    *base = whole;
+    return phase;
+}
+
+bool nearWhole(qreal value)
+{
+    return qAbs(value - qRound(value)) < 0.01;
+}
+
+} // namespace
+
+bool enabled()
+{
+    return cacheState().enabled;
+}
+
+qreal quantizeLevel(qreal level)
+{
+    return cacheState().enabled ? qRound(level * kLevelSteps) / kLevelSteps : level;
+}
+
+bool prepare(const QPainter &painter, const QRectF &rect, qreal corner, SurfaceKey *key, Slice *slice)
+{
+    CacheState &state = cacheState();
+    if (!state.enabled) {
+        return false;
+    }
+    if (!painter.isActive() || !painter.device() || rect.isEmpty() ||
+        painter.opacity() < 1.0 || painter.compositionMode() != QPainter::CompositionMode_SourceOver) {
+        ++state.stats.bypassed;
+        return false;
+    }
+
+    const QTransform device = painter.deviceTransform();
+    const qreal dpr = painter.device()->devicePixelRatioF();
+    if (device.type() > QTransform::TxScale || dpr <= 0.0 ||
+        !qFuzzyCompare(device.m11(), dpr) || !qFuzzyCompare(device.m22(), dpr)) {
+        ++state.stats.bypassed;
+        return false;
+    }
+
+    const QRectF deviceRect = device.mapRect(rect);
+    const int shapeCornerPx = qCeil(corner * dpr);
+    const int side = 2 * shapeCornerPx + 1;
+    if (!nearWhole(deviceRect.width()) || !nearWhole(deviceRect.height()) ||
+        qRound(deviceRect.width()) < side || qRound(deviceRect.height()) < side) {
+        ++state.stats.bypassed;
+        return false;
+    }
+
+    int x0 = 0;
+    int y0 = 0;
+    const int phaseX = splitPhase(deviceRect.left(), &x0);
+    const int phaseY = splitPhase(deviceRect.top(), &y0);
+
+    // One device pixel of margin around the rect keeps strokes centred on its edge.
+    slice->dpr = dpr;
+    slice->cornerPx = shapeCornerPx + kMarginPx;
+    slice->extraX = phaseX > 0 ? 1 : 0;
+    slice->extraY = phaseY > 0 ? 1 : 0;
+    slice->box = device.inverted().mapRect(QRectF(x0 - kMarginPx,
+                                                  y0 - kMarginPx,
+                                                  qRound(deviceRect.width()) + 2 * kMarginPx + slice->extraX,
+                                                  qRound(deviceRect.height()) + 2 * kMarginPx + slice->extraY));
+    slice->tileShape = QRectF((kMarginPx + phaseX / 8.0) / dpr, (kMarginPx + phaseY / 8.0) / dpr, side / dpr, side / dpr);
+
+    key->dpr = quint32(qRound(dpr * 100.0));
+    key->phase = quint32(phaseX << 4 | phaseY);
+    key->flags = painter.testRenderHint(QPainter::Antialiasing) ? 1u : 0u;
+    return true;
+}
+
+QPixmap find(const SurfaceKey &key)
+{
+    CacheState &state = cacheState();
+    if (const QPixmap *tile = state.tiles.object(key)) {
+        ++state.stats.hits;
+        return *tile;
+    }
+    ++state.stats.misses;
+    return QPixmap();
+}
+
+void store(const SurfaceKey &key, const QPixmap &tile)
+{
+    cacheState().tiles.insert(key, new QPixmap(tile), tile.width() * tile.height() * 4);
+}
+
+void blit(QPainter &painter, const Slice &slice, const QPixmap &tile)
+{
+    const int c = slice.cornerPx;
+    const qreal left = slice.box.left();
+    const qreal top = slice.box.top();
+    const qreal right = slice.box.right();
+    const qreal bottom = slice.box.bottom();
+    const qreal xs[4] = {left, left + c / slice.dpr, right - (c + slice.extraX) / slice.dpr, right};
+    const qreal ys[4] = {top, top + c / slice.dpr, bottom - (c + slice.extraY) / slice.dpr, bottom};
+    const qreal sx[4] = {0.0, qreal(c), qreal(c + 1), qreal(tile.width())};
+    const qreal sy[4] = {0.0, qreal(c), qreal(c + 1), qreal(tile.height())};
+
+    painter.save();
+    // The middle row/column is uniform, so nearest sampling stretches it exactly.
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            const QRectF target(xs[column], ys[row], xs[column + 1] - xs[column], ys[row + 1] - ys[row]);
+            if (target.width() <= 0.0 || target.height() <= 0.0) {
+                continue;
+            }
+            const QRectF source(sx[column], sy[row], sx[column + 1] - sx[column], sy[row + 1] - sy[row]);
+            painter.drawPixmap(target, tile, source);
+        }
+    }
+    painter.restore();
+}
+
+} // namespace SurfaceCache
+
 ControlMetrics Style::metrics()
 {
     ControlMetrics m;
@@ -41,12 +248,7 @@ void Style::setWindowMetrics(const WindowMetrics &metrics)
 
 QColor Style::mix(const QColor &a, const QColor &b, qreal t)
 {
-    t = qBound<qreal>(0.0, t, 1.0);
-    return QColor::fromRgbF(
-        a.redF() + (b.redF() - a.redF()) * t,
-        a.greenF() + (b.greenF() - a.greenF()) * t,
-        a.blueF() + (b.blueF() - a.blueF()) * t,
-        a.alphaF() + (b.alphaF() - a.alphaF()) * t);
+    return QColor::fromRgba64(ColorLerp::lerp(a.rgba64(), b.rgba64(), ColorLerp::fraction(t)));
 }
 
 QColor Style::withAlpha(const QColor &c, int alpha)
@@ -208,8 +410,8 @@ void Style::paintControlSurface(
         return;
     }
 
-    hoverLevel = qBound<qreal>(0.0, hoverLevel, 1.0);
-    focusLevel = qBound<qreal>(0.0, focusLevel, 1.0);
+    hoverLevel = SurfaceCache::quantizeLevel(qBound<qreal>(0.0, hoverLevel, 1.0));
+    focusLevel = SurfaceCache::quantizeLevel(qBound<qreal>(0.0, focusLevel, 1.0));
 
     const auto m = metrics();
 
@@ -227,33 +429,65 @@ void Style::paintControlSurface(
     const QColor stroke = enabled ? tokens.neutral.strokeSubtle
                                   : mix(tokens.neutral.strokeSubtle, colors.disabledText, tokens.dark ? 0.28 : 0.18);
 
-    p.save();
-    p.setRenderHint(QPainter::Antialiasing, true);
+    QColor focus(0, 0, 0, 0);
+    if (enabled && focusLevel > 0.0) {
+        focus = tokens.accent.base;
+        focus.setAlphaF(0.9 * focusLevel);
+    }
 
-    // Align strokes to device pixels to reduce jaggies on rounded corners (notably on HiDPI).
-    qreal dpr = 1.0;
-    if (p.device()) {
-        dpr = p.device()->devicePixelRatioF();
-        if (dpr <= 0.0) {
-            dpr = 1.0;
+    SurfaceCache::SurfaceKey key;
+    key.kind = quint32(SurfaceCache::Kind::ControlSurface);
+    key.radius = quint32(qRound(m.radius * 4.0));
+    key.border = 4;
+    key.fill = fill.rgba();
+    key.stroke = stroke.rgba();
+    key.accent = focus.rgba();
+    const bool cached = SurfaceCache::paint(p, rect, key, m.radius + 2.0, [&](QPainter &tile, const QRectF &tileRect) {
+        paintSurfaceChrome(tile, tileRect, m.radius, fill, stroke, focus);
+    });
+    if (!cached) {
+        paintSurfaceChrome(p, rect, m.radius, fill, stroke, focus);
+    }
+}
+
+void Style::setSurfaceCacheEnabled(bool enabled)
+{
+    SurfaceCache::CacheState &state = SurfaceCache::cacheState();
+    if (state.enabled == enabled) {
+        return;
+    }
+    state.enabled = enabled;
+    state.tiles.clear();
+    if (qobject_cast<QApplication *>(QCoreApplication::instance())) {
+        const auto windows = QApplication::topLevelWidgets();
+        for (QWidget *window : windows) {
+            window->update();
         }
     }
-    const qreal px = 0.5 / dpr;
+}
 
-    const QRectF r = rect.adjusted(px, px, -px, -px);
-    p.setPen(QPen(stroke, 1.0));
-    p.setBrush(fill);
-    p.drawPath(roundedRectPath(r, m.radius));
+bool Style::surfaceCacheEnabled()
+{
+    return SurfaceCache::cacheState().enabled;
+}
 
-    if (enabled && focusLevel > 0.0) {
-        QColor focus = tokens.accent.base;
-        focus.setAlphaF(0.9 * focusLevel);
-        p.setPen(QPen(focus, 2.0));
-        p.setBrush(Qt::NoBrush);
-        p.drawPath(roundedRectPath(r.adjusted(1.0, 1.0, -1.0, -1.0), m.radius - 1));
-    }
+SurfaceCacheStats Style::surfaceCacheStats()
+{
+    const SurfaceCache::CacheState &state = SurfaceCache::cacheState();
+    SurfaceCacheStats stats = state.stats;
+    stats.tiles = static_cast<int>(state.tiles.size());
+    stats.bytes = static_cast<qint64>(state.tiles.totalCost());
+    return stats;
+}
 
-    p.restore();
+void Style::resetSurfaceCacheStats()
+{
+    SurfaceCache::cacheState().stats = SurfaceCacheStats();
+}
+
+void Style::clearSurfaceCache()
+{
+    SurfaceCache::cacheState().tiles.clear();
 }
 
 void Style::drawChevronDown(QPainter &p, const QPointF &center, const QColor &color, qreal size, qreal strokeWidth)
@@ -346,6 +580,69 @@ void Style::drawChevronUpDown(QPainter &p, const QPointF &center, const QColor &
     drawChevronDown(p, QPointF(center.x(), center.y() + gap / 2.0), color, size, strokeWidth);
 }
 
+void Style::paintShadow(QPainter &p, const QRectF &rect, qreal radius, qreal blur, const QColor &color)
+{
+    if (!p.isActive() || rect.isEmpty() || color.alpha() == 0) {
+        return;
+    }
+
+    // Work in device pixels when the painter only scales; anything else gets
+    // a tile at logical scale that the painter transforms.
+    const QTransform device = p.deviceTransform();
+    const bool aligned = device.type() <= QTransform::TxScale && device.m11() > 0.0 &&
+                         qFuzzyCompare(device.m11(), device.m22());
+    const qreal scale = aligned ? device.m11() : 1.0;
+    const QRectF deviceRect = aligned ? device.mapRect(rect) : rect;
+
+    SurfaceCache::SurfaceKey key;
+    key.kind = quint32(SurfaceCache::Kind::Shadow);
+    key.radius = quint32(qRound(qBound<qreal>(0.0, radius, qMin(rect.width(), rect.height()) / 2.0) * 4.0));
+    key.border = quint32(qRound(qBound<qreal>(0.0, blur, 64.0) * 4.0));
+    key.fill = color.rgba();
+    key.dpr = quint32(qRound(scale * 100.0));
+
+    // The blur reaches three sigma past the shape. A tile corner has to hold
+    // that, the rounded corner and another reach of straight edge so that the
+    // middle row and column are the same everywhere along the rect.
+    const qreal radiusPx = key.radius / 4.0 * scale;
+    const qreal sigmaPx = key.border / 4.0 * scale;
+    const int reach = qCeil(3.0 * sigmaPx);
+    const int straight = qCeil(radiusPx) + reach;
+    const int width = qMax(1, qRound(deviceRect.width()));
+    const int height = qMax(1, qRound(deviceRect.height()));
+    const bool sliced = width > 2 * straight && height > 2 * straight;
+    const QSize tileSize = sliced ? QSize(2 * (reach + straight) + 1, 2 * (reach + straight) + 1)
+                                  : QSize(width + 2 * reach, height + 2 * reach);
+    if (!sliced) {
+        key.phase = quint32(width) << 16 | quint32(height);
+    }
+
+    QPixmap tile;
+    const bool cached = SurfaceCache::enabled();
+    if (cached) {
+        tile = SurfaceCache::find(key);
+    }
+    if (tile.isNull()) {
+        const QRectF shape(reach, reach, tileSize.width() - 2 * reach, tileSize.height() - 2 * reach);
+        tile = QPixmap::fromImage(Shadow::blurredRoundedRect(tileSize, shape, radiusPx, sigmaPx, color));
+        tile.setDevicePixelRatio(scale);
+        if (cached) {
+            SurfaceCache::store(key, tile);
+        }
+    }
+
+    const QRectF box(qRound(deviceRect.left()) - reach, qRound(deviceRect.top()) - reach, width + 2 * reach, height + 2 * reach);
+    SurfaceCache::Slice slice;
+    slice.dpr = scale;
+    slice.cornerPx = reach + straight;
+    slice.box = aligned ? device.inverted().mapRect(box) : box;
+    if (sliced) {
+        SurfaceCache::blit(p, slice, tile);
+    } else {
+        p.drawPixmap(slice.box, tile, QRectF(tile.rect()));
+    }
+}
+
 void Style::paintElevationShadow(QPainter &p, const QRectF &panelRect, qreal radius, const ThemeColors &colors, qreal strength, int layers)
 {
     if (!p.isActive()) {
@@ -356,17 +653,33 @@ void Style::paintElevationShadow(QPainter &p, const QRectF &panelRect, qreal rad
     layers = qMax(1, layers);
 
     const bool dark = colors.background.lightnessF() < 0.5;
-    QColor shadowBase = dark ? QColor(0, 0, 0, static_cast<int>(140 * strength))
-                             : QColor(0, 0, 0, static_cast<int>(90 * strength));
+    const qreal baseAlpha = qMin<qreal>(1.0, (dark ? 140.0 : 90.0) * strength / 255.0);
+
+    // Uncached, stacking the layers beats blurring a new tile on every paint.
+    if (!SurfaceCache::enabled()) {
+        QColor shadowBase = dark ? QColor(0, 0, 0, static_cast<int>(140 * strength))
+                                 : QColor(0, 0, 0, static_cast<int>(90 * strength));
+        for (int i = 0; i < layers; ++i) {
+            const qreal t = static_cast<qreal>(i) / static_cast<qreal>(layers);
+            QColor c = shadowBase;
+            c.setAlphaF(shadowBase.alphaF() * (1.0 - t) * (0.35 * strength));
+            p.setPen(Qt::NoPen);
+            p.setBrush(c);
+            p.drawRoundedRect(panelRect.adjusted(-2 - i, -2 - i, 2 + i, 2 + i), radius + i, radius + i);
+        }
+        return;
+    }
 
+    // One blurred rect as dense as the layers stacked, spreading as far.
+    qreal clear = 1.0;
     for (int i = 0; i < layers; ++i) {
         const qreal t = static_cast<qreal>(i) / static_cast<qreal>(layers);
-        QColor c = shadowBase;
-        c.setAlphaF(shadowBase.alphaF() * (1.0 - t) * (0.35 * strength));
-        p.setPen(Qt::NoPen);
-        p.setBrush(c);
-        p.drawRoundedRect(panelRect.adjusted(-2 - i, -2 - i, 2 + i, 2 + i), radius + i, radius + i);
+        clear *= 1.0 - qBound<qreal>(0.0, baseAlpha * (1.0 - t) * (0.35 * strength), 1.0);
     }
+    QColor shadow(0, 0, 0);
+    shadow.setAlphaF(1.0 - clear);
+    const qreal spread = 2.0 + layers / 2.0;
+    paintShadow(p, panelRect.adjusted(-spread, -spread, spread, spread), radius + spread, layers / 2.0, shadow);
 }
 
 } // namespace Fluent
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <QPainter>
+#include <QPixmap>
+#include <QRectF>
+#include <QRgb>
+#include <QtGlobal>
+
+namespace Fluent {
+namespace SurfaceCache {
+
+enum class Kind : quint32 {
+    ControlSurface = 1, // Style::paintControlSurface
+    RoundedControl = 2, // ButtonVisuals::paintRoundedControl
+    Shadow = 3          // Style::paintShadow
+};
+
+// Everything a tile's pixels depend on. prepare() fills in the DPR, the
+// sub-pixel phase of the rect and the painter's antialiasing hint. Shadow
+// tiles keep the blur in border and, when the rect is too small to slice,
+// its device size in phase.
+struct SurfaceKey {
+    quint32 kind = 0;
+    quint32 radius = 0; // 1/4 px
+    quint32 border = 0; // 1/4 px
+    QRgb fill = 0;
+    QRgb stroke = 0;
+    QRgb accent = 0;    // bottom stroke or focus ring
+    quint32 dpr = 0;    // 1/100
+    quint32 phase = 0;  // x and y device phase in 1/8 px
+    quint32 flags = 0;
+};
+
+inline bool operator==(const SurfaceKey &a, const SurfaceKey &b)
+{
+    return a.kind == b.kind && a.radius == b.radius && a.border == b.border && a.fill == b.fill &&
+           a.stroke == b.stroke && a.accent == b.accent && a.dpr == b.dpr && a.phase == b.phase &&
+           a.flags == b.flags;
+}
+
+// How a rect maps onto a tile: corners of cornerPx device pixels (including a
+// one pixel margin outside the rect), one stretchable device pixel in the
+// middle, plus one extra column/row on the far side when the rect starts
+// between device pixels.
+struct Slice {
+    qreal dpr = 1.0;
+    int cornerPx = 0;
+    int extraX = 0;
+    int extraY = 0;
+    QRectF box;       // device-aligned bounds of the rect, painter coordinates
+    QRectF tileShape; // the rect as painted inside the tile, tile coordinates
+};
+
+bool enabled();
+
+// Snaps a hover/press/focus level to the cache step so an animation reuses a
+// handful of tiles; returns the level unchanged while the cache is off.
+qreal quantizeLevel(qreal level);
+
+// False when the cache is off or rect cannot be sliced pixel-exactly: a
+// rotated or scaled painter, translucent painting, a size that is not a whole
+// number of device pixels, or a rect smaller than its corners.
+bool prepare(const QPainter &painter, const QRectF &rect, qreal corner, SurfaceKey *key, Slice *slice);
+QPixmap find(const SurfaceKey &key);
+void store(const SurfaceKey &key, const QPixmap &tile);
+void blit(QPainter &painter, const Slice &slice, const QPixmap &tile);
+
+// Draws rect from a cached nine-slice tile, rasterizing the tile once through
+// paintTile(tilePainter, tileRect) on a miss. Returns false without drawing
+// when the caller has to paint directly.
+template <typename PaintTile>
+bool paint(QPainter &painter, const QRectF &rect, SurfaceKey key, qreal corner, PaintTile paintTile)
+{
+    Slice slice;
+    if (!prepare(painter, rect, corner, &key, &slice)) {
+        return false;
+    }
+
+    QPixmap tile = find(key);
+    if (tile.isNull()) {
+        const int side = 2 * slice.cornerPx + 1;
+        tile = QPixmap(side + slice.extraX, side + slice.extraY);
+        tile.setDevicePixelRatio(slice.dpr);
+        tile.fill(Qt::transparent);
+        {
+            QPainter tilePainter(&tile);
+            tilePainter.setRenderHints(painter.renderHints());
+            paintTile(tilePainter, slice.tileShape);
+        }
+        store(key, tile);
+    }
+    blit(painter, slice, tile);
+    return true;
+}
+
+} // namespace SurfaceCache
+} // namespace Fluent
@@ -3,6 +3,9 @@
 #include "Fluent/FluentMotion.h"
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
+#include "FluentPageTransition_p.h"
 
 #include <QAbstractAnimation>
 #include <QEvent>
@@ -10,6 +13,7 @@
 #include <QMouseEvent>
 #include <QPainter>
 #include <QPainterPath>
+#include <QStackedWidget>
 #include <QStyle>
 #include <QStyleOption>
 #include <QVariantAnimation>
@@ -861,9 +865,7 @@ private:
             const QString padStyle = QStringLiteral(
                 "QTabBar::tab:first { margin-top: 10px; }\n"
                 "QTabBar::tab:last  { margin-bottom: 10px; }\n");
-            if (styleSheet() != padStyle) {
-                setStyleSheet(padStyle);
-            }
+            ThemeProfiler::setStyleSheetIfChanged(this, padStyle);
         } else {
             setContentsMargins(0, 0, 0, 0);
 
@@ -966,16 +968,20 @@ FluentTabWidget::FluentTabWidget(QWidget *parent)
     syncFrameOverlay();
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentTabWidget::applyTheme);
+    ThemeRegistry::enroll<&FluentTabWidget::applyTheme>(this);
     connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, [this]() {
         if (m_frameOverlay) {
             m_frameOverlay->update();
         }
     });
+    connect(this, &QTabWidget::currentChanged, this, &FluentTabWidget::startPageTransition);
 }
 
 bool FluentTabWidget::event(QEvent *event)
 {
+    if (event->type() == QEvent::Hide) {
+        finishPageTransition();
+    }
     const bool handled = QTabWidget::event(event);
     if (event->type() == QEvent::LayoutRequest || event->type() == QEvent::Show || event->type() == QEvent::Polish
         || event->type() == QEvent::ChildAdded) {
@@ -997,6 +1003,7 @@ void FluentTabWidget::changeEvent(QEvent *event)
 
 void FluentTabWidget::resizeEvent(QResizeEvent *event)
 {
+    finishPageTransition();
     QTabWidget::resizeEvent(event);
     syncFrameOverlay();
     scheduleDocumentCornerWidgetPosition();
@@ -1004,10 +1011,10 @@ void FluentTabWidget::resizeEvent(QResizeEvent *event)
 
 void FluentTabWidget::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const QString next = Theme::tabWidgetStyle(ThemeManager::instance().colors());
-    if (styleSheet() != next) {
-        setStyleSheet(next);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(this, next);
 }
 
 void FluentTabWidget::applyContentMargins()
@@ -1040,6 +1047,46 @@ void FluentTabWidget::syncFrameOverlay()
     m_frameOverlay->update();
 }
 
+void FluentTabWidget::startPageTransition(int index)
+{
+    QWidget *from = m_currentPage;
+    QWidget *to = widget(index);
+    m_currentPage = to;
+
+    if (m_pageTransition == FluentPageTransition::None || !isVisible() || !from || !to || from == to
+        || indexOf(from) < 0 || FluentMotion::duration(FluentMotionRole::Page) <= 0) {
+        finishPageTransition();
+        return;
+    }
+
+    auto *stack = findChild<QStackedWidget *>(QString(), Qt::FindDirectChildrenOnly);
+    if (!stack || stack->size().isEmpty()) {
+        finishPageTransition();
+        return;
+    }
+
+    if (!m_pageTransitionOverlay) {
+        m_pageTransitionOverlay = new FluentPageTransitionOverlay(stack);
+    }
+
+    // Each page is painted once here; the animation frames only blit these.
+    const QPixmap outgoing = from->grab();
+    const QPixmap incoming = to->grab();
+    m_pageTransitionOverlay->start(m_pageTransition,
+                                   stack->rect(),
+                                   FluentPageTransitionOverlay::grabBackdrop(this, stack->geometry()),
+                                   outgoing,
+                                   incoming,
+                                   indexOf(from) < index);
+}
+
+void FluentTabWidget::finishPageTransition()
+{
+    if (m_pageTransitionOverlay) {
+        m_pageTransitionOverlay->finish();
+    }
+}
+
 void FluentTabWidget::tabInserted(int index)
 {
     QTabWidget::tabInserted(index);
@@ -1198,6 +1245,23 @@ void FluentTabWidget::setTabDisplayMode(TabDisplayMode mode)
     scheduleDocumentCornerWidgetPosition();
 }
 
+FluentPageTransition FluentTabWidget::pageTransition() const
+{
+    return m_pageTransition;
+}
+
+void FluentTabWidget::setPageTransition(FluentPageTransition transition)
+{
+    if (m_pageTransition == transition) {
+        return;
+    }
+
+    m_pageTransition = transition;
+    if (transition == FluentPageTransition::None) {
+        finishPageTransition();
+    }
+}
+
 int FluentTabWidget::contentMargin() const
 {
     return m_contentMargin;
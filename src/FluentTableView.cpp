@@ -6,6 +6,8 @@
 #include "FluentItemViewPaintSupport.h"
 #include "FluentTableSupport.h"
 #include "FluentViewPaletteSupport.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QAbstractItemModel>
 #include <QEvent>
@@ -73,7 +75,7 @@ FluentTableView::FluentTableView(QWidget *parent)
         viewport()->update();
     });
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentTableView::applyTheme);
+    ThemeRegistry::enroll<&FluentTableView::applyTheme>(this);
 
     QTimer::singleShot(0, this, [this]() { hookSelectionModel(); });
 }
@@ -157,6 +159,8 @@ void FluentTableView::leaveEvent(QEvent *event)
 
 void FluentTableView::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool selectionRunning = m_selAnim && m_selAnim->state() == QAbstractAnimation::Running;
     const QVariant hoverEnd = m_hoverAnim ? m_hoverAnim->endValue() : QVariant();
@@ -182,9 +186,7 @@ void FluentTableView::applyTheme()
 
     const auto &colors = ThemeManager::instance().colors();
     const QString next = Theme::tableViewStyle(colors);
-    if (styleSheet() != next) {
-        setStyleSheet(next);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(this, next);
     Detail::applyFluentViewPalette(this, viewport(), colors);
     Detail::applyFluentViewPalette(horizontalHeader(), horizontalHeader() ? horizontalHeader()->viewport() : nullptr, colors);
 }
@@ -6,6 +6,8 @@
 #include "FluentPaintSupport.h"
 #include "FluentTableSupport.h"
 #include "FluentViewPaletteSupport.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QAbstractItemModel>
 #include <QEvent>
@@ -83,7 +85,7 @@ void FluentTableWidget::initFluent()
         viewport()->update();
     });
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentTableWidget::applyTheme);
+    ThemeRegistry::enroll<&FluentTableWidget::applyTheme>(this);
 
     QTimer::singleShot(0, this, [this]() { hookSelectionModel(); });
 }
@@ -161,6 +163,8 @@ void FluentTableWidget::leaveEvent(QEvent *event)
 
 void FluentTableWidget::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool selectionRunning = m_selAnim && m_selAnim->state() == QAbstractAnimation::Running;
     const QVariant hoverEnd = m_hoverAnim ? m_hoverAnim->endValue() : QVariant();
@@ -186,9 +190,7 @@ void FluentTableWidget::applyTheme()
 
     const auto &colors = ThemeManager::instance().colors();
     const QString next = Theme::tableViewStyle(colors);
-    if (styleSheet() != next) {
-        setStyleSheet(next);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(this, next);
     Detail::applyFluentViewPalette(this, viewport(), colors);
     Detail::applyFluentViewPalette(horizontalHeader(), horizontalHeader() ? horizontalHeader()->viewport() : nullptr, colors);
 }
@@ -0,0 +1,155 @@
+#include "FluentTextDiff_p.h"
+
+#include <QHash>
+#include <QString>
+
+#include <algorithm>
+#include <vector>
+
+namespace Fluent {
+namespace TextDiff {
+
+namespace {
+
+// length lines starting at a[oldStart] equal those starting at b[newStart].
+struct Run {
+    int oldStart = 0;
+    int newStart = 0;
+    int length = 0;
+};
+
+// Myers' greedy O((N + M) D) search. Every round keeps the furthest x reached
+// on each diagonal so the path can be walked back into runs of equal lines.
+// Returns false once the edit distance exceeds maxCost.
+bool equalRuns(const std::vector<int> &a, const std::vector<int> &b, int maxCost, std::vector<Run> *runs)
+{
+    const int n = static_cast<int>(a.size());
+    const int m = static_cast<int>(b.size());
+    const int maxD = qMin(n + m, qMax(0, maxCost));
+    const int offset = maxD + 1;
+
+    std::vector<int> v(static_cast<size_t>(2 * offset + 1), 0);
+    std::vector<std::vector<int>> trace; // trace[d][k + d] for k in [-d, d]
+    int distance = -1;
+    for (int d = 0; d <= maxD && distance < 0; ++d) {
+        for (int k = -d; k <= d; k += 2) {
+            int x = 0;
+            if (k == -d || (k != d && v[offset + k - 1] < v[offset + k + 1])) {
+                x = v[offset + k + 1];
+            } else {
+                x = v[offset + k - 1] + 1;
+            }
+            int y = x - k;
+            while (x < n && y < m && a[x] == b[y]) {
+                ++x;
+                ++y;
+            }
+            v[offset + k] = x;
+            if (x >= n && y >= m) {
+                distance = d;
+                break;
+            }
+        }
+        trace.emplace_back(v.begin() + (offset - d), v.begin() + (offset + d + 1));
+    }
+    if (distance < 0) {
+        return false;
+    }
+
+    int x = n;
+    int y = m;
+    for (int d = distance; d > 0; --d) {
+        const std::vector<int> &prev = trace[static_cast<size_t>(d - 1)];
+        const int k = x - y;
+        const bool down = k == -d || (k != d && prev[k - 1 + d - 1] < prev[k + 1 + d - 1]);
+        const int prevK = down ? k + 1 : k - 1;
+        const int prevX = prev[prevK + d - 1];
+        // The insertion (down) or deletion lands on midX; equal lines follow.
+        const int midX = down ? prevX : prevX + 1;
+        if (x > midX) {
+            runs->push_back({midX, midX - k, x - midX});
+        }
+        x = prevX;
+        y = prevX - prevK;
+    }
+    if (x > 0) {
+        runs->push_back({0, 0, x});
+    }
+    std::reverse(runs->begin(), runs->end());
+    return true;
+}
+
+} // namespace
+
+QVector<Hunk> diffLines(const QStringList &oldLines, const QStringList &newLines, int maxCost)
+{
+    const int oldSize = static_cast<int>(oldLines.size());
+    const int newSize = static_cast<int>(newLines.size());
+
+    // Formatter output mostly agrees with the document at both ends.
+    int head = 0;
+    while (head < oldSize && head < newSize && oldLines.at(head) == newLines.at(head)) {
+        ++head;
+    }
+    int tail = 0;
+    while (tail < oldSize - head && tail < newSize - head
+           && oldLines.at(oldSize - 1 - tail) == newLines.at(newSize - 1 - tail)) {
+        ++tail;
+    }
+
+    const int oldMid = oldSize - head - tail;
+    const int newMid = newSize - head - tail;
+    QVector<Hunk> hunks;
+    if (oldMid == 0 && newMid == 0) {
+        return hunks;
+    }
+    if (oldMid == 0 || newMid == 0) {
+        hunks.append({head, oldMid, head, newMid});
+        return hunks;
+    }
+
+    // Compare interned line ids rather than strings in the inner loop.
+    QHash<QString, int> ids;
+    ids.reserve(oldMid + newMid);
+    auto intern = [&ids](const QString &line) {
+        const auto it = ids.constFind(line);
+        if (it != ids.constEnd()) {
+            return it.value();
+        }
+        const int id = static_cast<int>(ids.size());
+        ids.insert(line, id);
+        return id;
+    };
+    std::vector<int> a(static_cast<size_t>(oldMid));
+    for (int i = 0; i < oldMid; ++i) {
+        a[static_cast<size_t>(i)] = intern(oldLines.at(head + i));
+    }
+    std::vector<int> b(static_cast<size_t>(newMid));
+    for (int i = 0; i < newMid; ++i) {
+        b[static_cast<size_t>(i)] = intern(newLines.at(head + i));
+    }
+
+    std::vector<Run> runs;
+    if (!equalRuns(a, b, maxCost, &runs)) {
+        hunks.append({head, oldMid, head, newMid});
+        return hunks;
+    }
+
+    int x = 0;
+    int y = 0;
+    auto emitGap = [&](int toX, int toY) {
+        if (toX > x || toY > y) {
+            hunks.append({head + x, toX - x, head + y, toY - y});
+        }
+    };
+    for (const Run &run : runs) {
+        emitGap(run.oldStart, run.newStart);
+        x = run.oldStart + run.length;
+        y = run.newStart + run.length;
+    }
+    emitGap(oldMid, newMid);
+    return hunks;
+}
+
+} // namespace TextDiff
+} // namespace Fluent
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <QStringList>
+#include <QVector>
+#include <QtGlobal>
+
+namespace Fluent {
+namespace TextDiff {
+
+// Old lines [oldStart, oldStart + oldCount) become new lines
+// [newStart, newStart + newCount). Either count may be zero, not both.
+struct Hunk {
+    int oldStart = 0;
+    int oldCount = 0;
+    int newStart = 0;
+    int newCount = 0;
+};
+
+// Line-level Myers diff turning oldLines into newLines; hunks come in
+// ascending order and never overlap. Once more than maxCost lines would have
+// to be inserted or removed, everything between the common head and tail is
+// returned as a single hunk instead. Safe to call from any thread.
+QVector<Hunk> diffLines(const QStringList &oldLines, const QStringList &newLines, int maxCost = 1024);
+
+} // namespace TextDiff
+} // namespace Fluent
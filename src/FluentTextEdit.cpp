@@ -3,6 +3,7 @@
 #include "Fluent/FluentScrollBar.h"
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
 #include "FluentInputVisuals_p.h"
 
 #include <QAbstractAnimation>
@@ -182,6 +183,8 @@ void FluentTextEdit::changeEvent(QEvent *event)
 
 void FluentTextEdit::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool focusRunning = m_focusAnim && m_focusAnim->state() == QAbstractAnimation::Running;
     const QVariant hoverEnd = m_hoverAnim ? m_hoverAnim->endValue() : QVariant();
@@ -216,9 +219,7 @@ void FluentTextEdit::applyTheme()
              colors.text.name(QColor::HexArgb),
              colors.disabledText.name(QColor::HexArgb));
 
-    if (styleSheet() != next) {
-        setStyleSheet(next);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(this, next);
 
     QPalette pal = palette();
     pal.setColor(QPalette::Base, QColor(Qt::transparent));
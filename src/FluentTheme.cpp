@@ -4,11 +4,16 @@
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentToolTip.h"
 #include "FluentButtonVisuals_p.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QApplication>
 #include <QDebug>
 #include <QGuiApplication>
 #include <QLocale>
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QTimer>
 #include <QVariantAnimation>
 #include <QWidget>
@@ -213,8 +218,107 @@ FluentThemeTokens Theme::tokens(const ThemeColors &colors)
   return t;
 }
 
-QString Theme::baseStyleSheet(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+namespace {
+
+// Control stylesheets are pure functions of the palette, so every instance of
+// a control shares one implicitly shared QString per palette instead of
+// rebuilding tokens and re-running the .arg() chain. Two palettes are kept per
+// builder so light/dark toggling stays warm.
+enum class StyleSheetId {
+  Base,
+  Button,
+  PrimaryButton,
+  Label,
+  LineEdit,
+  TextEdit,
+  DateTime,
+  CalendarPopup,
+  CheckBox,
+  RadioButton,
+  ToggleSwitch,
+  ComboBox,
+  Slider,
+  ProgressBar,
+  SpinBox,
+  ToolButton,
+  TabWidget,
+  ListView,
+  TableView,
+  TreeView,
+  GroupBox,
+  MenuBar,
+  ToolBar,
+  StatusBar,
+  Dialog,
+  Card,
+  Count
+};
+
+struct StyleSheetCacheEntry {
+  ThemeColors colors;
+  QString variant;
+  QString sheet;
+  bool valid = false;
+};
+
+struct StyleSheetCache {
+  QMutex mutex;
+  StyleSheetCacheEntry entries[int(StyleSheetId::Count)][2];
+  int recent[int(StyleSheetId::Count)] = {};
+  quint64 hits = 0;
+  quint64 misses = 0;
+};
+
+StyleSheetCache &styleSheetCache()
+{
+  static StyleSheetCache cache;
+  return cache;
+}
+
+bool sameColors(const ThemeColors &a, const ThemeColors &b)
+{
+  return a.accent == b.accent && a.text == b.text && a.subText == b.subText
+      && a.disabledText == b.disabledText && a.background == b.background
+      && a.surface == b.surface && a.border == b.border && a.hover == b.hover
+      && a.pressed == b.pressed && a.focus == b.focus && a.error == b.error;
+}
+
+QString cachedStyleSheet(StyleSheetId id,
+                         const ThemeColors &colors,
+                         QString (*build)(const ThemeColors &),
+                         const QString &variant = QString())
+{
+  StyleSheetCache &cache = styleSheetCache();
+  const int slot = int(id);
+  {
+    QMutexLocker locker(&cache.mutex);
+    for (int i = 0; i < 2; ++i) {
+      const StyleSheetCacheEntry &entry = cache.entries[slot][i];
+      if (entry.valid && entry.variant == variant && sameColors(entry.colors, colors)) {
+        ++cache.hits;
+        cache.recent[slot] = i;
+        return entry.sheet;
+      }
+    }
+    ++cache.misses;
+  }
+
+  // Build outside the lock; a concurrent miss just builds the same string twice.
+  const QString sheet = build(colors);
+
+  QMutexLocker locker(&cache.mutex);
+  const int victim = cache.entries[slot][0].valid ? 1 - cache.recent[slot] : 0;
+  StyleSheetCacheEntry &entry = cache.entries[slot][victim];
+  entry.colors = colors;
+  entry.variant = variant;
+  entry.sheet = sheet;
+  entry.valid = true;
+  cache.recent[slot] = victim;
+  return sheet;
+}
+
+QString buildBaseStyleSheet(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor tooltipFill = Style::mix(themeTokens.neutral.layer,
                                         themeTokens.accent.base,
                                         themeTokens.dark ? 0.16 : 0.07);
@@ -328,8 +432,8 @@ QString Theme::baseStyleSheet(const ThemeColors &colors) {
       .replace(QStringLiteral("__QTFLUENT_FONT_FAMILY__"), themeTokens.typography.family);
 }
 
-QString Theme::buttonStyle(const ThemeColors &colors, bool primary) {
-  const auto themeTokens = tokens(colors);
+QString buildButtonStyle(const ThemeColors &colors, bool primary) {
+  const auto themeTokens = Theme::tokens(colors);
   const auto enabled = ButtonVisuals::resolve(colors, themeTokens, primary, false, true);
   const auto disabled = ButtonVisuals::resolve(colors, themeTokens, primary, false, false);
   const QString background = enabled.base.name(QColor::HexArgb);
@@ -372,15 +476,15 @@ QString Theme::buttonStyle(const ThemeColors &colors, bool primary) {
       .arg(disabled.border.name(QColor::HexArgb));
 }
 
-QString Theme::labelStyle(const ThemeColors &colors) {
+QString buildLabelStyle(const ThemeColors &colors) {
   return QString("QLabel {"
                  "  color: %1;"
                  "}")
       .arg(colors.text.name(QColor::HexArgb));
 }
 
-QString Theme::lineEditStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildLineEditStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor fill = themeTokens.neutral.card;
   const QColor hover = Style::controlHoverFill(themeTokens);
   const QColor disabledFill = Style::mix(fill, themeTokens.neutral.background, themeTokens.dark ? 0.48 : 0.35);
@@ -422,8 +526,8 @@ QString Theme::lineEditStyle(const ThemeColors &colors) {
            disabledStroke.name(QColor::HexArgb));
 }
 
-QString Theme::textEditStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildTextEditStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor fill = themeTokens.neutral.card;
   const QColor hover = Style::controlHoverFill(themeTokens);
   const QColor disabledFill = Style::mix(fill, themeTokens.neutral.background, themeTokens.dark ? 0.48 : 0.35);
@@ -465,8 +569,8 @@ QString Theme::textEditStyle(const ThemeColors &colors) {
            disabledStroke.name(QColor::HexArgb));
 }
 
-QString Theme::dateTimeStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildDateTimeStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor fill = themeTokens.neutral.card;
   const QColor hover = Style::controlHoverFill(themeTokens);
   const QColor disabledFill = Style::mix(fill, themeTokens.neutral.background, themeTokens.dark ? 0.48 : 0.35);
@@ -524,8 +628,8 @@ QString Theme::dateTimeStyle(const ThemeColors &colors) {
            hover.name(QColor::HexArgb));
 }
 
-QString Theme::calendarPopupStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildCalendarPopupStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor fill = themeTokens.neutral.card;
   const QColor hover = Style::controlHoverFill(themeTokens);
   const QColor pressed = Style::mix(fill, themeTokens.neutral.fillTertiary, themeTokens.dark ? 0.42 : 0.34);
@@ -630,9 +734,9 @@ QString Theme::calendarPopupStyle(const ThemeColors &colors) {
            themeTokens.accent.base.name(QColor::HexArgb));
 }
 
-QString Theme::checkBoxStyle(const ThemeColors &colors) {
+QString buildCheckBoxStyle(const ThemeColors &colors) {
   ensureFluentThemeResourcesInitialized();
-  const auto themeTokens = tokens(colors);
+  const auto themeTokens = Theme::tokens(colors);
   const QColor fill = themeTokens.neutral.card;
   const QColor hover = Style::controlHoverFill(themeTokens);
   const QColor disabledFill = Style::mix(fill, themeTokens.neutral.background, themeTokens.dark ? 0.48 : 0.35);
@@ -682,8 +786,8 @@ QString Theme::checkBoxStyle(const ThemeColors &colors) {
            checkmarkIcon);
 }
 
-QString Theme::radioButtonStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildRadioButtonStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor fill = themeTokens.neutral.card;
   const QColor hover = Style::controlHoverFill(themeTokens);
   const QColor disabledFill = Style::mix(fill, themeTokens.neutral.background, themeTokens.dark ? 0.48 : 0.35);
@@ -739,8 +843,8 @@ QString Theme::radioButtonStyle(const ThemeColors &colors) {
            disabledCheckedFill);
 }
 
-QString Theme::toggleSwitchStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildToggleSwitchStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor unchecked = Style::mix(themeTokens.neutral.strokeSubtle, themeTokens.neutral.cardHover, themeTokens.dark ? 0.36 : 0.26);
   const QColor uncheckedHover = Style::mix(unchecked, themeTokens.neutral.strokeStrong, themeTokens.dark ? 0.30 : 0.18);
   const QColor checkedPressed = themeTokens.dark ? themeTokens.accent.light1 : themeTokens.accent.dark1;
@@ -800,8 +904,8 @@ QString Theme::toggleSwitchStyle(const ThemeColors &colors) {
            disabledStroke.name(QColor::HexArgb));
 }
 
-QString Theme::comboBoxStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildComboBoxStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor fill = themeTokens.neutral.card;
   const QColor hover = Style::controlHoverFill(themeTokens);
   const QColor pressed = Style::mix(fill, themeTokens.neutral.fillTertiary, themeTokens.dark ? 0.42 : 0.34);
@@ -877,8 +981,8 @@ QString Theme::comboBoxStyle(const ThemeColors &colors) {
            itemHover.name(QColor::HexArgb));
 }
 
-QString Theme::sliderStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildSliderStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor track = Style::mix(themeTokens.neutral.strokeSubtle, themeTokens.neutral.cardHover, themeTokens.dark ? 0.36 : 0.26);
   const QColor handle = themeTokens.dark
       ? Style::mix(themeTokens.neutral.card, colors.text, 0.72)
@@ -909,8 +1013,8 @@ QString Theme::sliderStyle(const ThemeColors &colors) {
            themeTokens.neutral.stroke.name(QColor::HexArgb));
 }
 
-QString Theme::progressBarStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildProgressBarStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor track = Style::mix(themeTokens.neutral.strokeSubtle, themeTokens.neutral.cardHover, themeTokens.dark ? 0.36 : 0.26);
   const QColor disabledTrack = themeTokens.neutral.strokeSubtle;
   QColor disabledFill = Style::mix(themeTokens.neutral.strokeStrong,
@@ -947,8 +1051,8 @@ QString Theme::progressBarStyle(const ThemeColors &colors) {
            disabledFill.name(QColor::HexArgb));
 }
 
-QString Theme::spinBoxStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildSpinBoxStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor fill = themeTokens.neutral.card;
   const QColor hover = Style::controlHoverFill(themeTokens);
   const QColor disabledFill = Style::mix(fill, themeTokens.neutral.background, themeTokens.dark ? 0.48 : 0.35);
@@ -985,8 +1089,8 @@ QString Theme::spinBoxStyle(const ThemeColors &colors) {
            disabledStroke.name(QColor::HexArgb));
 }
 
-QString Theme::toolButtonStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildToolButtonStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor fill = themeTokens.neutral.card;
   const QColor hover = Style::controlHoverFill(themeTokens);
   const QColor pressed = Style::mix(fill, themeTokens.neutral.fillTertiary, themeTokens.dark ? 0.42 : 0.34);
@@ -1025,8 +1129,8 @@ QString Theme::toolButtonStyle(const ThemeColors &colors) {
            disabledStroke.name(QColor::HexArgb));
 }
 
-QString Theme::tabWidgetStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildTabWidgetStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor hover = Style::controlHoverFill(themeTokens);
   const QColor pressed = Style::mix(themeTokens.neutral.card, themeTokens.neutral.fillTertiary, themeTokens.dark ? 0.42 : 0.34);
   return QString("QTabWidget::pane {"
@@ -1064,8 +1168,8 @@ QString Theme::tabWidgetStyle(const ThemeColors &colors) {
            colors.disabledText.name(QColor::HexArgb));
 }
 
-QString Theme::listViewStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildListViewStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   return QString("QListView {"
                  "  background: %1;"
                  "  color: %2;"
@@ -1101,8 +1205,8 @@ QString Theme::listViewStyle(const ThemeColors &colors) {
            Style::mix(themeTokens.neutral.strokeSubtle, colors.disabledText, themeTokens.dark ? 0.18 : 0.12).name(QColor::HexArgb));
 }
 
-QString Theme::tableViewStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildTableViewStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   return QString("QTableView, QTableWidget {"
                  "  background: %1;"
                  "  color: %2;"
@@ -1153,8 +1257,8 @@ QString Theme::tableViewStyle(const ThemeColors &colors) {
            Style::mix(themeTokens.neutral.strokeSubtle, colors.disabledText, themeTokens.dark ? 0.18 : 0.12).name(QColor::HexArgb));
 }
 
-QString Theme::treeViewStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildTreeViewStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   return QString("QTreeView {"
                  "  background: %1;"
                  "  color: %2;"
@@ -1210,8 +1314,8 @@ QString Theme::treeViewStyle(const ThemeColors &colors) {
            Style::mix(themeTokens.neutral.strokeSubtle, colors.disabledText, themeTokens.dark ? 0.18 : 0.12).name(QColor::HexArgb));
 }
 
-QString Theme::groupBoxStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildGroupBoxStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor disabledFill = Style::mix(themeTokens.neutral.card, themeTokens.neutral.background, themeTokens.dark ? 0.48 : 0.35);
   const QColor disabledStroke = Style::mix(themeTokens.neutral.strokeSubtle, colors.disabledText, themeTokens.dark ? 0.28 : 0.18);
   return QString("QGroupBox {"
@@ -1243,8 +1347,8 @@ QString Theme::groupBoxStyle(const ThemeColors &colors) {
            colors.text.name(QColor::HexArgb));
 }
 
-QString Theme::menuBarStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildMenuBarStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor fill = themeTokens.neutral.card;
   const QColor hover = Style::controlHoverFill(themeTokens);
   const QColor pressed =
@@ -1277,8 +1381,8 @@ QString Theme::menuBarStyle(const ThemeColors &colors) {
            colors.disabledText.name(QColor::HexArgb));
 }
 
-QString Theme::toolBarStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildToolBarStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor separator = themeTokens.neutral.strokeSubtle;
   const QColor fill = themeTokens.neutral.card;
   const QColor hover = Style::controlHoverFill(themeTokens);
@@ -1310,8 +1414,8 @@ QString Theme::toolBarStyle(const ThemeColors &colors) {
            hover.name(QColor::HexArgb));
 }
 
-QString Theme::statusBarStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildStatusBarStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   return QString("QStatusBar {"
                  "  background: %1;"
                  "  color: %2;"
@@ -1330,8 +1434,8 @@ QString Theme::statusBarStyle(const ThemeColors &colors) {
            themeTokens.neutral.strokeSubtle.name(QColor::HexArgb));
 }
 
-QString Theme::dialogStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildDialogStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor modalFill = themeTokens.dark
       ? Style::mix(themeTokens.neutral.card, colors.text, 0.095)
       : themeTokens.neutral.card;
@@ -1353,8 +1457,8 @@ QString Theme::dialogStyle(const ThemeColors &colors) {
       .arg(themeTokens.radius.window);
 }
 
-QString Theme::cardStyle(const ThemeColors &colors) {
-  const auto themeTokens = tokens(colors);
+QString buildCardStyle(const ThemeColors &colors) {
+  const auto themeTokens = Theme::tokens(colors);
   const QColor disabledFill = Style::mix(themeTokens.neutral.card, themeTokens.neutral.background, themeTokens.dark ? 0.48 : 0.35);
   const QColor disabledStroke = Style::mix(themeTokens.neutral.strokeSubtle, colors.disabledText, themeTokens.dark ? 0.28 : 0.18);
   return QString("QWidget#FluentCard {"
@@ -1373,6 +1477,138 @@ QString Theme::cardStyle(const ThemeColors &colors) {
            disabledStroke.name(QColor::HexArgb));
 }
 
+} // namespace
+
+QString Theme::baseStyleSheet(const ThemeColors &colors) {
+  // The font family follows the default QLocale, so it is part of the key.
+  return cachedStyleSheet(StyleSheetId::Base, colors, buildBaseStyleSheet, fluentFontFamily());
+}
+
+QString Theme::buttonStyle(const ThemeColors &colors, bool primary) {
+  if (primary) {
+    return cachedStyleSheet(StyleSheetId::PrimaryButton, colors, [](const ThemeColors &c) { return buildButtonStyle(c, true); });
+  }
+  return cachedStyleSheet(StyleSheetId::Button, colors, [](const ThemeColors &c) { return buildButtonStyle(c, false); });
+}
+
+QString Theme::labelStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::Label, colors, buildLabelStyle);
+}
+
+QString Theme::lineEditStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::LineEdit, colors, buildLineEditStyle);
+}
+
+QString Theme::textEditStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::TextEdit, colors, buildTextEditStyle);
+}
+
+QString Theme::dateTimeStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::DateTime, colors, buildDateTimeStyle);
+}
+
+QString Theme::calendarPopupStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::CalendarPopup, colors, buildCalendarPopupStyle);
+}
+
+QString Theme::checkBoxStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::CheckBox, colors, buildCheckBoxStyle);
+}
+
+QString Theme::radioButtonStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::RadioButton, colors, buildRadioButtonStyle);
+}
+
+QString Theme::toggleSwitchStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::ToggleSwitch, colors, buildToggleSwitchStyle);
+}
+
+QString Theme::comboBoxStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::ComboBox, colors, buildComboBoxStyle);
+}
+
+QString Theme::sliderStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::Slider, colors, buildSliderStyle);
+}
+
+QString Theme::progressBarStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::ProgressBar, colors, buildProgressBarStyle);
+}
+
+QString Theme::spinBoxStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::SpinBox, colors, buildSpinBoxStyle);
+}
+
+QString Theme::toolButtonStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::ToolButton, colors, buildToolButtonStyle);
+}
+
+QString Theme::tabWidgetStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::TabWidget, colors, buildTabWidgetStyle);
+}
+
+QString Theme::listViewStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::ListView, colors, buildListViewStyle);
+}
+
+QString Theme::tableViewStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::TableView, colors, buildTableViewStyle);
+}
+
+QString Theme::treeViewStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::TreeView, colors, buildTreeViewStyle);
+}
+
+QString Theme::groupBoxStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::GroupBox, colors, buildGroupBoxStyle);
+}
+
+QString Theme::menuBarStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::MenuBar, colors, buildMenuBarStyle);
+}
+
+QString Theme::toolBarStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::ToolBar, colors, buildToolBarStyle);
+}
+
+QString Theme::statusBarStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::StatusBar, colors, buildStatusBarStyle);
+}
+
+QString Theme::dialogStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::Dialog, colors, buildDialogStyle);
+}
+
+QString Theme::cardStyle(const ThemeColors &colors) {
+  return cachedStyleSheet(StyleSheetId::Card, colors, buildCardStyle);
+}
+
+StyleSheetCacheStats Theme::styleSheetCacheStats() {
+  StyleSheetCache &cache = styleSheetCache();
+  QMutexLocker locker(&cache.mutex);
+  StyleSheetCacheStats stats;
+  stats.hits = cache.hits;
+  stats.misses = cache.misses;
+  return stats;
+}
+
+void Theme::resetStyleSheetCacheStats() {
+  StyleSheetCache &cache = styleSheetCache();
+  QMutexLocker locker(&cache.mutex);
+  cache.hits = 0;
+  cache.misses = 0;
+}
+
+void Theme::clearStyleSheetCache() {
+  StyleSheetCache &cache = styleSheetCache();
+  QMutexLocker locker(&cache.mutex);
+  for (auto &row : cache.entries) {
+    for (auto &entry : row) {
+      entry = StyleSheetCacheEntry();
+    }
+  }
+}
+
 ThemeManager &ThemeManager::instance() {
   static ThemeManager instance;
   return instance;
@@ -1487,10 +1723,10 @@ void ThemeManager::scheduleThemeChanged(const QString &reason)
       m_themeChangeReason += QStringLiteral(", ");
       m_themeChangeReason += nextReason;
     }
-    qInfo().noquote() << QStringLiteral("[ThemeSwitch] #%1 coalesced %2 after %3 ms")
-                             .arg(m_themeChangeSequence)
-                             .arg(nextReason)
-                             .arg(m_themeChangeTimer.isValid() ? m_themeChangeTimer.elapsed() : 0);
+    qCInfo(Diagnostics::themeSwitchLog).noquote() << QStringLiteral("[ThemeSwitch] #%1 coalesced %2 after %3 ms")
+                                                         .arg(m_themeChangeSequence)
+                                                         .arg(nextReason)
+                                                         .arg(m_themeChangeTimer.isValid() ? m_themeChangeTimer.elapsed() : 0);
     return;
   }
 
@@ -1499,19 +1735,19 @@ void ThemeManager::scheduleThemeChanged(const QString &reason)
   m_themeChangeTimer.restart();
   const int sequence = ++m_themeChangeSequence;
 
-  qInfo().noquote() << QStringLiteral("[ThemeSwitch] #%1 scheduled: %2, mode=%3, accent=%4")
-                           .arg(sequence)
-                           .arg(m_themeChangeReason)
-                           .arg(themeModeName(m_mode))
-                           .arg(m_colors.accent.name());
+  qCInfo(Diagnostics::themeSwitchLog).noquote() << QStringLiteral("[ThemeSwitch] #%1 scheduled: %2, mode=%3, accent=%4")
+                                                       .arg(sequence)
+                                                       .arg(m_themeChangeReason)
+                                                       .arg(themeModeName(m_mode))
+                                                       .arg(m_colors.accent.name());
 
   // Coalesce multiple changes and avoid blocking the current UI event.
   QTimer::singleShot(0, this, [this, sequence]() {
     const QString reason = m_themeChangeReason;
-    qInfo().noquote() << QStringLiteral("[ThemeSwitch] #%1 dispatch begin after %2 ms: %3")
-                             .arg(sequence)
-                             .arg(m_themeChangeTimer.isValid() ? m_themeChangeTimer.elapsed() : 0)
-                             .arg(reason);
+    qCInfo(Diagnostics::themeSwitchLog).noquote() << QStringLiteral("[ThemeSwitch] #%1 dispatch begin after %2 ms: %3")
+                                                         .arg(sequence)
+                                                         .arg(m_themeChangeTimer.isValid() ? m_themeChangeTimer.elapsed() : 0)
+                                                         .arg(reason);
 
     QElapsedTimer dispatchTimer;
     dispatchTimer.start();
@@ -1520,16 +1756,31 @@ void ThemeManager::scheduleThemeChanged(const QString &reason)
       QElapsedTimer blockerTimer;
       blockerTimer.start();
       UpdatesBlocker updatesBlocker;
-      qInfo().noquote() << QStringLiteral("[ThemeSwitch] #%1 updates blocked for %2 top-level widgets +%3 ms")
-                               .arg(sequence)
-                               .arg(updatesBlocker.widgets.size())
-                               .arg(blockerTimer.elapsed());
+      qCInfo(Diagnostics::themeSwitchLog).noquote() << QStringLiteral("[ThemeSwitch] #%1 updates blocked for %2 top-level widgets +%3 ms")
+                                                           .arg(sequence)
+                                                           .arg(updatesBlocker.widgets.size())
+                                                           .arg(blockerTimer.elapsed());
+      QElapsedTimer emitTimer;
+      emitTimer.start();
+      ThemeProfiler::beginDispatch();
       emit themeChanged();
+      // Enrolled widgets run after the remaining signal receivers, which keeps
+      // application-level handlers (palette, window chrome) ahead of controls.
+      const ThemeRegistry::DispatchStats registryStats = ThemeRegistry::dispatch();
+      ThemeProfiler::endDispatch(emitTimer.nsecsElapsed());
+      qCInfo(Diagnostics::themeSwitchLog).noquote() << QStringLiteral("[ThemeSwitch] #%1 registry themed %2 widgets (%3 visible, %4 clipped) in %5 class batches, %6 hidden deferred, %7 ms")
+                                                           .arg(sequence)
+                                                           .arg(registryStats.applied)
+                                                           .arg(registryStats.visible)
+                                                           .arg(registryStats.offscreen)
+                                                           .arg(registryStats.batches)
+                                                           .arg(registryStats.deferred)
+                                                           .arg(registryStats.elapsedNs / 1000000.0, 0, 'f', 2);
     }
-    qInfo().noquote() << QStringLiteral("[ThemeSwitch] #%1 dispatch done +%2 ms, total %3 ms")
-                             .arg(sequence)
-                             .arg(dispatchTimer.elapsed())
-                             .arg(m_themeChangeTimer.isValid() ? m_themeChangeTimer.elapsed() : dispatchTimer.elapsed());
+    qCInfo(Diagnostics::themeSwitchLog).noquote() << QStringLiteral("[ThemeSwitch] #%1 dispatch done +%2 ms, total %3 ms")
+                                                         .arg(sequence)
+                                                         .arg(dispatchTimer.elapsed())
+                                                         .arg(m_themeChangeTimer.isValid() ? m_themeChangeTimer.elapsed() : dispatchTimer.elapsed());
   });
 }
 
@@ -0,0 +1,295 @@
+#include "FluentThemeRegistry_p.h"
+
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QHash>
+#include <QMetaObject>
+#include <QObject>
+#include <QVarLengthArray>
+#include <QVector>
+#include <QWidget>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace Fluent {
+namespace ThemeRegistry {
+
+namespace {
+
+struct Receiver {
+    QWidget *widget = nullptr;
+    QVarLengthArray<ApplyFn, 1> hooks;
+    quint64 order = 0;
+    bool pending = false;
+};
+
+// Hidden widgets of a shown window (stacked pages, collapsed panes, closed
+// popups hosted in the window) are the bulk of a large UI and can wait for
+// their next show. Widgets of a hidden window are themed right away: nothing
+// announces when such a window is inspected or grabbed.
+bool deferrable(const QWidget *widget)
+{
+    if (widget->isWindow() || widget->isVisible()) {
+        return false;
+    }
+    const QWidget *window = widget->window();
+    return window && window->isVisible();
+}
+
+class Registry final : public QObject
+{
+public:
+    Registry()
+    {
+        setObjectName(QStringLiteral("FluentThemeRegistry"));
+    }
+
+    QHash<const QObject *, Receiver> receivers;
+    DispatchStats last;
+    quint64 nextOrder = 0;
+    int pendingCount = 0;
+    bool deferHidden = true;
+
+    void drop(const QObject *object)
+    {
+        const auto it = receivers.constFind(object);
+        if (it == receivers.constEnd()) {
+            return;
+        }
+        if (it->pending) {
+            --pendingCount;
+        }
+        receivers.erase(it);
+    }
+
+    // Only pending widgets carry the filter, so the rest of the application's
+    // events never pass through the registry.
+    void markPending(Receiver &receiver)
+    {
+        if (!receiver.pending) {
+            receiver.pending = true;
+            ++pendingCount;
+            receiver.widget->installEventFilter(this);
+        }
+    }
+
+    // Returns false when the widget is no longer enrolled.
+    bool apply(const QObject *object)
+    {
+        const auto it = receivers.find(object);
+        if (it == receivers.end()) {
+            return false;
+        }
+        QWidget *widget = it->widget;
+        if (it->pending) {
+            it->pending = false;
+            --pendingCount;
+            widget->removeEventFilter(this);
+        }
+        // A hook may create or destroy enrolled widgets, so work on a copy.
+        const QVarLengthArray<ApplyFn, 1> hooks = it->hooks;
+        for (ApplyFn hook : hooks) {
+            hook(widget);
+        }
+        return true;
+    }
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        switch (event->type()) {
+        case QEvent::Show:
+        case QEvent::Polish:
+        case QEvent::Paint:
+            if (watched->isWidgetType()) {
+                const auto it = receivers.constFind(watched);
+                if (it != receivers.constEnd() && it->pending) {
+                    apply(watched);
+                }
+            }
+            break;
+        default:
+            break;
+        }
+        return QObject::eventFilter(watched, event);
+    }
+};
+
+Registry &registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+} // namespace
+
+void enroll(QWidget *widget, ApplyFn apply)
+{
+    if (!widget || !apply) {
+        return;
+    }
+
+    Registry &r = registry();
+    auto it = r.receivers.find(widget);
+    if (it == r.receivers.end()) {
+        Receiver receiver;
+        receiver.widget = widget;
+        receiver.order = r.nextOrder++;
+        it = r.receivers.insert(widget, receiver);
+        QObject::connect(widget, &QObject::destroyed, &r, [](QObject *object) {
+            registry().drop(object);
+        });
+    }
+    if (std::find(it->hooks.cbegin(), it->hooks.cend(), apply) == it->hooks.cend()) {
+        it->hooks.append(apply);
+    }
+}
+
+DispatchStats dispatch()
+{
+    Registry &r = registry();
+    QElapsedTimer timer;
+    timer.start();
+
+    struct Item {
+        const QObject *key = nullptr;
+        const QMetaObject *meta = nullptr;
+        quint64 order = 0;
+        int tier = 0;
+        int rank = 0;
+    };
+
+    DispatchStats stats;
+    std::vector<Item> items;
+    items.reserve(static_cast<size_t>(r.receivers.size()));
+    for (auto it = r.receivers.begin(); it != r.receivers.end(); ++it) {
+        QWidget *widget = it->widget;
+        if (r.deferHidden && deferrable(widget)) {
+            r.markPending(*it);
+            ++stats.deferred;
+            continue;
+        }
+
+        Item item;
+        item.key = it.key();
+        item.meta = widget->metaObject();
+        item.order = it->order;
+        if (!widget->isVisible()) {
+            item.tier = 2;
+        } else if (widget->visibleRegion().isEmpty()) {
+            item.tier = 1;
+        }
+        items.push_back(item);
+    }
+
+    // Classes keep the order in which they first enrolled; instances keep
+    // their own enrollment order inside a batch.
+    std::sort(items.begin(), items.end(), [](const Item &a, const Item &b) {
+        return a.order < b.order;
+    });
+    QHash<const QMetaObject *, int> ranks;
+    for (Item &item : items) {
+        const auto rank = ranks.constFind(item.meta);
+        if (rank == ranks.constEnd()) {
+            item.rank = static_cast<int>(ranks.size());
+            ranks.insert(item.meta, item.rank);
+        } else {
+            item.rank = rank.value();
+        }
+    }
+    std::stable_sort(items.begin(), items.end(), [](const Item &a, const Item &b) {
+        if (a.tier != b.tier) {
+            return a.tier < b.tier;
+        }
+        return a.rank < b.rank;
+    });
+
+    const QMetaObject *batchMeta = nullptr;
+    int batchTier = -1;
+    for (const Item &item : items) {
+        if (item.meta != batchMeta || item.tier != batchTier) {
+            batchMeta = item.meta;
+            batchTier = item.tier;
+            ++stats.batches;
+        }
+        if (!r.apply(item.key)) {
+            continue;
+        }
+        ++stats.applied;
+        if (item.tier == 0) {
+            ++stats.visible;
+        } else if (item.tier == 1) {
+            ++stats.offscreen;
+        }
+    }
+
+    stats.elapsedNs = timer.nsecsElapsed();
+    r.last = stats;
+    return stats;
+}
+
+DispatchStats lastDispatch()
+{
+    return registry().last;
+}
+
+int enrolledCount()
+{
+    return static_cast<int>(registry().receivers.size());
+}
+
+int pendingCount()
+{
+    return registry().pendingCount;
+}
+
+bool isPending(const QWidget *widget)
+{
+    const Registry &r = registry();
+    const auto it = r.receivers.constFind(widget);
+    return it != r.receivers.constEnd() && it->pending;
+}
+
+void flush(QWidget *widget)
+{
+    if (!isPending(widget)) {
+        return;
+    }
+    registry().apply(widget);
+}
+
+void flushAll()
+{
+    Registry &r = registry();
+    QVector<const QObject *> pending;
+    for (auto it = r.receivers.cbegin(); it != r.receivers.cend(); ++it) {
+        if (it->pending) {
+            pending.push_back(it.key());
+        }
+    }
+    for (const QObject *key : std::as_const(pending)) {
+        r.apply(key);
+    }
+}
+
+void setDeferHiddenEnabled(bool enabled)
+{
+    Registry &r = registry();
+    if (r.deferHidden == enabled) {
+        return;
+    }
+    r.deferHidden = enabled;
+    if (!enabled) {
+        flushAll();
+    }
+}
+
+bool deferHiddenEnabled()
+{
+    return registry().deferHidden;
+}
+
+} // namespace ThemeRegistry
+} // namespace Fluent
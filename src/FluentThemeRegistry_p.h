@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QtGlobal>
+
+class QWidget;
+
+namespace Fluent {
+namespace ThemeRegistry {
+
+// Theme hook of one enrolled widget; receives the widget it was enrolled with.
+using ApplyFn = void (*)(QWidget *widget);
+
+// Enrolls widget so ThemeManager re-themes it through apply() on every theme
+// change, instead of a themeChanged connection per instance. A widget may
+// enroll several hooks (a base and a derived class); they run in enrollment
+// order. The entry is dropped when the widget is destroyed.
+void enroll(QWidget *widget, ApplyFn apply);
+
+// enroll<&FluentButton::applyTheme>(this)
+template <auto Apply, typename Widget>
+void enroll(Widget *widget)
+{
+    enroll(widget, [](QWidget *target) {
+        (static_cast<Widget *>(target)->*Apply)();
+    });
+}
+
+struct DispatchStats {
+    int applied = 0;   // widgets themed during the dispatch
+    int visible = 0;   // ...of which had a non-empty visible region
+    int offscreen = 0; // ...of which were shown but clipped away (scrolled out)
+    int deferred = 0;  // hidden widgets in a shown window, left pending
+    int batches = 0;   // runs of one widget class
+    qint64 elapsedNs = 0;
+};
+
+// Called by ThemeManager inside the themeChanged dispatch, after the signal's
+// receivers. Visible widgets are themed first, then clipped ones, then widgets
+// of hidden windows, each tier grouped by class. Hidden widgets inside a shown
+// window are only marked pending; an event filter on each of them themes it on
+// its next Show, Polish or Paint.
+DispatchStats dispatch();
+DispatchStats lastDispatch();
+
+int enrolledCount();
+int pendingCount();
+bool isPending(const QWidget *widget);
+
+// Themes a pending widget now; no-op when it is already current.
+void flush(QWidget *widget);
+void flushAll();
+
+// Off => every enrolled widget is themed inside dispatch(), like a direct connection.
+void setDeferHiddenEnabled(bool enabled);
+bool deferHiddenEnabled();
+
+} // namespace ThemeRegistry
+} // namespace Fluent
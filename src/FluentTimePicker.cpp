@@ -3,6 +3,8 @@
 #include "Fluent/FluentMotion.h"
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 #include "FluentInputVisuals_p.h"
 #include "datePicker/FluentWheelPickerSupport.h"
 
@@ -98,7 +100,7 @@ FluentTimePicker::FluentTimePicker(QWidget *parent)
     });
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentTimePicker::applyTheme);
+    ThemeRegistry::enroll<&FluentTimePicker::applyTheme>(this);
 }
 
 FluentTimePicker::~FluentTimePicker() = default;
@@ -287,6 +289,8 @@ void FluentTimePicker::changeEvent(QEvent *event)
 
 void FluentTimePicker::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool focusRunning = m_focusAnim && m_focusAnim->state() == QAbstractAnimation::Running;
     const QVariant hoverEnd = m_hoverAnim ? m_hoverAnim->endValue() : QVariant();
@@ -306,9 +310,7 @@ void FluentTimePicker::applyTheme()
     const QString next = QStringLiteral("QTimeEdit { background: transparent; color: transparent; border: none; }"
                                         "QTimeEdit::up-button, QTimeEdit::down-button { width: 0px; border: none; }"
                                         "QTimeEdit::up-arrow, QTimeEdit::down-arrow { width: 0px; height: 0px; }");
-    if (styleSheet() != next) {
-        setStyleSheet(next);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(this, next);
 
     ensureEditorHidden();
     if (m_popup) {
@@ -4,10 +4,11 @@
 #include "Fluent/FluentMotion.h"
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentFadeLayer_p.h"
 
 #include <QApplication>
 #include <QEvent>
-#include <QGraphicsOpacityEffect>
 #include <QHash>
 #include <QHBoxLayout>
 #include <QLabel>
@@ -16,11 +17,12 @@
 #include <QParallelAnimationGroup>
 #include <QPointer>
 #include <QPropertyAnimation>
-#include <QTimer>
 #include <QVariantAnimation>
 #include <QVector>
 #include <QVBoxLayout>
 
+#include <utility>
+
 namespace Fluent {
 
 namespace {
@@ -30,6 +32,16 @@ constexpr int kToastMargin = 16;
 constexpr int kToastSpacing = 10;
 
 constexpr int kToastMinHeight = 64;
+constexpr int kToastBadgeReserve = 44;
+
+constexpr int kDefaultMaxVisibleToasts = 5;
+// Idle toast widgets an overlay keeps for reuse by later bursts.
+constexpr int kToastPoolLimit = 8;
+
+int g_maxVisibleToasts[6] = {
+    kDefaultMaxVisibleToasts, kDefaultMaxVisibleToasts, kDefaultMaxVisibleToasts,
+    kDefaultMaxVisibleToasts, kDefaultMaxVisibleToasts, kDefaultMaxVisibleToasts,
+};
 
 static int positionIndex(FluentToast::Position p)
 {
@@ -95,7 +107,16 @@ static int moveDurationFor(FluentToast::Position p)
     return base;
 }
 
-class ToastOverlay final : public QWidget
+} // namespace
+
+// Hosts the toasts of one window. showToast() only records a request here:
+// a request with the same title and message as a shown (or queued) toast is
+// coalesced into it with a repeat count, requests beyond the per-position cap
+// wait in a queue, and one pass per event-loop turn promotes queued requests,
+// recycles idle widgets from a small pool and relayouts once. A burst of posts
+// therefore costs one layout, one mask update and at most one move animation
+// per shown toast, however many toasts were posted.
+class FluentToast::ToastOverlay final : public QWidget
 {
 public:
     explicit ToastOverlay(QWidget *window)
@@ -115,6 +136,7 @@ public:
         }
 
         m_toastsByPos.resize(6);
+        m_pendingByPos.resize(6);
 
         connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, [this]() {
             for (const auto &list : m_toastsByPos) {
@@ -134,12 +156,9 @@ public:
 
     ~ToastOverlay() override
     {
-        for (const auto &list : m_toastsByPos) {
-            for (auto t : list) {
-                if (t) {
-                    disconnect(t, nullptr, this, nullptr);
-                }
-            }
+        const auto toasts = findChildren<FluentToast *>(QString(), Qt::FindDirectChildrenOnly);
+        for (auto *t : toasts) {
+            disconnect(t, nullptr, this, nullptr);
         }
 
         const auto animations = findChildren<QPropertyAnimation *>(QString(), Qt::FindDirectChildrenOnly);
@@ -152,40 +171,57 @@ public:
         m_moveAnims.clear();
     }
 
-    void addToast(FluentToast *toast, FluentToast::Position position)
+    static ToastOverlay *ensure(QWidget *window)
     {
-        if (!toast) {
-            return;
+        if (!window) {
+            return nullptr;
         }
 
-        toast->setParent(this);
-        stabilizeToastSize(toast);
+        // Avoid qobject_cast here: it requires Q_OBJECT on ToastOverlay.
+        // We keep ToastOverlay as a lightweight internal widget.
+        for (QObject *child : window->children()) {
+            if (!child || child->objectName() != QLatin1String("FluentToastOverlay")) {
+                continue;
+            }
+            if (auto *overlay = dynamic_cast<ToastOverlay *>(child)) {
+                return overlay;
+            }
+        }
 
-        const int idx = positionIndex(position);
-        m_toastsByPos[idx].prepend(toast);
+        auto *overlay = new ToastOverlay(window);
+        overlay->setGeometry(window->rect());
+        overlay->show();
 
-        // For the newest toast, we anchor it directly (it does not depend on other toasts)
-        // and apply an entrance offset to differentiate animations per position.
-        const QPoint targetPos = anchorPos(position, qMax(toast->height(), kToastMinHeight));
-        toast->move(targetPos + enterOffsetFor(position));
-        toast->show();
+        return overlay;
+    }
 
-        connect(toast, &QObject::destroyed, this, [this, toast]() {
-            if (auto anim = m_moveAnims.take(toast)) {
-                anim->stop();
-                anim->deleteLater();
+    void post(const QString &title, const QString &message, FluentToast::Position position, int durationMs)
+    {
+        const int idx = positionIndex(position);
+
+        for (const auto &t : std::as_const(m_toastsByPos[idx])) {
+            if (t && !t->m_dismissing && t->m_title == title && t->m_message == message) {
+                const bool badgeAppears = t->m_repeatCount == 1;
+                t->repeat(durationMs);
+                if (badgeAppears) {
+                    // The badge narrows the title; re-measure in the next pass.
+                    m_unsettled.append(t);
+                    queueFrame();
+                }
+                return;
             }
-        });
+        }
 
-        connect(toast, &FluentToast::dismissed, this, [this, toast]() {
-            for (auto &list : m_toastsByPos) {
-                list.removeAll(toast);
+        for (PendingToast &pending : m_pendingByPos[idx]) {
+            if (pending.title == title && pending.message == message) {
+                ++pending.repeatCount;
+                pending.durationMs = qMax(pending.durationMs, durationMs);
+                return;
             }
-            layoutToasts(true);
-        });
+        }
 
-        layoutToasts(true);
-        queueLayoutToasts();
+        m_pendingByPos[idx].append({title, message, durationMs, 1});
+        queueFrame();
     }
 
 protected:
@@ -214,6 +250,13 @@ protected:
     }
 
 private:
+    struct PendingToast {
+        QString title;
+        QString message;
+        int durationMs = 0;
+        int repeatCount = 1;
+    };
+
     QPoint anchorPos(FluentToast::Position position, int toastHeight) const
     {
         int x = 0;
@@ -254,7 +297,8 @@ private:
             const QMargins m = lay->contentsMargins();
             const int textW = qMax(120, kToastWidth - m.left() - m.right());
             if (auto *title = toast->findChild<QLabel *>(QStringLiteral("FluentToastTitle"))) {
-                title->setFixedWidth(textW);
+                // Leave room for the repeat badge painted at the end of the title line.
+                title->setFixedWidth(toast->m_repeatCount > 1 ? textW - kToastBadgeReserve : textW);
                 title->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Preferred);
             }
             if (auto *msg = toast->findChild<QLabel *>(QStringLiteral("FluentToastMessage"))) {
@@ -271,25 +315,130 @@ private:
         toast->setFixedHeight(h);
     }
 
-    void queueLayoutToasts()
+    void queueFrame()
     {
-        if (m_layoutQueued) {
+        if (m_frameQueued) {
             return;
         }
-        m_layoutQueued = true;
-        QTimer::singleShot(0, this, [this]() {
-            m_layoutQueued = false;
-            // After the event loop runs, polish/stylesheet/font propagation is settled.
-            // Re-stabilize sizes and relayout once to eliminate occasional extra-line jumps.
-            for (auto &list : m_toastsByPos) {
-                for (auto t : list) {
-                    if (t) {
-                        stabilizeToastSize(t);
-                    }
+        m_frameQueued = true;
+        QMetaObject::invokeMethod(this, [this]() { runFrame(); }, Qt::QueuedConnection);
+    }
+
+    void runFrame()
+    {
+        m_frameQueued = false;
+
+        // Toasts added by the previous pass are measured again now that polish,
+        // stylesheet and font propagation have settled, which eliminates the
+        // occasional extra-line jump of word-wrapped labels.
+        const auto unsettled = m_unsettled;
+        m_unsettled.clear();
+        for (const auto &t : unsettled) {
+            if (t) {
+                stabilizeToastSize(t);
+            }
+        }
+
+        QList<QPair<QPointer<FluentToast>, int>> started;
+        for (int idx = 0; idx < m_pendingByPos.size(); ++idx) {
+            auto &pending = m_pendingByPos[idx];
+            if (pending.isEmpty()) {
+                continue;
+            }
+
+            const int cap = g_maxVisibleToasts[idx];
+            int active = 0;
+            for (const auto &t : std::as_const(m_toastsByPos[idx])) {
+                if (t && !t->m_dismissing) {
+                    ++active;
                 }
             }
-            layoutToasts(true);
+
+            while (!pending.isEmpty() && (cap <= 0 || active < cap)) {
+                const PendingToast request = pending.takeFirst();
+                FluentToast *toast = acquireToast(request.title, request.message);
+                toast->m_repeatCount = request.repeatCount;
+                addToast(toast, static_cast<FluentToast::Position>(idx));
+                started.append({toast, request.durationMs});
+                ++active;
+            }
+        }
+
+        layoutToasts(true);
+
+        for (const auto &entry : std::as_const(started)) {
+            if (entry.first) {
+                entry.first->start(entry.second);
+            }
+        }
+    }
+
+    FluentToast *acquireToast(const QString &title, const QString &message)
+    {
+        while (!m_pool.isEmpty()) {
+            const QPointer<FluentToast> pooled = m_pool.takeLast();
+            if (pooled) {
+                pooled->reset(title, message);
+                return pooled;
+            }
+        }
+
+        auto *toast = new FluentToast(title, message, this);
+        toast->m_pooled = true;
+
+        connect(toast, &QObject::destroyed, this, [this, toast]() {
+            if (auto anim = m_moveAnims.take(toast)) {
+                anim->stop();
+                anim->deleteLater();
+            }
         });
+
+        connect(toast, &FluentToast::dismissed, this, [this, toast]() {
+            for (auto &list : m_toastsByPos) {
+                list.removeAll(toast);
+            }
+            m_unsettled.removeAll(toast);
+            releaseToast(toast);
+            queueFrame();
+        });
+
+        return toast;
+    }
+
+    void releaseToast(FluentToast *toast)
+    {
+        if (auto anim = m_moveAnims.take(toast)) {
+            anim->stop();
+            anim->deleteLater();
+        }
+
+        toast->hide();
+        toast->stopAnimations();
+        if (m_pool.size() < kToastPoolLimit) {
+            m_pool.append(toast);
+        } else {
+            toast->deleteLater();
+        }
+    }
+
+    void addToast(FluentToast *toast, FluentToast::Position position)
+    {
+        if (toast->parentWidget() != this) {
+            toast->setParent(this);
+        }
+        stabilizeToastSize(toast);
+
+        const int idx = positionIndex(position);
+        m_toastsByPos[idx].prepend(toast);
+
+        // For the newest toast, we anchor it directly (it does not depend on other toasts)
+        // and apply an entrance offset to differentiate animations per position.
+        const QPoint targetPos = anchorPos(position, qMax(toast->height(), kToastMinHeight));
+        toast->move(targetPos + enterOffsetFor(position));
+        toast->show();
+
+        m_unsettled.append(toast);
+        queueFrame();
     }
 
     void snapMoveAnimations()
@@ -312,6 +461,19 @@ private:
         m_moveAnims.clear();
     }
 
+    void updateMask(const QRegion &region)
+    {
+        if (region == m_maskRegion) {
+            return;
+        }
+        m_maskRegion = region;
+        if (region.isEmpty()) {
+            clearMask();
+        } else {
+            setMask(region);
+        }
+    }
+
     void layoutToasts(bool animated)
     {
         bool anyToast = false;
@@ -321,7 +483,7 @@ private:
         }
 
         if (!anyToast) {
-            clearMask();
+            updateMask(QRegion());
             // Do not block interaction when there are no toasts.
             setAttribute(Qt::WA_TransparentForMouseEvents, true);
             return;
@@ -340,6 +502,7 @@ private:
 
             const auto position = static_cast<FluentToast::Position>(posIdx);
             const bool top = isTopPosition(position);
+            const int duration = animated ? moveDurationFor(position) : 0;
 
             int y = top ? kToastMargin : (height() - kToastMargin);
             const int x = anchorPos(position, kToastMinHeight).x();
@@ -361,28 +524,34 @@ private:
                     y -= kToastSpacing;
                 }
 
-                if (!animated || t->pos() == targetPos) {
-                    t->move(targetPos);
-                } else {
-                    const int duration = moveDurationFor(position);
-                    if (duration <= 0) {
-                        t->move(targetPos);
-                        continue;
+                QPointer<QPropertyAnimation> running = m_moveAnims.value(t);
+                if (running && running->state() != QAbstractAnimation::Running) {
+                    running = nullptr;
+                }
+                if (duration <= 0) {
+                    if (running) {
+                        running->stop();
                     }
-
-                    // Cancel any previous queued move animation for this toast.
-                    if (auto prev = m_moveAnims.value(t)) {
-                        prev->stop();
-                        prev->deleteLater();
+                    t->move(targetPos);
+                } else if (running) {
+                    // Retarget the running move instead of allocating a new animation.
+                    if (running->endValue().toPoint() != targetPos) {
+                        running->setDuration(duration);
+                        running->setStartValue(t->pos());
+                        running->setEndValue(targetPos);
+                        running->setCurrentTime(0);
                     }
-
+                } else if (t->pos() != targetPos) {
                     auto *anim = new QPropertyAnimation(t, "pos", this);
                     anim->setDuration(duration);
                     anim->setStartValue(t->pos());
                     anim->setEndValue(targetPos);
                     anim->setEasingCurve(FluentMotion::easing(FluentMotionRole::Toast));
                     connect(anim, &QObject::destroyed, this, [this, t]() {
-                        m_moveAnims.remove(t);
+                        // Only drop the entry if it has not been replaced by a newer move.
+                        if (!m_moveAnims.value(t)) {
+                            m_moveAnims.remove(t);
+                        }
                     });
                     m_moveAnims.insert(t, anim);
                     anim->start(QAbstractAnimation::DeleteWhenStopped);
@@ -393,11 +562,7 @@ private:
             }
         }
 
-        if (region.isEmpty()) {
-            clearMask();
-        } else {
-            setMask(region);
-        }
+        updateMask(region);
 
         // Ensure visible above central widgets.
         raise();
@@ -405,36 +570,14 @@ private:
 
     QPointer<QWidget> m_window;
     QVector<QList<QPointer<FluentToast>>> m_toastsByPos;
+    QVector<QList<PendingToast>> m_pendingByPos;
+    QList<QPointer<FluentToast>> m_pool;
+    QList<QPointer<FluentToast>> m_unsettled;
     QHash<FluentToast *, QPointer<QPropertyAnimation>> m_moveAnims;
-    bool m_layoutQueued = false;
+    QRegion m_maskRegion;
+    bool m_frameQueued = false;
 };
 
-static ToastOverlay *ensureOverlay(QWidget *window)
-{
-    if (!window) {
-        return nullptr;
-    }
-
-    // Avoid qobject_cast here: it requires Q_OBJECT on ToastOverlay.
-    // We keep ToastOverlay as a lightweight internal widget.
-    for (QObject *child : window->children()) {
-        if (!child || child->objectName() != QLatin1String("FluentToastOverlay")) {
-            continue;
-        }
-        if (auto *overlay = dynamic_cast<ToastOverlay *>(child)) {
-            return overlay;
-        }
-    }
-
-    auto *overlay = new ToastOverlay(window);
-    overlay->setGeometry(window->rect());
-    overlay->show();
-
-    return overlay;
-}
-
-} // namespace
-
 class FluentToast::ProgressBar final : public QWidget
 {
 public:
@@ -523,6 +666,8 @@ FluentToast::FluentToast(const QString &title, const QString &message, QWidget *
     m_progress->setAttribute(Qt::WA_TransparentForMouseEvents, true);
     layout->addWidget(m_progress);
 
+    m_fade = new FluentFadeLayer(this);
+
     applyTheme();
 
     connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentToast::applyTheme);
@@ -545,21 +690,29 @@ void FluentToast::showToast(QWidget *window,
         return;
     }
 
-    auto *overlay = ensureOverlay(window);
+    auto *overlay = ToastOverlay::ensure(window);
     if (!overlay) {
         return;
     }
 
-    auto *toast = new FluentToast(title, message);
+    // The toast itself is created (or recycled) and started by the overlay's
+    // next layout pass, once it has a free slot at this position.
+    overlay->post(title, message, position, durationMs);
+}
 
-    overlay->addToast(toast, position);
+void FluentToast::setMaxVisibleCount(Position position, int count)
+{
+    g_maxVisibleToasts[positionIndex(position)] = qMax(0, count);
+}
 
-    // Start animation after first layout.
-    QTimer::singleShot(0, toast, [toast, durationMs]() {
-        if (toast) {
-            toast->start(durationMs);
-        }
-    });
+int FluentToast::maxVisibleCount(Position position)
+{
+    return g_maxVisibleToasts[positionIndex(position)];
+}
+
+int FluentToast::repeatCount() const
+{
+    return m_repeatCount;
 }
 
 void FluentToast::mousePressEvent(QMouseEvent *event)
@@ -574,6 +727,8 @@ void FluentToast::mousePressEvent(QMouseEvent *event)
 
 void FluentToast::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     finishOpacityAnimationsImmediatelyIfReducedMotion();
 
     const auto &c = ThemeManager::instance().colors();
@@ -598,9 +753,9 @@ void FluentToast::applyTheme()
         "#FluentToastMessage { color: %2; }")
         .arg(text.name())
         .arg(sub.name());
-    if (styleSheet() != next) {
-        setStyleSheet(next);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(this, next);
+
+    m_fade->refresh();
 }
 
 void FluentToast::finishOpacityAnimationsImmediatelyIfReducedMotion()
@@ -625,14 +780,11 @@ void FluentToast::finishOpacityAnimationsImmediatelyIfReducedMotion()
     }
 
     if (m_dismissing) {
-        emit dismissed();
-        deleteLater();
+        finishDismiss();
         return;
     }
 
-    if (auto *effect = qobject_cast<QGraphicsOpacityEffect *>(graphicsEffect())) {
-        effect->setOpacity(1.0);
-    }
+    m_fade->end();
 }
 
 void FluentToast::paintEvent(QPaintEvent *event)
@@ -662,7 +814,34 @@ void FluentToast::paintEvent(QPaintEvent *event)
 
     m_border.applyToFrameSpec(frame, c);
 
+    // While fading, the chrome is painted live so the border trace keeps
+    // animating; the labels and progress bar come from the cached layer.
+    p.setOpacity(m_fade->opacity());
     paintFluentPanel(p, r, c, frame);
+
+    if (m_repeatCount > 1) {
+        const auto tokens = ThemeManager::instance().tokens();
+        const QString text = m_repeatCount > 99 ? QStringLiteral("99+") : QString::number(m_repeatCount);
+
+        QFont badgeFont = font();
+        badgeFont.setPixelSize(11);
+        badgeFont.setWeight(QFont::DemiBold);
+        const QFontMetrics fm(badgeFont);
+        const qreal badgeHeight = 18.0;
+        const qreal badgeWidth = qMax(badgeHeight, fm.horizontalAdvance(text) + 12.0);
+        const QMargins margins = layout() ? layout()->contentsMargins() : QMargins();
+        const QRectF badge(width() - margins.right() - badgeWidth, margins.top(), badgeWidth, badgeHeight);
+
+        p.setRenderHint(QPainter::Antialiasing, true);
+        p.setPen(Qt::NoPen);
+        p.setBrush(tokens.accent.base);
+        p.drawRoundedRect(badge, badgeHeight / 2.0, badgeHeight / 2.0);
+        p.setPen(tokens.onAccent);
+        p.setFont(badgeFont);
+        p.drawText(badge, Qt::AlignCenter, text);
+    }
+
+    m_fade->paint(p);
 }
 
 void FluentToast::start(int durationMs)
@@ -676,21 +855,24 @@ void FluentToast::start(int durationMs)
 
     durationMs = qMax(800, durationMs);
 
-    auto *effect = new QGraphicsOpacityEffect(this);
-    effect->setOpacity(0.0);
-    setGraphicsEffect(effect);
-
-    auto *opAnim = new QPropertyAnimation(effect, "opacity", this);
+    auto *opAnim = new QVariantAnimation(this);
     FluentMotion::configure(opAnim, FluentMotionRole::Toast);
     opAnim->setStartValue(0.0);
     opAnim->setEndValue(1.0);
 
     if (opAnim->duration() <= 0) {
-        effect->setOpacity(1.0);
         opAnim->deleteLater();
     } else {
+        m_fade->begin(0.0);
+        connect(opAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &v) {
+            m_fade->setOpacity(v.toReal());
+        });
+
         auto *group = new QParallelAnimationGroup(this);
         group->addAnimation(opAnim);
+        connect(group, &QParallelAnimationGroup::finished, this, [this]() {
+            m_fade->end();
+        });
         group->start(QAbstractAnimation::DeleteWhenStopped);
     }
 
@@ -708,6 +890,7 @@ void FluentToast::start(int durationMs)
         dismiss(true);
     });
     progress->start(QAbstractAnimation::DeleteWhenStopped);
+    m_countdown = progress;
 }
 
 void FluentToast::dismiss(bool animated)
@@ -718,39 +901,99 @@ void FluentToast::dismiss(bool animated)
     m_dismissing = true;
 
     if (!animated) {
-        emit dismissed();
-        deleteLater();
+        finishDismiss();
         return;
     }
 
-    auto *effect = qobject_cast<QGraphicsOpacityEffect *>(graphicsEffect());
-    if (!effect) {
-        effect = new QGraphicsOpacityEffect(this);
-        effect->setOpacity(1.0);
-        setGraphicsEffect(effect);
+    // Dismissing mid-appear continues from the current layer opacity.
+    const qreal from = m_fade->opacity();
+    const auto running = findChildren<QParallelAnimationGroup *>(QString(), Qt::FindDirectChildrenOnly);
+    for (QParallelAnimationGroup *group : running) {
+        group->stop();
+        group->deleteLater();
     }
 
-    auto *opAnim = new QPropertyAnimation(effect, "opacity", this);
+    auto *opAnim = new QVariantAnimation(this);
     FluentMotion::configure(opAnim, FluentMotionRole::Toast);
-    opAnim->setStartValue(effect->opacity());
+    opAnim->setStartValue(from);
     opAnim->setEndValue(0.0);
 
     if (opAnim->duration() <= 0) {
         opAnim->deleteLater();
-        emit dismissed();
-        deleteLater();
+        finishDismiss();
         return;
     }
 
+    m_fade->begin(from);
+    connect(opAnim, &QVariantAnimation::valueChanged, this, [this](const QVariant &v) {
+        m_fade->setOpacity(v.toReal());
+    });
+
     auto *group = new QParallelAnimationGroup(this);
     group->addAnimation(opAnim);
 
     connect(group, &QParallelAnimationGroup::finished, this, [this]() {
-        emit dismissed();
-        deleteLater();
+        finishDismiss();
     });
 
     group->start(QAbstractAnimation::DeleteWhenStopped);
 }
 
+void FluentToast::finishDismiss()
+{
+    emit dismissed();
+    if (!m_pooled) {
+        deleteLater();
+    }
+}
+
+void FluentToast::repeat(int durationMs)
+{
+    ++m_repeatCount;
+    update();
+
+    // A repeat restarts the countdown so the coalesced toast stays up as long
+    // as the latest post asked for.
+    if (m_countdown) {
+        m_countdown->setDuration(qMax(m_countdown->duration(), qMax(800, durationMs)));
+        m_countdown->setCurrentTime(0);
+    }
+}
+
+void FluentToast::reset(const QString &title, const QString &message)
+{
+    stopAnimations();
+
+    m_title = title;
+    m_message = message;
+    m_repeatCount = 1;
+    m_dismissing = false;
+
+    if (auto *titleLabel = findChild<QLabel *>(QStringLiteral("FluentToastTitle"))) {
+        titleLabel->setText(title);
+    }
+    if (auto *msgLabel = findChild<QLabel *>(QStringLiteral("FluentToastMessage"))) {
+        msgLabel->setText(message);
+    }
+    m_progress->setRatio(1.0);
+
+    m_border.resetInitial();
+    m_border.syncFromTheme();
+}
+
+void FluentToast::stopAnimations()
+{
+    if (m_countdown) {
+        m_countdown->stop();
+    }
+
+    const auto groups = findChildren<QParallelAnimationGroup *>(QString(), Qt::FindDirectChildrenOnly);
+    for (QParallelAnimationGroup *group : groups) {
+        group->stop();
+        group->deleteLater();
+    }
+
+    m_fade->end();
+}
+
 } // namespace Fluent
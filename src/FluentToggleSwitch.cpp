@@ -2,13 +2,15 @@
 #include "Fluent/FluentMotion.h"
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QAbstractAnimation>
 #include <QEvent>
 #include <QMouseEvent>
 #include <QPainter>
-#include <QPropertyAnimation>
 #include <QKeyEvent>
+#include <QVariantAnimation>
 
 namespace Fluent {
 
@@ -20,14 +22,8 @@ FluentToggleSwitch::FluentToggleSwitch(QWidget *parent)
     setAttribute(Qt::WA_Hover, true);
     setFocusPolicy(Qt::StrongFocus);
 
-    m_progressAnim = new QPropertyAnimation(this, "progress", this);
-
-    m_hoverAnim = new QPropertyAnimation(this, "hoverLevel", this);
-
-    m_focusAnim = new QPropertyAnimation(this, "focusLevel", this);
-
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentToggleSwitch::applyTheme);
+    ThemeRegistry::enroll<&FluentToggleSwitch::applyTheme>(this);
     syncEnabledState();
 }
 
@@ -40,14 +36,8 @@ FluentToggleSwitch::FluentToggleSwitch(const QString &text, QWidget *parent)
     setAttribute(Qt::WA_Hover, true);
     setFocusPolicy(Qt::StrongFocus);
 
-    m_progressAnim = new QPropertyAnimation(this, "progress", this);
-
-    m_hoverAnim = new QPropertyAnimation(this, "hoverLevel", this);
-
-    m_focusAnim = new QPropertyAnimation(this, "focusLevel", this);
-
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentToggleSwitch::applyTheme);
+    ThemeRegistry::enroll<&FluentToggleSwitch::applyTheme>(this);
     syncEnabledState();
 }
 
@@ -63,16 +53,10 @@ void FluentToggleSwitch::setChecked(bool checked)
     }
 
     m_checked = checked;
-    FluentMotion::configure(m_progressAnim, FluentMotionRole::Selection);
-    m_progressAnim->stop();
     const qreal target = m_checked ? 1.0 : 0.0;
-    if (m_progressAnim->duration() <= 0) {
-        setProgress(target);
-    } else {
-        m_progressAnim->setStartValue(m_progress);
-        m_progressAnim->setEndValue(target);
-        m_progressAnim->start();
-    }
+    FluentMotion::animateLevel(this, m_progressAnim, FluentMotionRole::Selection, m_progress, target, [this](qreal level) {
+        setProgress(level);
+    });
     emit toggled(m_checked);
 }
 
@@ -143,6 +127,8 @@ void FluentToggleSwitch::changeEvent(QEvent *event)
 
 void FluentToggleSwitch::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool snapProgress = m_progressAnim &&
         m_progressAnim->state() == QAbstractAnimation::Running &&
         FluentMotion::duration(FluentMotionRole::Selection) <= 0;
@@ -325,43 +311,25 @@ void FluentToggleSwitch::focusOutEvent(QFocusEvent *event)
 
 void FluentToggleSwitch::startFocusAnimation(qreal endValue)
 {
-    FluentMotion::configure(m_focusAnim, FluentMotionRole::Focus);
-    m_focusAnim->stop();
-    if (m_focusAnim->duration() <= 0) {
-        setFocusLevel(endValue);
-        return;
-    }
-    m_focusAnim->setStartValue(m_focusLevel);
-    m_focusAnim->setEndValue(endValue);
-    m_focusAnim->start();
+    FluentMotion::animateLevel(this, m_focusAnim, FluentMotionRole::Focus, m_focusLevel, endValue, [this](qreal level) {
+        setFocusLevel(level);
+    });
 }
 
 void FluentToggleSwitch::enterEvent(FluentEnterEvent *event)
 {
     QWidget::enterEvent(event);
-    FluentMotion::configure(m_hoverAnim, FluentMotionRole::Hover);
-    m_hoverAnim->stop();
-    if (m_hoverAnim->duration() <= 0) {
-        setHoverLevel(1.0);
-        return;
-    }
-    m_hoverAnim->setStartValue(m_hoverLevel);
-    m_hoverAnim->setEndValue(1.0);
-    m_hoverAnim->start();
+    FluentMotion::animateLevel(this, m_hoverAnim, FluentMotionRole::Hover, m_hoverLevel, 1.0, [this](qreal level) {
+        setHoverLevel(level);
+    });
 }
 
 void FluentToggleSwitch::leaveEvent(QEvent *event)
 {
     QWidget::leaveEvent(event);
-    FluentMotion::configure(m_hoverAnim, FluentMotionRole::Hover);
-    m_hoverAnim->stop();
-    if (m_hoverAnim->duration() <= 0) {
-        setHoverLevel(0.0);
-        return;
-    }
-    m_hoverAnim->setStartValue(m_hoverLevel);
-    m_hoverAnim->setEndValue(0.0);
-    m_hoverAnim->start();
+    FluentMotion::animateLevel(this, m_hoverAnim, FluentMotionRole::Hover, m_hoverLevel, 0.0, [this](qreal level) {
+        setHoverLevel(level);
+    });
 }
 
 } // namespace Fluent
@@ -1,6 +1,8 @@
 #include "Fluent/FluentToolBar.h"
 #include "Fluent/FluentTheme.h"
 #include "Fluent/FluentToolButton.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QEvent>
 #include <QActionEvent>
@@ -15,7 +17,7 @@ FluentToolBar::FluentToolBar(const QString &title, QWidget *parent)
 {
     setMovable(false);
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentToolBar::applyTheme);
+    ThemeRegistry::enroll<&FluentToolBar::applyTheme>(this);
 }
 
 FluentToolBar::~FluentToolBar()
@@ -85,10 +87,10 @@ void FluentToolBar::actionEvent(QActionEvent *event)
 
 void FluentToolBar::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const QString next = Theme::toolBarStyle(ThemeManager::instance().colors());
-    if (styleSheet() != next) {
-        setStyleSheet(next);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(this, next);
 }
 
 QWidgetAction *FluentToolBar::wrapperForAction(QAction *action) const
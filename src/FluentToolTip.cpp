@@ -2,6 +2,7 @@
 #include "Fluent/FluentFramePainter.h"
 #include "Fluent/FluentStyle.h"
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
 #include <QApplication>
 #include <QEvent>
 #include <QHelpEvent>
@@ -113,7 +114,7 @@ private:
         const auto &colors = ThemeManager::instance().colors();
         const QString next = QStringLiteral("QLabel { background: transparent; color: %1; font-weight: 500; }")
             .arg(colors.text.name(QColor::HexArgb));
-        if (m_label->styleSheet() != next) m_label->setStyleSheet(next);
+        ThemeProfiler::setStyleSheetIfChanged(m_label, next);
     }
     void updateGeometryForText() {
         if (!layout() || !m_label) return;
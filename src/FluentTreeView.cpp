@@ -6,6 +6,8 @@
 #include "FluentItemViewPaintSupport.h"
 #include "FluentPaintSupport.h"
 #include "FluentViewPaletteSupport.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QAbstractItemModel>
 #include <QEvent>
@@ -281,7 +283,7 @@ FluentTreeView::FluentTreeView(QWidget *parent)
         viewport()->update();
     });
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentTreeView::applyTheme);
+    ThemeRegistry::enroll<&FluentTreeView::applyTheme>(this);
 
     QTimer::singleShot(0, this, [this]() { hookSelectionModel(); });
 }
@@ -412,6 +414,8 @@ void FluentTreeView::drawBranches(QPainter *painter, const QRect &rect, const QM
 
 void FluentTreeView::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     const bool hoverRunning = m_hoverAnim && m_hoverAnim->state() == QAbstractAnimation::Running;
     const bool selectionRunning = m_selAnim && m_selAnim->state() == QAbstractAnimation::Running;
     const QVariant hoverEnd = m_hoverAnim ? m_hoverAnim->endValue() : QVariant();
@@ -437,9 +441,7 @@ void FluentTreeView::applyTheme()
 
     const auto &colors = ThemeManager::instance().colors();
     const QString next = Theme::treeViewStyle(colors);
-    if (styleSheet() != next) {
-        setStyleSheet(next);
-    }
+    ThemeProfiler::setStyleSheetIfChanged(this, next);
     Detail::applyFluentViewPalette(this, viewport(), colors);
     Detail::applyFluentViewPalette(header(), header() ? header()->viewport() : nullptr, colors);
 }
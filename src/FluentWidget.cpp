@@ -1,6 +1,8 @@
 #include "Fluent/FluentWidget.h"
 
 #include "Fluent/FluentTheme.h"
+#include "FluentDiagnostics_p.h"
+#include "FluentThemeRegistry_p.h"
 
 #include <QEvent>
 #include <QPainter>
@@ -14,7 +16,7 @@ FluentWidget::FluentWidget(QWidget *parent)
     setAutoFillBackground(false);
 
     applyTheme();
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &FluentWidget::applyTheme);
+    ThemeRegistry::enroll<&FluentWidget::applyTheme>(this);
 }
 
 FluentWidget::BackgroundRole FluentWidget::backgroundRole() const
@@ -41,6 +43,8 @@ void FluentWidget::changeEvent(QEvent *event)
 
 void FluentWidget::applyTheme()
 {
+    const ThemeProfiler::ReceiverScope profile(this);
+
     update();
 }
 
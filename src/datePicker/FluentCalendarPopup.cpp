@@ -14,7 +14,10 @@
 #include <QMouseEvent>
 #include <QPainter>
 #include <QPainterPath>
+#include <QRegion>
 #include <QScreen>
+#include <QStringList>
+#include <QtMath>
 #include <QVariantAnimation>
 #include <QWheelEvent>
 namespace Fluent {
@@ -171,6 +174,7 @@ FluentCalendarPopup::FluentCalendarPopup(QWidget *anchor)
         } else {
             m_border.syncFromTheme();
         }
+        invalidateGridLayers();
         update();
     });
 
@@ -503,6 +507,15 @@ void FluentCalendarPopup::hideEvent(QHideEvent *e)
     m_border.resetInitial();
 }
 void FluentCalendarPopup::resizeEvent(QResizeEvent *e) { QWidget::resizeEvent(e); }
+void FluentCalendarPopup::changeEvent(QEvent *e)
+{
+    QWidget::changeEvent(e);
+    if (!e) return;
+    if (e->type() == QEvent::FontChange || e->type() == QEvent::LocaleChange) {
+        invalidateGridLayers();
+        update();
+    }
+}
 // ── Paint ────────────────────────────────────────────────────────────────
 void FluentCalendarPopup::paintEvent(QPaintEvent *event)
 {
@@ -609,8 +622,7 @@ void FluentCalendarPopup::paintRangePanelDays(QPainter &p, int panelX,
 {
     const auto &c = ThemeManager::instance().colors();
     const auto tokens = Theme::tokens(c);
-    const QLocale calendarLocale = locale();
-    const Qt::DayOfWeek firstDayOfWeek = calendarLocale.firstDayOfWeek();
+    const Qt::DayOfWeek firstDayOfWeek = locale().firstDayOfWeek();
     const QRect surface = PopupSurface::shadowContentRect(rect());
     const QRect content(panelX + kPadding,
                         surface.top() + kPadding,
@@ -632,73 +644,67 @@ void FluentCalendarPopup::paintRangePanelDays(QPainter &p, int panelX,
             }
         }
     }
-    // Day name row
-    QFont sf = adjustedFontSize(font(), -0.5); p.setFont(sf);
-    for (int i = 0; i < 7; ++i) {
-        const QRect r(dayNames.x()+i*cw, dayNames.y(), cw, dayNames.height());
-        const int dayOfWeek = displayedDayOfWeek(i, firstDayOfWeek);
-        const QString name = calendarLocale.standaloneDayName(dayOfWeek, QLocale::ShortFormat);
-        p.setPen(isWeekendColumn(i, firstDayOfWeek) ? c.text : c.subText);
-        p.drawText(r, Qt::AlignCenter, name);
-    }
-    p.setFont(font());
     const QDate gridStart = gridStartForMonth(pageYear, pageMonth, firstDayOfWeek);
     if (!gridStart.isValid()) return;
-    const QDate today = QDate::currentDate();
+    // Decorations are resolved as cell indices so the per-paint loop does no
+    // QDate arithmetic; labels come from the cached glyph layer.
     const QDate effS  = effectiveRangeStart();
     const QDate effE  = effectiveRangeEnd();
     const bool hasRange = effS.isValid() && effE.isValid();
+    const qint64 startIdx = hasRange ? gridStart.daysTo(effS) : -1;
+    const qint64 endIdx   = hasRange ? gridStart.daysTo(effE) : -1;
+    const qint64 todayIdx = gridStart.daysTo(QDate::currentDate());
     const HitPart cellPart = isRight ? HitPart::RCell : HitPart::Cell;
-    for (int row = 0; row < 6; ++row) {
-        for (int col = 0; col < 7; ++col) {
-            const int   idx = row*7+col;
-            const QDate d   = gridStart.addDays(idx);
-            const QRect rc(cells.x()+col*cw, cells.y()+row*ch, cw, ch);
-            const QRectF rr = QRectF(rc).adjusted(6.0, 4.0, -6.0, -4.0);
-            const bool inMonth  = (d.year() == pageYear && d.month() == pageMonth);
-            const bool isStart  = hasRange && (d == effS);
-            const bool isEnd    = hasRange && (d == effE);
-            const bool inRange  = hasRange && (d > effS && d < effE);
-            const bool isToday  = (d == today);
-            const bool hovered  = (m_hoverPart == cellPart && m_hoverIndex == idx);
-            // 1. Continuous range band (full slot width = no horizontal gaps)
-            if (hasRange) {
-                const qreal bY = rc.y() + 4.0, bH = rc.height() - 8.0;
-                const qreal cx = rc.x() + rc.width() / 2.0;
-                p.setPen(Qt::NoPen); p.setBrush(calendarAccentFillF(tokens, 0.15));
-                if (inRange) {
-                    p.drawRect(QRectF(rc.x(), bY, rc.width(), bH));
-                } else if (isStart && d != effE) {
-                    // Right half: from cell centre to the cell's right edge.
-                    // Use QRectF(rc).right() (= rc.x()+rc.width()) instead of
-                    // rc.right() (= rc.x()+rc.width()-1) to avoid a 1-px gap.
-                    p.drawRect(QRectF(cx, bY, QRectF(rc).right() - cx, bH));
-                } else if (isEnd && d != effS) {
-                    p.drawRect(QRectF(rc.x(), bY, cx - rc.x(), bH));
-                }
-            }
-            // 2. Cell circle
-            if (isStart || isEnd) {
-                p.setPen(Qt::NoPen); p.setBrush(tokens.accent.base);
-                p.drawRoundedRect(rr, 8.0, 8.0);
-            } else if (hovered && !inRange) {
-                p.setPen(Qt::NoPen); p.setBrush(calendarHoverFill(tokens, 120));
-                p.drawRoundedRect(rr, 8.0, 8.0);
-            }
-            // 3. Today ring
-            if (isToday && !isStart && !isEnd) {
-                p.setPen(QPen(calendarAccentFill(tokens, 170), 1.5)); p.setBrush(Qt::NoBrush);
-                p.drawRoundedRect(rr, 8.0, 8.0);
+    const int hoverIdx = (m_hoverPart == cellPart) ? m_hoverIndex : -1;
+    QVector<QRect> accentCells;
+    QStringList accentLabels;
+    for (int idx = 0; idx < 42; ++idx) {
+        const int   row = idx / 7, col = idx % 7;
+        const QRect rc(cells.x()+col*cw, cells.y()+row*ch, cw, ch);
+        const QRectF rr = QRectF(rc).adjusted(6.0, 4.0, -6.0, -4.0);
+        const bool isStart  = hasRange && idx == startIdx;
+        const bool isEnd    = hasRange && idx == endIdx;
+        const bool inRange  = hasRange && idx > startIdx && idx < endIdx;
+        const bool isToday  = (idx == todayIdx);
+        const bool hovered  = (idx == hoverIdx);
+        // 1. Continuous range band (full slot width = no horizontal gaps)
+        if (hasRange) {
+            const qreal bY = rc.y() + 4.0, bH = rc.height() - 8.0;
+            const qreal cx = rc.x() + rc.width() / 2.0;
+            p.setPen(Qt::NoPen); p.setBrush(calendarAccentFillF(tokens, 0.15));
+            if (inRange) {
+                p.drawRect(QRectF(rc.x(), bY, rc.width(), bH));
+            } else if (isStart && startIdx != endIdx) {
+                // Right half: from cell centre to the cell's right edge.
+                // Use QRectF(rc).right() (= rc.x()+rc.width()) instead of
+                // rc.right() (= rc.x()+rc.width()-1) to avoid a 1-px gap.
+                p.drawRect(QRectF(cx, bY, QRectF(rc).right() - cx, bH));
+            } else if (isEnd && startIdx != endIdx) {
+                p.drawRect(QRectF(rc.x(), bY, cx - rc.x(), bH));
             }
-            // 4. Text
-            QColor textColor;
-            if (!inMonth)         textColor = c.disabledText;
-            else if (isStart || isEnd) textColor = onAccentText(c);
-            else if (isWeekendColumn(col, firstDayOfWeek)) textColor = c.subText;
-            else                  textColor = c.text;
-            p.setPen(textColor);
-            p.drawText(rc, Qt::AlignCenter, QString::number(d.day()));
         }
+        // 2. Cell circle
+        if (isStart || isEnd) {
+            p.setPen(Qt::NoPen); p.setBrush(tokens.accent.base);
+            p.drawRoundedRect(rr, 8.0, 8.0);
+            accentCells.append(rc);
+            accentLabels.append(QString::number(gridStart.addDays(idx).day()));
+        } else if (hovered && !inRange) {
+            p.setPen(Qt::NoPen); p.setBrush(calendarHoverFill(tokens, 120));
+            p.drawRoundedRect(rr, 8.0, 8.0);
+        }
+        // 3. Today ring
+        if (isToday && !isStart && !isEnd) {
+            p.setPen(QPen(calendarAccentFill(tokens, 170), 1.5)); p.setBrush(Qt::NoBrush);
+            p.drawRoundedRect(rr, 8.0, 8.0);
+        }
+    }
+    // 4. Text: cached labels, with range endpoints re-drawn on the accent.
+    drawGridLayer(p, isRight ? GridLayerSlot::RangeRight : GridLayerSlot::RangeLeft,
+                  g, pageYear, pageMonth, accentCells);
+    p.setPen(onAccentText(c));
+    for (int i = 0; i < accentCells.size(); ++i) {
+        p.drawText(accentCells.at(i), Qt::AlignCenter, accentLabels.at(i));
     }
 }
 // ── Single-mode painting ─────────────────────────────────────────────────
@@ -758,8 +764,7 @@ void FluentCalendarPopup::paintDays(QPainter &p)
 {
     const auto &c = ThemeManager::instance().colors();
     const auto tokens = Theme::tokens(c);
-    const QLocale calendarLocale = locale();
-    const Qt::DayOfWeek firstDayOfWeek = calendarLocale.firstDayOfWeek();
+    const Qt::DayOfWeek firstDayOfWeek = locale().firstDayOfWeek();
     const QRect g = gridRect();
     const QRect dayNames(g.x(), g.y(), g.width(), kDayNamesH);
     const QRect cells(g.x(), g.y()+kDayNamesH, g.width(), g.height()-kDayNamesH);
@@ -774,78 +779,191 @@ void FluentCalendarPopup::paintDays(QPainter &p)
             }
         }
     }
-    QFont sf=adjustedFontSize(font(), -0.5); p.setFont(sf);
-    for (int i=0;i<7;++i) {
-        const QRect r(dayNames.x()+i*cw, dayNames.y(), cw, dayNames.height());
-        const int dayOfWeek = displayedDayOfWeek(i, firstDayOfWeek);
-        const QString name = calendarLocale.standaloneDayName(dayOfWeek, QLocale::ShortFormat);
-        p.setPen(isWeekendColumn(i, firstDayOfWeek) ? c.text : c.subText); p.drawText(r, Qt::AlignCenter, name);
-    }
-    p.setFont(font());
     const QDate start = gridStartForMonth(m_pageYear, m_pageMonth, firstDayOfWeek);
     if (!start.isValid()) return;
-    const QDate today = QDate::currentDate();
-    for (int row=0;row<6;++row) for (int col=0;col<7;++col) {
-        const int idx=row*7+col; const QDate d=start.addDays(idx);
-        const QRect rc(cells.x()+col*cw, cells.y()+row*ch, cw, ch);
-        const QRectF rr=QRectF(rc).adjusted(6.0,4.0,-6.0,-4.0);
-        const bool inMonth=(d.year()==m_pageYear&&d.month()==m_pageMonth);
-        const bool selected=(d==m_selected), isToday=(d==today);
-        const bool hovered=(m_hoverPart==HitPart::Cell&&m_hoverIndex==idx);
-        if (selected) { p.setPen(Qt::NoPen); p.setBrush(calendarAccentFill(tokens, 210)); p.drawRoundedRect(rr,8.0,8.0); }
-        else if (hovered) { p.setPen(Qt::NoPen); p.setBrush(calendarHoverFill(tokens, 120)); p.drawRoundedRect(rr,8.0,8.0); }
-        if (isToday&&!selected) { p.setPen(QPen(calendarAccentFill(tokens, 170),1.5)); p.setBrush(Qt::NoBrush); p.drawRoundedRect(rr,8.0,8.0); }
-        QColor tc;
-        if (!inMonth) tc=c.disabledText;
-        else if (selected) tc=onAccentText(c);
-        else if (isWeekendColumn(col, firstDayOfWeek)) tc=c.subText;
-        else tc=c.text;
-        p.setPen(tc); p.drawText(rc, Qt::AlignCenter, QString::number(d.day()));
+    auto cellRect = [&](qint64 idx) {
+        return QRect(cells.x()+int(idx%7)*cw, cells.y()+int(idx/7)*ch, cw, ch);
+    };
+    auto inGrid = [](qint64 idx) { return idx >= 0 && idx < 42; };
+    const qint64 selIdx = m_selected.isValid() ? start.daysTo(m_selected) : -1;
+    const qint64 todayIdx = start.daysTo(QDate::currentDate());
+    const int hoverIdx = (m_hoverPart==HitPart::Cell) ? m_hoverIndex : -1;
+    QVector<QRect> accentCells;
+    if (inGrid(selIdx)) {
+        accentCells.append(cellRect(selIdx));
+        p.setPen(Qt::NoPen); p.setBrush(calendarAccentFill(tokens, 210));
+        p.drawRoundedRect(QRectF(accentCells.first()).adjusted(6.0,4.0,-6.0,-4.0),8.0,8.0);
+    }
+    if (inGrid(hoverIdx) && hoverIdx!=selIdx) {
+        p.setPen(Qt::NoPen); p.setBrush(calendarHoverFill(tokens, 120));
+        p.drawRoundedRect(QRectF(cellRect(hoverIdx)).adjusted(6.0,4.0,-6.0,-4.0),8.0,8.0);
+    }
+    if (inGrid(todayIdx) && todayIdx!=selIdx) {
+        p.setPen(QPen(calendarAccentFill(tokens, 170),1.5)); p.setBrush(Qt::NoBrush);
+        p.drawRoundedRect(QRectF(cellRect(todayIdx)).adjusted(6.0,4.0,-6.0,-4.0),8.0,8.0);
+    }
+    drawGridLayer(p, GridLayerSlot::Days, g, m_pageYear, m_pageMonth, accentCells);
+    if (!accentCells.isEmpty()) {
+        p.setPen(onAccentText(c)); p.drawText(accentCells.first(), Qt::AlignCenter, QString::number(m_selected.day()));
     }
 }
 void FluentCalendarPopup::paintMonths(QPainter &p)
 {
     const auto &c=ThemeManager::instance().colors();
     const auto tokens = Theme::tokens(c);
-    const QLocale calendarLocale = locale();
     const QRect g=gridRect(); const int cw=g.width()/3, ch=g.height()/4;
+    if (cw<=0||ch<=0) return;
     const QDate today=QDate::currentDate();
-    QFont f=adjustedFontSize(font(), 0.2); p.setFont(f);
-    for (int i=0;i<12;++i) {
-        const int row=i/3, col=i%3;
-        const QRect rc(g.x()+col*cw, g.y()+row*ch, cw, ch);
-        const QRectF rr=QRectF(rc).adjusted(8.0,8.0,-8.0,-8.0);
-        const bool sel=(i+1)==m_pageMonth, cur=(today.isValid()&&m_pageYear==today.year()&&(i+1)==today.month());
-        const bool hov=(m_hoverPart==HitPart::Cell&&m_hoverIndex==i);
-        if (sel) { p.setPen(Qt::NoPen); p.setBrush(calendarAccentFill(tokens, 210)); p.drawRoundedRect(rr,10.0,10.0); }
-        else if (hov) { p.setPen(Qt::NoPen); p.setBrush(calendarHoverFill(tokens, 120)); p.drawRoundedRect(rr,10.0,10.0); }
-        if (cur&&!sel) { p.setPen(QPen(calendarAccentFill(tokens, 170),1.5)); p.setBrush(Qt::NoBrush); p.drawRoundedRect(rr,10.0,10.0); }
-        p.setPen(sel ? onAccentText(c) : c.text);
-        p.drawText(rc, Qt::AlignCenter, calendarLocale.standaloneMonthName(i+1, QLocale::ShortFormat));
+    auto cellRect = [&](int i) { return QRect(g.x()+(i%3)*cw, g.y()+(i/3)*ch, cw, ch); };
+    const int selIdx=m_pageMonth-1;
+    const int curIdx=(today.isValid()&&m_pageYear==today.year()) ? today.month()-1 : -1;
+    const int hovIdx=(m_hoverPart==HitPart::Cell&&m_hoverIndex>=0&&m_hoverIndex<12) ? m_hoverIndex : -1;
+    QVector<QRect> accentCells;
+    if (selIdx>=0&&selIdx<12) {
+        accentCells.append(cellRect(selIdx));
+        p.setPen(Qt::NoPen); p.setBrush(calendarAccentFill(tokens, 210));
+        p.drawRoundedRect(QRectF(accentCells.first()).adjusted(8.0,8.0,-8.0,-8.0),10.0,10.0);
+    }
+    if (hovIdx>=0&&hovIdx!=selIdx) {
+        p.setPen(Qt::NoPen); p.setBrush(calendarHoverFill(tokens, 120));
+        p.drawRoundedRect(QRectF(cellRect(hovIdx)).adjusted(8.0,8.0,-8.0,-8.0),10.0,10.0);
+    }
+    if (curIdx>=0&&curIdx!=selIdx) {
+        p.setPen(QPen(calendarAccentFill(tokens, 170),1.5)); p.setBrush(Qt::NoBrush);
+        p.drawRoundedRect(QRectF(cellRect(curIdx)).adjusted(8.0,8.0,-8.0,-8.0),10.0,10.0);
+    }
+    drawGridLayer(p, GridLayerSlot::Months, g, 0, 0, accentCells);
+    if (!accentCells.isEmpty()) {
+        p.setFont(adjustedFontSize(font(), 0.2)); p.setPen(onAccentText(c));
+        p.drawText(accentCells.first(), Qt::AlignCenter, locale().standaloneMonthName(m_pageMonth, QLocale::ShortFormat));
+        p.setFont(font());
     }
-    p.setFont(font());
 }
 void FluentCalendarPopup::paintYears(QPainter &p)
 {
     const auto &c=ThemeManager::instance().colors();
     const auto tokens = Theme::tokens(c);
     const QRect g=gridRect(); const int cw=g.width()/4, ch=g.height()/4;
-    const int ty=QDate::currentDate().year();
-    QFont f=adjustedFontSize(font(), 0.2); p.setFont(f);
-    for (int i=0;i<16;++i) {
-        const int row=i/4, col=i%4;
-        const QRect rc(g.x()+col*cw, g.y()+row*ch, cw, ch);
-        const QRectF rr=QRectF(rc).adjusted(8.0,8.0,-8.0,-8.0);
-        const int year=m_yearBase+i;
-        const bool sel=(year==m_pageYear), cur=(year==ty);
-        const bool hov=(m_hoverPart==HitPart::Cell&&m_hoverIndex==i);
-        if (sel) { p.setPen(Qt::NoPen); p.setBrush(calendarAccentFill(tokens, 210)); p.drawRoundedRect(rr,10.0,10.0); }
-        else if (hov) { p.setPen(Qt::NoPen); p.setBrush(calendarHoverFill(tokens, 120)); p.drawRoundedRect(rr,10.0,10.0); }
-        if (cur&&!sel) { p.setPen(QPen(calendarAccentFill(tokens, 170),1.5)); p.setBrush(Qt::NoBrush); p.drawRoundedRect(rr,10.0,10.0); }
-        p.setPen(sel ? onAccentText(c) : c.text);
-        p.drawText(rc, Qt::AlignCenter, QString::number(year));
+    if (cw<=0||ch<=0) return;
+    auto cellRect = [&](int i) { return QRect(g.x()+(i%4)*cw, g.y()+(i/4)*ch, cw, ch); };
+    const int selIdx=m_pageYear-m_yearBase, curIdx=QDate::currentDate().year()-m_yearBase;
+    const int hovIdx=(m_hoverPart==HitPart::Cell) ? m_hoverIndex : -1;
+    auto inGrid = [](int i) { return i>=0&&i<16; };
+    QVector<QRect> accentCells;
+    if (inGrid(selIdx)) {
+        accentCells.append(cellRect(selIdx));
+        p.setPen(Qt::NoPen); p.setBrush(calendarAccentFill(tokens, 210));
+        p.drawRoundedRect(QRectF(accentCells.first()).adjusted(8.0,8.0,-8.0,-8.0),10.0,10.0);
+    }
+    if (inGrid(hovIdx)&&hovIdx!=selIdx) {
+        p.setPen(Qt::NoPen); p.setBrush(calendarHoverFill(tokens, 120));
+        p.drawRoundedRect(QRectF(cellRect(hovIdx)).adjusted(8.0,8.0,-8.0,-8.0),10.0,10.0);
+    }
+    if (inGrid(curIdx)&&curIdx!=selIdx) {
+        p.setPen(QPen(calendarAccentFill(tokens, 170),1.5)); p.setBrush(Qt::NoBrush);
+        p.drawRoundedRect(QRectF(cellRect(curIdx)).adjusted(8.0,8.0,-8.0,-8.0),10.0,10.0);
+    }
+    drawGridLayer(p, GridLayerSlot::Years, g, m_yearBase, 0, accentCells);
+    if (!accentCells.isEmpty()) {
+        p.setFont(adjustedFontSize(font(), 0.2)); p.setPen(onAccentText(c));
+        p.drawText(accentCells.first(), Qt::AlignCenter, QString::number(m_pageYear));
+        p.setFont(font());
+    }
+}
+// ── Grid glyph layers ────────────────────────────────────────────────────
+void FluentCalendarPopup::invalidateGridLayers()
+{
+    for (GridLayer &layer : m_gridLayers) {
+        layer = GridLayer();
+    }
+}
+const QPixmap &FluentCalendarPopup::gridLayer(GridLayerSlot slot, const QRect &area, int year, int month)
+{
+    GridLayer &layer = m_gridLayers[int(slot)];
+    const qreal dpr = qMax<qreal>(1.0, devicePixelRatioF());
+    if (!layer.pixmap.isNull() && layer.size == area.size() && qFuzzyCompare(layer.dpr, dpr)
+        && layer.year == year && layer.month == month) {
+        return layer.pixmap;
+    }
+    layer = GridLayer();
+    if (area.isEmpty()) return layer.pixmap;
+    layer.size  = area.size();
+    layer.dpr   = dpr;
+    layer.year  = year;
+    layer.month = month;
+    layer.pixmap = QPixmap(QSize(qCeil(area.width() * dpr), qCeil(area.height() * dpr)));
+    layer.pixmap.setDevicePixelRatio(dpr);
+    layer.pixmap.fill(Qt::transparent);
+    QPainter lp(&layer.pixmap);
+    lp.setRenderHint(QPainter::TextAntialiasing, true);
+    lp.translate(-area.topLeft());
+    paintGridGlyphs(lp, slot, area, year, month);
+    // Rebuild count, read by the visual smoke test.
+    setProperty("_fluentGridLayerBuilds", property("_fluentGridLayerBuilds").toInt() + 1);
+    return layer.pixmap;
+}
+void FluentCalendarPopup::paintGridGlyphs(QPainter &p, GridLayerSlot slot, const QRect &area, int year, int month) const
+{
+    const auto &c = ThemeManager::instance().colors();
+    const QLocale calendarLocale = locale();
+    if (slot == GridLayerSlot::Months || slot == GridLayerSlot::Years) {
+        const int cols = (slot == GridLayerSlot::Months) ? 3 : 4;
+        const int count = (slot == GridLayerSlot::Months) ? 12 : 16;
+        const int cw = area.width()/cols, ch = area.height()/4;
+        p.setFont(adjustedFontSize(font(), 0.2));
+        p.setPen(c.text);
+        for (int i = 0; i < count; ++i) {
+            const QRect rc(area.x()+(i%cols)*cw, area.y()+(i/cols)*ch, cw, ch);
+            const QString text = (slot == GridLayerSlot::Months)
+                ? calendarLocale.standaloneMonthName(i+1, QLocale::ShortFormat)
+                : QString::number(year+i);
+            p.drawText(rc, Qt::AlignCenter, text);
+        }
+        return;
+    }
+    const Qt::DayOfWeek firstDayOfWeek = calendarLocale.firstDayOfWeek();
+    const QRect dayNames(area.x(), area.y(), area.width(), kDayNamesH);
+    const QRect cells(area.x(), area.y()+kDayNamesH, area.width(), area.height()-kDayNamesH);
+    const int cw = cells.width()/7, ch = cells.height()/6;
+    if (cw<=0||ch<=0) return;
+    p.setFont(adjustedFontSize(font(), -0.5));
+    for (int i = 0; i < 7; ++i) {
+        const QRect r(dayNames.x()+i*cw, dayNames.y(), cw, dayNames.height());
+        const int dayOfWeek = displayedDayOfWeek(i, firstDayOfWeek);
+        p.setPen(isWeekendColumn(i, firstDayOfWeek) ? c.text : c.subText);
+        p.drawText(r, Qt::AlignCenter, calendarLocale.standaloneDayName(dayOfWeek, QLocale::ShortFormat));
     }
     p.setFont(font());
+    const QDate start = gridStartForMonth(year, month, firstDayOfWeek);
+    if (!start.isValid()) return;
+    for (int idx = 0; idx < 42; ++idx) {
+        const int row = idx/7, col = idx%7;
+        const QDate d = start.addDays(idx);
+        const QRect rc(cells.x()+col*cw, cells.y()+row*ch, cw, ch);
+        const bool inMonth = (d.year()==year && d.month()==month);
+        if (!inMonth) p.setPen(c.disabledText);
+        else if (isWeekendColumn(col, firstDayOfWeek)) p.setPen(c.subText);
+        else p.setPen(c.text);
+        p.drawText(rc, Qt::AlignCenter, QString::number(d.day()));
+    }
+}
+void FluentCalendarPopup::drawGridLayer(QPainter &p, GridLayerSlot slot, const QRect &area, int year, int month,
+                                        const QVector<QRect> &excludedCells)
+{
+    const QPixmap &layer = gridLayer(slot, area, year, month);
+    if (layer.isNull()) return;
+    if (excludedCells.isEmpty()) {
+        p.drawPixmap(area.topLeft(), layer);
+        return;
+    }
+    // Cells painted on the accent get their own label colour, so keep the
+    // cached label out from under them.
+    QRegion visible(area);
+    for (const QRect &cell : excludedCells) visible -= cell;
+    p.save();
+    p.setClipRegion(visible, Qt::IntersectClip);
+    p.drawPixmap(area.topLeft(), layer);
+    p.restore();
 }
 // ── Mouse events ─────────────────────────────────────────────────────────
 void FluentCalendarPopup::mouseMoveEvent(QMouseEvent *event)
@@ -0,0 +1,584 @@
+#include "Fluent/FluentButton.h"
+#include "Fluent/FluentCard.h"
+#include "Fluent/FluentCheckBox.h"
+#include "Fluent/FluentComboBox.h"
+#include "Fluent/FluentCppHighlighter.h"
+#include "Fluent/FluentFlowLayout.h"
+#include "Fluent/FluentGroupBox.h"
+#include "Fluent/FluentIcon.h"
+#include "Fluent/FluentLabel.h"
+#include "Fluent/FluentLineEdit.h"
+#include "Fluent/FluentListView.h"
+#include "Fluent/FluentLottieWidget.h"
+#include "Fluent/FluentProgressBar.h"
+#include "Fluent/FluentProgressRing.h"
+#include "Fluent/FluentRadioButton.h"
+#include "Fluent/FluentSlider.h"
+#include "Fluent/FluentSpinBox.h"
+#include "Fluent/FluentTableView.h"
+#include "Fluent/FluentTabWidget.h"
+#include "Fluent/FluentTextEdit.h"
+#include "Fluent/FluentTheme.h"
+#include "Fluent/FluentToggleSwitch.h"
+#include "Fluent/FluentToolButton.h"
+#include "../src/FluentButtonVisuals_p.h"
+
+#include <QtTest/QtTest>
+
+#include <QApplication>
+#include <QDir>
+#include <QImage>
+#include <QPainter>
+#include <QStandardItemModel>
+#include <QStringListModel>
+#include <QTextDocument>
+#include <QVBoxLayout>
+#include <QWidget>
+
+#include <memory>
+#include <vector>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define QTFLUENT_BENCHMARK_HAS_MALLINFO2 1
+#endif
+
+using namespace Fluent;
+
+// Benchmarks run with QBENCHMARK, so QtTest's logger formats apply:
+//   QtFluentWidgetsBenchmarks -o benchmarks.csv,csv -o benchmarks.xml,xml -o -,txt
+// The run-QtFluentWidgetsBenchmarks target writes both files into the build
+// directory. Animations are off so every iteration paints a settled frame.
+
+namespace {
+
+#ifndef QTFLUENT_BENCHMARK_LOTTIE_DIR
+#define QTFLUENT_BENCHMARK_LOTTIE_DIR ""
+#endif
+
+std::unique_ptr<QWidget> createWidget(const QString &className)
+{
+    if (className == QLatin1String("FluentButton")) {
+        return std::make_unique<FluentButton>(QStringLiteral("Button"));
+    }
+    if (className == QLatin1String("FluentToolButton")) {
+        return std::make_unique<FluentToolButton>(QStringLiteral("Tool"));
+    }
+    if (className == QLatin1String("FluentCheckBox")) {
+        auto box = std::make_unique<FluentCheckBox>(QStringLiteral("Check box"));
+        box->setChecked(true);
+        return box;
+    }
+    if (className == QLatin1String("FluentRadioButton")) {
+        auto radio = std::make_unique<FluentRadioButton>(QStringLiteral("Radio"));
+        radio->setChecked(true);
+        return radio;
+    }
+    if (className == QLatin1String("FluentToggleSwitch")) {
+        auto toggle = std::make_unique<FluentToggleSwitch>(QStringLiteral("Toggle"));
+        toggle->setChecked(true);
+        return toggle;
+    }
+    if (className == QLatin1String("FluentLineEdit")) {
+        return std::make_unique<FluentLineEdit>(QStringLiteral("Line edit text"));
+    }
+    if (className == QLatin1String("FluentComboBox")) {
+        auto combo = std::make_unique<FluentComboBox>();
+        combo->addItems({QStringLiteral("Alpha"), QStringLiteral("Beta"), QStringLiteral("Gamma")});
+        return combo;
+    }
+    if (className == QLatin1String("FluentSpinBox")) {
+        auto spin = std::make_unique<FluentSpinBox>();
+        spin->setValue(42);
+        return spin;
+    }
+    if (className == QLatin1String("FluentSlider")) {
+        auto slider = std::make_unique<FluentSlider>(Qt::Horizontal);
+        slider->setValue(40);
+        return slider;
+    }
+    if (className == QLatin1String("FluentProgressBar")) {
+        auto bar = std::make_unique<FluentProgressBar>();
+        bar->setValue(60);
+        return bar;
+    }
+    if (className == QLatin1String("FluentProgressRing")) {
+        auto ring = std::make_unique<FluentProgressRing>();
+        ring->setValue(60);
+        return ring;
+    }
+    if (className == QLatin1String("FluentLabel")) {
+        return std::make_unique<FluentLabel>(QStringLiteral("The quick brown fox jumps over the lazy dog"));
+    }
+    if (className == QLatin1String("FluentCard")) {
+        auto card = std::make_unique<FluentCard>();
+        auto *layout = new QVBoxLayout(card.get());
+        layout->addWidget(new FluentLabel(QStringLiteral("Card title"), card.get()));
+        layout->addWidget(new FluentButton(QStringLiteral("Action"), card.get()));
+        return card;
+    }
+    if (className == QLatin1String("FluentGroupBox")) {
+        auto group = std::make_unique<FluentGroupBox>(QStringLiteral("Group"));
+        auto *layout = new QVBoxLayout(group.get());
+        layout->addWidget(new FluentCheckBox(QStringLiteral("Option"), group.get()));
+        return group;
+    }
+    if (className == QLatin1String("FluentListView")) {
+        auto list = std::make_unique<FluentListView>();
+        QStringList rows;
+        for (int i = 0; i < 200; ++i) {
+            rows << QStringLiteral("Row %1").arg(i);
+        }
+        list->setModel(new QStringListModel(rows, list.get()));
+        return list;
+    }
+    if (className == QLatin1String("FluentTableView")) {
+        auto table = std::make_unique<FluentTableView>();
+        auto *model = new QStandardItemModel(100, 4, table.get());
+        for (int row = 0; row < model->rowCount(); ++row) {
+            for (int column = 0; column < model->columnCount(); ++column) {
+                model->setItem(row, column, new QStandardItem(QStringLiteral("%1:%2").arg(row).arg(column)));
+            }
+        }
+        table->setModel(model);
+        return table;
+    }
+    if (className == QLatin1String("FluentTextEdit")) {
+        auto edit = std::make_unique<FluentTextEdit>();
+        edit->setPlainText(QStringLiteral("Lorem ipsum dolor sit amet.\n").repeated(40));
+        return edit;
+    }
+    if (className == QLatin1String("FluentTabWidget")) {
+        auto tabs = std::make_unique<FluentTabWidget>();
+        tabs->addTab(new FluentLabel(QStringLiteral("First page"), tabs.get()), QStringLiteral("First"));
+        tabs->addTab(new FluentLabel(QStringLiteral("Second page"), tabs.get()), QStringLiteral("Second"));
+        return tabs;
+    }
+    return nullptr;
+}
+
+QStringList paintedClasses()
+{
+    return {QStringLiteral("FluentButton"),
+            QStringLiteral("FluentToolButton"),
+            QStringLiteral("FluentCheckBox"),
+            QStringLiteral("FluentRadioButton"),
+            QStringLiteral("FluentToggleSwitch"),
+            QStringLiteral("FluentLineEdit"),
+            QStringLiteral("FluentComboBox"),
+            QStringLiteral("FluentSpinBox"),
+            QStringLiteral("FluentSlider"),
+            QStringLiteral("FluentProgressBar"),
+            QStringLiteral("FluentProgressRing"),
+            QStringLiteral("FluentLabel"),
+            QStringLiteral("FluentCard"),
+            QStringLiteral("FluentGroupBox"),
+            QStringLiteral("FluentListView"),
+            QStringLiteral("FluentTableView"),
+            QStringLiteral("FluentTextEdit"),
+            QStringLiteral("FluentTabWidget")};
+}
+
+QStringList constructedClasses()
+{
+    return {QStringLiteral("FluentButton"),
+            QStringLiteral("FluentToolButton"),
+            QStringLiteral("FluentCheckBox"),
+            QStringLiteral("FluentRadioButton"),
+            QStringLiteral("FluentToggleSwitch"),
+            QStringLiteral("FluentLineEdit")};
+}
+
+// Bytes currently handed out by the C heap, or -1 where the allocator cannot
+// report it; only differences between two samples are meaningful.
+qint64 heapBytesInUse()
+{
+#ifdef QTFLUENT_BENCHMARK_HAS_MALLINFO2
+    return static_cast<qint64>(mallinfo2().uordblks);
+#else
+    return -1;
+#endif
+}
+
+QImage makeTarget(const QSize &size, qreal dpr)
+{
+    QImage image(size * dpr, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+    image.fill(Qt::transparent);
+    return image;
+}
+
+QString syntheticSource(int lines)
+{
+    static const char *const kSnippet[] = {
+        "#include <vector>",
+        "// Accumulates weighted samples.",
+        "template <typename T> struct Accumulator {",
+        "    std::vector<T> values; /* stored samples */",
+        "    double sum(double weight = 1.5) const {",
+        "        double total = 0.0;",
+        "        for (const T &v : values) { total += v * weight; }",
+        "        return total > 0x10 ? total : -1.0e3;",
+        "    }",
+        "    const char *name() const { return \"accumulator\"; }",
+        "};",
+        "",
+    };
+    constexpr int kSnippetLines = int(sizeof(kSnippet) / sizeof(kSnippet[0]));
+
+    QString text;
+    text.reserve(lines * 40);
+    for (int i = 0; i < lines; ++i) {
+        text += QLatin1String(kSnippet[i % kSnippetLines]);
+        text += QLatin1Char('\n');
+    }
+    return text;
+}
+
+} // namespace
+
+class QtFluentWidgetsBenchmarks final : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        m_animationsEnabled = ThemeManager::instance().animationsEnabled();
+        m_themeMode = ThemeManager::instance().themeMode();
+        ThemeManager::instance().setAnimationsEnabled(false);
+        ThemeManager::instance().setThemeMode(ThemeManager::ThemeMode::Light);
+        QCoreApplication::processEvents();
+    }
+
+    void cleanupTestCase()
+    {
+        ThemeManager::instance().setAnimationsEnabled(m_animationsEnabled);
+        ThemeManager::instance().setThemeMode(m_themeMode);
+        QCoreApplication::processEvents();
+    }
+
+    void paintWidget_data()
+    {
+        QTest::addColumn<QString>("className");
+        QTest::addColumn<qreal>("scale");
+        QTest::addColumn<qreal>("dpr");
+
+        const qreal scales[] = {1.0, 2.5};
+        const qreal dprs[] = {1.0, 1.5, 2.0};
+        const QStringList classes = paintedClasses();
+        for (const QString &className : classes) {
+            for (qreal scale : scales) {
+                for (qreal dpr : dprs) {
+                    const QString tag = QStringLiteral("%1 size=%2x dpr=%3").arg(className).arg(scale).arg(dpr);
+                    QTest::newRow(qPrintable(tag)) << className << scale << dpr;
+                }
+            }
+        }
+    }
+
+    void paintWidget()
+    {
+        QFETCH(QString, className);
+        QFETCH(qreal, scale);
+        QFETCH(qreal, dpr);
+
+        std::unique_ptr<QWidget> widget = createWidget(className);
+        QVERIFY2(widget, qPrintable(className));
+        widget->ensurePolished();
+        const QSize hint = widget->sizeHint().expandedTo(QSize(48, 24));
+        widget->resize(QSize(qRound(hint.width() * scale), qRound(hint.height() * qMin<qreal>(scale, 1.5))));
+        QImage target = makeTarget(widget->size(), dpr);
+        widget->render(&target);
+
+        QBENCHMARK {
+            widget->render(&target);
+        }
+    }
+
+    void constructControls_data()
+    {
+        QTest::addColumn<QString>("className");
+
+        const QStringList classes = constructedClasses();
+        for (const QString &className : classes) {
+            QTest::newRow(qPrintable(className)) << className;
+        }
+    }
+
+    // One iteration builds 10k idle controls under one parent and destroys
+    // them again.
+    void constructControls()
+    {
+        QFETCH(QString, className);
+        constexpr int kCount = 10000;
+
+        QBENCHMARK {
+            QWidget host;
+            for (int i = 0; i < kCount; ++i) {
+                createWidget(className).release()->setParent(&host);
+            }
+        }
+    }
+
+    void controlHeapBytes_data()
+    {
+        constructControls_data();
+    }
+
+    // Heap bytes one idle control keeps alive, averaged over 10k instances.
+    void controlHeapBytes()
+    {
+        QFETCH(QString, className);
+        constexpr int kCount = 10000;
+
+        if (heapBytesInUse() < 0) {
+            QSKIP("Heap usage is only reported with glibc 2.33 or newer");
+        }
+
+        QWidget host;
+        std::vector<QWidget *> widgets;
+        widgets.reserve(kCount);
+        const qint64 before = heapBytesInUse();
+        for (int i = 0; i < kCount; ++i) {
+            QWidget *widget = createWidget(className).release();
+            widget->setParent(&host);
+            widgets.push_back(widget);
+        }
+        const qint64 after = heapBytesInUse();
+        QVERIFY(after >= before);
+        QTest::setBenchmarkResult(qreal(after - before) / kCount, QTest::BytesAllocated);
+    }
+
+    void flowLayoutReflow_data()
+    {
+        QTest::addColumn<int>("items");
+        QTest::addColumn<bool>("uniform");
+
+        QTest::newRow("50 items") << 50 << false;
+        QTest::newRow("500 items") << 500 << false;
+        QTest::newRow("500 items uniform") << 500 << true;
+    }
+
+    void flowLayoutReflow()
+    {
+        QFETCH(int, items);
+        QFETCH(bool, uniform);
+
+        QWidget host;
+        auto *flow = new FluentFlowLayout(&host, 8, 8, 8);
+        flow->setAnimationEnabled(false);
+        flow->setUniformItemWidthEnabled(uniform);
+        flow->setMinimumItemWidth(160);
+        for (int i = 0; i < items; ++i) {
+            auto *tile = new FluentButton(QStringLiteral("Tile %1").arg(i), &host);
+            tile->setMinimumSize(80 + (i % 5) * 16, 32);
+            flow->addWidget(tile);
+        }
+
+        const int widths[] = {640, 960, 1280, 800};
+        int step = 0;
+        QBENCHMARK {
+            const int width = widths[step++ % 4];
+            flow->setGeometry(QRect(0, 0, width, flow->heightForWidth(width)));
+        }
+    }
+
+    void themeSwitch_data()
+    {
+        QTest::addColumn<int>("widgets");
+
+        QTest::newRow("100 widgets") << 100;
+        QTest::newRow("1000 widgets") << 1000;
+    }
+
+    void themeSwitch()
+    {
+        QFETCH(int, widgets);
+
+        QWidget host;
+        auto *flow = new FluentFlowLayout(&host, 8, 6, 6);
+        flow->setAnimationEnabled(false);
+        for (int i = 0; i < widgets; ++i) {
+            QWidget *widget = nullptr;
+            switch (i % 4) {
+            case 0:
+                widget = new FluentButton(QStringLiteral("Button %1").arg(i), &host);
+                break;
+            case 1:
+                widget = new FluentLabel(QStringLiteral("Label %1").arg(i), &host);
+                break;
+            case 2:
+                widget = new FluentLineEdit(QStringLiteral("Edit %1").arg(i), &host);
+                break;
+            default:
+                widget = new FluentCheckBox(QStringLiteral("Check %1").arg(i), &host);
+                break;
+            }
+            flow->addWidget(widget);
+        }
+        host.resize(1280, 800);
+        host.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&host));
+
+        bool dark = false;
+        QBENCHMARK {
+            dark = !dark;
+            ThemeManager::instance().setThemeMode(dark ? ThemeManager::ThemeMode::Dark : ThemeManager::ThemeMode::Light);
+            QCoreApplication::processEvents();
+            host.repaint();
+        }
+
+        ThemeManager::instance().setThemeMode(ThemeManager::ThemeMode::Light);
+        QCoreApplication::processEvents();
+    }
+
+    void iconPaint_data()
+    {
+        QTest::addColumn<int>("extent");
+        QTest::addColumn<qreal>("dpr");
+
+        const int extents[] = {16, 32, 64};
+        const qreal dprs[] = {1.0, 2.0};
+        for (int extent : extents) {
+            for (qreal dpr : dprs) {
+                QTest::newRow(qPrintable(QStringLiteral("%1px dpr=%2").arg(extent).arg(dpr))) << extent << dpr;
+            }
+        }
+    }
+
+    void iconPaint()
+    {
+        QFETCH(int, extent);
+        QFETCH(qreal, dpr);
+
+        QImage target = makeTarget(QSize(extent, extent), dpr);
+        const QRectF rect(0, 0, extent, extent);
+        const int first = int(FluentIconType::Add);
+        const int last = int(FluentIconType::ZoomOut);
+
+        QBENCHMARK {
+            QPainter painter(&target);
+            for (int type = first; type <= last; ++type) {
+                FluentIcon::paintIcon(&painter, FluentIconType(type), rect);
+            }
+        }
+    }
+
+    void stateFill_data()
+    {
+        QTest::addColumn<QString>("blend");
+
+        QTest::newRow("Style::mix") << QStringLiteral("mix");
+        QTest::newRow("float mix") << QStringLiteral("float");
+        QTest::newRow("fillForState") << QStringLiteral("fillForState");
+    }
+
+    void stateFill()
+    {
+        QFETCH(QString, blend);
+
+        // The float row is the floating point Style::mix() it replaced.
+        auto floatMix = [](const QColor &a, const QColor &b, qreal t) {
+            return QColor::fromRgbF(a.redF() + (b.redF() - a.redF()) * t,
+                                    a.greenF() + (b.greenF() - a.greenF()) * t,
+                                    a.blueF() + (b.blueF() - a.blueF()) * t,
+                                    a.alphaF() + (b.alphaF() - a.alphaF()) * t);
+        };
+        const ThemeColors &colors = ThemeManager::instance().colors();
+        const ButtonVisuals::StateColors state =
+            ButtonVisuals::resolve(colors, Theme::tokens(colors), false, false, true);
+
+        // One iteration blends a 32 x 32 grid of hover and press levels, about
+        // what a button grid repaints over one hover-and-press animation.
+        quint64 sink = 0;
+        QBENCHMARK {
+            for (int h = 0; h < 32; ++h) {
+                for (int p = 0; p < 32; ++p) {
+                    const qreal hover = h / 31.0;
+                    const qreal press = p / 31.0;
+                    QColor fill;
+                    if (blend == QLatin1String("mix")) {
+                        fill = Style::mix(Style::mix(state.base, state.hover, hover), state.pressed, press);
+                    } else if (blend == QLatin1String("float")) {
+                        fill = floatMix(floatMix(state.base, state.hover, hover), state.pressed, press);
+                    } else {
+                        fill = ButtonVisuals::fillForState(state, hover, press);
+                    }
+                    sink += fill.rgba();
+                }
+            }
+        }
+        QVERIFY(sink != 0);
+    }
+
+    void highlighter_data()
+    {
+        QTest::addColumn<int>("lines");
+
+        QTest::newRow("2000 lines") << 2000;
+        QTest::newRow("20000 lines") << 20000;
+    }
+
+    void highlighter()
+    {
+        QFETCH(int, lines);
+
+        QTextDocument document;
+        document.setPlainText(syntheticSource(lines));
+        FluentCppHighlighter highlighter(&document);
+
+        QBENCHMARK {
+            highlighter.rehighlight();
+        }
+    }
+
+    void lottieFrames_data()
+    {
+        QTest::addColumn<QString>("path");
+        QTest::addColumn<qreal>("dpr");
+
+        const QDir dir(QString::fromUtf8(QTFLUENT_BENCHMARK_LOTTIE_DIR));
+        const QStringList files = dir.entryList({QStringLiteral("*.json")}, QDir::Files, QDir::Name);
+        if (files.isEmpty()) {
+            QTest::newRow("missing") << QString() << qreal(1.0);
+            return;
+        }
+        const qreal dprs[] = {1.0, 2.0};
+        for (const QString &file : files) {
+            for (qreal dpr : dprs) {
+                QTest::newRow(qPrintable(QStringLiteral("%1 dpr=%2").arg(file).arg(dpr))) << dir.filePath(file) << dpr;
+            }
+        }
+    }
+
+    void lottieFrames()
+    {
+        QFETCH(QString, path);
+        QFETCH(qreal, dpr);
+        if (path.isEmpty()) {
+            QSKIP("No Lottie assets found; set QTFLUENT_BENCHMARK_LOTTIE_DIR");
+        }
+
+        FluentLottieWidget widget;
+        QVERIFY2(widget.load(path), qPrintable(widget.errorString()));
+        widget.resize(96, 96);
+        const int frames = qMax(1, widget.totalFrames());
+        QImage target = makeTarget(widget.size(), dpr);
+
+        // One iteration renders every frame once, like a full playback.
+        QBENCHMARK {
+            for (int frame = 0; frame < frames; ++frame) {
+                widget.setCurrentFrame(frame);
+                widget.render(&target);
+            }
+        }
+    }
+
+private:
+    bool m_animationsEnabled = true;
+    ThemeManager::ThemeMode m_themeMode = ThemeManager::ThemeMode::Light;
+};
+
+QTEST_MAIN(QtFluentWidgetsBenchmarks)
+#include "QtFluentWidgetsBenchmarks.moc"
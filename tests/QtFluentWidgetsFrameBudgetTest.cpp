@@ -0,0 +1,561 @@
+#include "Fluent/FluentButton.h"
+#include "Fluent/FluentCheckBox.h"
+#include "Fluent/FluentComboBox.h"
+#include "Fluent/FluentLabel.h"
+#include "Fluent/FluentLineEdit.h"
+#include "Fluent/FluentListView.h"
+#include "Fluent/FluentMainWindow.h"
+#include "Fluent/FluentMenu.h"
+#include "Fluent/FluentMotion.h"
+#include "Fluent/FluentNavigationView.h"
+#include "Fluent/FluentTheme.h"
+
+#include <QtTest/QtTest>
+
+#include <QApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGridLayout>
+#include <QHash>
+#include <QHBoxLayout>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QStringListModel>
+#include <QTimer>
+#include <QVBoxLayout>
+#include <QVector>
+#include <QWidget>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+using namespace Fluent;
+
+// Drives scripted interactions against shown offscreen windows with motion on
+// and checks what they cost against per-scenario budgets:
+//   - frame time: one top-level QEvent::UpdateRequest, i.e. painting every
+//     dirty widget of the window and flushing the backing store;
+//   - event-loop latency: how late a 4 ms precise heartbeat timer fires, so
+//     long synchronous work (a theme dispatch, a popup build) shows up even
+//     when it does not paint.
+// Budgets come from tests/frame-budgets.json, or from the file named by
+// QTFLUENT_FRAME_BUDGETS. Millisecond budgets are multiplied by the file's
+// "scale" ("debugScale" in Debug builds) or by QTFLUENT_FRAME_BUDGET_SCALE.
+// With QTFLUENT_FRAME_BUDGET_OUTPUT_DIR set, the measured numbers are written
+// to frame-budgets.json there.
+
+namespace {
+
+#ifndef QTFLUENT_FRAME_BUDGET_FILE
+#define QTFLUENT_FRAME_BUDGET_FILE ""
+#endif
+
+constexpr int kHeartbeatMs = 4;
+
+struct FrameBudget {
+    double p95FrameMs = 16.0;
+    double maxFrameMs = 50.0;
+    double maxLatencyMs = 120.0;
+    int minFrames = 1;
+};
+
+struct FrameStats {
+    int frames = 0;
+    int paints = 0;
+    double p50FrameMs = 0.0;
+    double p95FrameMs = 0.0;
+    double maxFrameMs = 0.0;
+    double maxLatencyMs = 0.0;
+};
+
+double nsToMs(qint64 ns)
+{
+    return static_cast<double>(ns) / 1000000.0;
+}
+
+double percentileMs(QVector<qint64> samples, double fraction)
+{
+    if (samples.isEmpty()) {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    const int count = static_cast<int>(samples.size());
+    const int rank = qBound(0, static_cast<int>(std::ceil(fraction * count)) - 1, count - 1);
+    return nsToMs(samples.at(rank));
+}
+
+// Times each top-level repaint by delivering the UpdateRequest itself, the
+// same way Diagnostics' paint probe times Paint events.
+class FrameRecorder final : public QObject
+{
+public:
+    FrameRecorder()
+    {
+        m_heartbeat.setTimerType(Qt::PreciseTimer);
+        m_heartbeat.setInterval(kHeartbeatMs);
+        QObject::connect(&m_heartbeat, &QTimer::timeout, this, [this]() { beat(); });
+    }
+
+    ~FrameRecorder() override
+    {
+        stop();
+    }
+
+    void start()
+    {
+        m_frameNs.clear();
+        m_lateNs.clear();
+        m_paints = 0;
+        m_lastBeatNs = -1;
+        m_clock.start();
+        QCoreApplication::instance()->installEventFilter(this);
+        m_heartbeat.start();
+        m_recording = true;
+    }
+
+    void stop()
+    {
+        if (!m_recording) {
+            return;
+        }
+        m_recording = false;
+        m_heartbeat.stop();
+        QCoreApplication::instance()->removeEventFilter(this);
+    }
+
+    FrameStats stats() const
+    {
+        FrameStats stats;
+        stats.frames = static_cast<int>(m_frameNs.size());
+        stats.paints = m_paints;
+        stats.p50FrameMs = percentileMs(m_frameNs, 0.50);
+        stats.p95FrameMs = percentileMs(m_frameNs, 0.95);
+        stats.maxFrameMs = percentileMs(m_frameNs, 1.0);
+        stats.maxLatencyMs = percentileMs(m_lateNs, 1.0);
+        return stats;
+    }
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (event->type() == QEvent::Paint) {
+            ++m_paints;
+            return QObject::eventFilter(watched, event);
+        }
+        if (event->type() != QEvent::UpdateRequest || event == m_inFlight || !watched->isWidgetType() ||
+            !static_cast<QWidget *>(watched)->isWindow()) {
+            return QObject::eventFilter(watched, event);
+        }
+
+        QEvent *outer = m_inFlight;
+        m_inFlight = event;
+        QElapsedTimer timer;
+        timer.start();
+        QCoreApplication::sendEvent(watched, event);
+        m_frameNs.push_back(timer.nsecsElapsed());
+        m_inFlight = outer;
+        return true;
+    }
+
+private:
+    void beat()
+    {
+        const qint64 now = m_clock.nsecsElapsed();
+        if (m_lastBeatNs >= 0) {
+            m_lateNs.push_back(qMax<qint64>(0, now - m_lastBeatNs - qint64(kHeartbeatMs) * 1000000));
+        }
+        m_lastBeatNs = now;
+    }
+
+    QTimer m_heartbeat;
+    QElapsedTimer m_clock;
+    QVector<qint64> m_frameNs;
+    QVector<qint64> m_lateNs;
+    QEvent *m_inFlight = nullptr;
+    qint64 m_lastBeatNs = -1;
+    int m_paints = 0;
+    bool m_recording = false;
+};
+
+FrameBudget budgetFromJson(const QJsonObject &object, FrameBudget budget)
+{
+    budget.p95FrameMs = object.value(QStringLiteral("p95FrameMs")).toDouble(budget.p95FrameMs);
+    budget.maxFrameMs = object.value(QStringLiteral("maxFrameMs")).toDouble(budget.maxFrameMs);
+    budget.maxLatencyMs = object.value(QStringLiteral("maxLatencyMs")).toDouble(budget.maxLatencyMs);
+    budget.minFrames = object.value(QStringLiteral("minFrames")).toInt(budget.minFrames);
+    return budget;
+}
+
+QJsonObject statsToJson(const FrameStats &stats, const FrameBudget &budget)
+{
+    QJsonObject measured;
+    measured.insert(QStringLiteral("frames"), stats.frames);
+    measured.insert(QStringLiteral("paints"), stats.paints);
+    measured.insert(QStringLiteral("p50FrameMs"), stats.p50FrameMs);
+    measured.insert(QStringLiteral("p95FrameMs"), stats.p95FrameMs);
+    measured.insert(QStringLiteral("maxFrameMs"), stats.maxFrameMs);
+    measured.insert(QStringLiteral("maxLatencyMs"), stats.maxLatencyMs);
+
+    QJsonObject limits;
+    limits.insert(QStringLiteral("p95FrameMs"), budget.p95FrameMs);
+    limits.insert(QStringLiteral("maxFrameMs"), budget.maxFrameMs);
+    limits.insert(QStringLiteral("maxLatencyMs"), budget.maxLatencyMs);
+    limits.insert(QStringLiteral("minFrames"), budget.minFrames);
+
+    QJsonObject entry;
+    entry.insert(QStringLiteral("measured"), measured);
+    entry.insert(QStringLiteral("budget"), limits);
+    return entry;
+}
+
+QString budgetFailure(const QString &scenario, const FrameStats &stats, const FrameBudget &budget)
+{
+    QStringList failures;
+    if (stats.frames < budget.minFrames) {
+        failures << QStringLiteral("%1 frames < %2 expected (the scenario did not animate)")
+                        .arg(stats.frames)
+                        .arg(budget.minFrames);
+    }
+    if (stats.p95FrameMs > budget.p95FrameMs) {
+        failures << QStringLiteral("p95 frame %1 ms > %2 ms")
+                        .arg(stats.p95FrameMs, 0, 'f', 2)
+                        .arg(budget.p95FrameMs, 0, 'f', 2);
+    }
+    if (stats.maxFrameMs > budget.maxFrameMs) {
+        failures << QStringLiteral("max frame %1 ms > %2 ms")
+                        .arg(stats.maxFrameMs, 0, 'f', 2)
+                        .arg(budget.maxFrameMs, 0, 'f', 2);
+    }
+    if (stats.maxLatencyMs > budget.maxLatencyMs) {
+        failures << QStringLiteral("event-loop latency %1 ms > %2 ms")
+                        .arg(stats.maxLatencyMs, 0, 'f', 2)
+                        .arg(budget.maxLatencyMs, 0, 'f', 2);
+    }
+    if (failures.isEmpty()) {
+        return {};
+    }
+    return QStringLiteral("%1 over budget: %2").arg(scenario, failures.join(QStringLiteral("; ")));
+}
+
+bool showWindow(QWidget *window, const QSize &size)
+{
+    window->resize(size);
+    window->show();
+    if (!QTest::qWaitForWindowExposed(window)) {
+        return false;
+    }
+    // Let first-show work (title bar, deferred theming, layout) settle
+    // before anything is recorded.
+    QTest::qWait(120);
+    return true;
+}
+
+} // namespace
+
+class QtFluentWidgetsFrameBudgetTest final : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        m_animationsEnabled = ThemeManager::instance().animationsEnabled();
+        m_themeMode = ThemeManager::instance().themeMode();
+        m_accentBorderEnabled = ThemeManager::instance().accentBorderEnabled();
+        m_accentBorderStyle = ThemeManager::instance().accentBorderStyle();
+        ThemeManager::instance().setAnimationsEnabled(true);
+        ThemeManager::instance().setThemeMode(ThemeManager::ThemeMode::Light);
+        QCoreApplication::processEvents();
+        loadBudgets();
+    }
+
+    void cleanupTestCase()
+    {
+        ThemeManager::instance().setAccentBorderStyle(m_accentBorderStyle);
+        ThemeManager::instance().setAccentBorderEnabled(m_accentBorderEnabled);
+        ThemeManager::instance().setAnimationsEnabled(m_animationsEnabled);
+        ThemeManager::instance().setThemeMode(m_themeMode);
+        QCoreApplication::processEvents();
+        writeReport();
+    }
+
+    void hoverSweep()
+    {
+        QStringList rows;
+        for (int i = 0; i < 400; ++i) {
+            rows << QStringLiteral("Row %1 with some secondary text").arg(i);
+        }
+        QStringListModel model(rows);
+
+        FluentListView view;
+        view.setModel(&model);
+        QVERIFY(showWindow(&view, QSize(360, 420)));
+
+        QVector<QPoint> path;
+        for (int row = 0; row < rows.size(); ++row) {
+            const QRect rect = view.visualRect(model.index(row, 0));
+            if (!rect.isValid() || !view.viewport()->rect().contains(rect.center())) {
+                break;
+            }
+            path << rect.center();
+        }
+        QVERIFY(path.size() > 4);
+
+        FrameRecorder recorder;
+        recorder.start();
+        for (int pass = 0; pass < 2; ++pass) {
+            for (const QPoint &point : std::as_const(path)) {
+                QTest::mouseMove(view.viewport(), point);
+                QTest::qWait(16);
+            }
+            std::reverse(path.begin(), path.end());
+        }
+        QTest::qWait(FluentMotion::configuredDuration(FluentMotionRole::Hover) + 40);
+        recorder.stop();
+
+        verifyBudget(QStringLiteral("hoverSweep"), recorder.stats());
+    }
+
+    void themeToggle()
+    {
+        QWidget window;
+        auto *grid = new QGridLayout(&window);
+        for (int i = 0; i < 40; ++i) {
+            const int row = i / 4;
+            const int column = (i % 4) * 3;
+            grid->addWidget(new FluentButton(QStringLiteral("Button %1").arg(i), &window), row, column);
+            auto *check = new FluentCheckBox(QStringLiteral("Check %1").arg(i), &window);
+            check->setChecked(i % 2 == 0);
+            grid->addWidget(check, row, column + 1);
+            if (i % 2 == 0) {
+                grid->addWidget(new FluentLineEdit(QStringLiteral("Edit %1").arg(i), &window), row, column + 2);
+            } else {
+                grid->addWidget(new FluentLabel(QStringLiteral("Label %1").arg(i), &window), row, column + 2);
+            }
+        }
+        QVERIFY(showWindow(&window, QSize(960, 540)));
+
+        FrameRecorder recorder;
+        recorder.start();
+        for (int i = 0; i < 6; ++i) {
+            ThemeManager::instance().setThemeMode(i % 2 == 0 ? ThemeManager::ThemeMode::Dark
+                                                             : ThemeManager::ThemeMode::Light);
+            QTest::qWait(80);
+        }
+        recorder.stop();
+        ThemeManager::instance().setThemeMode(ThemeManager::ThemeMode::Light);
+        QCoreApplication::processEvents();
+
+        verifyBudget(QStringLiteral("themeToggle"), recorder.stats());
+    }
+
+    void paneToggle()
+    {
+        QWidget window;
+        auto *layout = new QHBoxLayout(&window);
+        layout->setContentsMargins(0, 0, 0, 0);
+        auto *nav = new FluentNavigationView(&window);
+        std::vector<FluentNavigationItem> items;
+        for (int i = 0; i < 12; ++i) {
+            FluentNavigationItem item;
+            item.key = QStringLiteral("item%1").arg(i);
+            item.text = QStringLiteral("Navigation item %1").arg(i);
+            item.hasFluentIcon = true;
+            items.push_back(item);
+        }
+        nav->setItems(items);
+        nav->setSelectedKey(QStringLiteral("item0"));
+        layout->addWidget(nav);
+        layout->addWidget(new FluentLabel(QStringLiteral("Content"), &window), 1);
+        QVERIFY(showWindow(&window, QSize(720, 480)));
+
+        const int settleMs = qMax(FluentMotion::configuredDuration(FluentMotionRole::Navigation),
+                                  FluentMotion::configuredDuration(FluentMotionRole::Collapse)) + 60;
+
+        FrameRecorder recorder;
+        recorder.start();
+        for (int i = 0; i < 4; ++i) {
+            nav->toggleExpanded();
+            QTest::qWait(settleMs);
+        }
+        recorder.stop();
+
+        verifyBudget(QStringLiteral("paneToggle"), recorder.stats());
+    }
+
+    void popupOpenClose()
+    {
+        QWidget window;
+        auto *layout = new QVBoxLayout(&window);
+        auto *combo = new FluentComboBox(&window);
+        for (int i = 0; i < 30; ++i) {
+            combo->addItem(QStringLiteral("Choice %1").arg(i));
+        }
+        auto *menuButton = new FluentButton(QStringLiteral("Menu"), &window);
+        layout->addWidget(combo);
+        layout->addWidget(menuButton);
+        layout->addStretch(1);
+        FluentMenu menu;
+        for (int i = 0; i < 12; ++i) {
+            menu.addAction(QStringLiteral("Command %1").arg(i));
+        }
+        QVERIFY(showWindow(&window, QSize(360, 420)));
+
+        const int openMs = FluentMotion::configuredDuration(FluentMotionRole::PopupOpen) + 60;
+        const int closeMs = FluentMotion::configuredDuration(FluentMotionRole::PopupClose) + 60;
+
+        FrameRecorder recorder;
+        recorder.start();
+        for (int i = 0; i < 3; ++i) {
+            combo->showPopup();
+            QTest::qWait(openMs);
+            combo->hidePopup();
+            QTest::qWait(closeMs);
+
+            menu.popup(menuButton->mapToGlobal(menuButton->rect().bottomLeft()));
+            QTest::qWait(openMs);
+            menu.close();
+            QTest::qWait(closeMs);
+        }
+        recorder.stop();
+
+        verifyBudget(QStringLiteral("popupOpenClose"), recorder.stats());
+    }
+
+    void flowBorder()
+    {
+        struct BorderRestore {
+            bool enabled = ThemeManager::instance().accentBorderEnabled();
+            ThemeManager::AccentBorderStyle style = ThemeManager::instance().accentBorderStyle();
+
+            ~BorderRestore()
+            {
+                ThemeManager::instance().setAccentBorderStyle(style);
+                ThemeManager::instance().setAccentBorderEnabled(enabled);
+            }
+        } restore;
+
+        ThemeManager::instance().setAccentBorderEnabled(true);
+        ThemeManager::instance().setAccentBorderStyle(ThemeManager::AccentBorderStyle::Flow);
+
+        FluentMainWindow window;
+        window.setCentralWidget(new FluentLabel(QStringLiteral("Flow border")));
+        QVERIFY(showWindow(&window, QSize(480, 320)));
+        window.activateWindow();
+        const bool active = QTest::qWaitForWindowActive(&window);
+
+        constexpr int kTicks = 90;
+        QSignalSpy ticks(&ThemeManager::instance(), &ThemeManager::flowTick);
+        FrameRecorder recorder;
+        recorder.start();
+        QTest::qWait(200);
+        if (ticks.isEmpty()) {
+            recorder.stop();
+            QVERIFY2(!active, "The Flow border should tick while its window is active");
+            QSKIP("The Flow border only runs while the application is active; this platform never activates it");
+        }
+        QTRY_VERIFY_WITH_TIMEOUT(ticks.size() >= kTicks, 10000);
+        recorder.stop();
+
+        verifyBudget(QStringLiteral("flowBorder"), recorder.stats());
+    }
+
+private:
+    void loadBudgets()
+    {
+        QString path = qEnvironmentVariable("QTFLUENT_FRAME_BUDGETS");
+        if (path.isEmpty()) {
+            path = QString::fromUtf8(QTFLUENT_FRAME_BUDGET_FILE);
+        }
+
+        QJsonObject root;
+        if (!path.isEmpty()) {
+            QFile file(path);
+            QVERIFY2(file.open(QIODevice::ReadOnly), qPrintable(QStringLiteral("Cannot read %1").arg(path)));
+            QJsonParseError error;
+            const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &error);
+            QVERIFY2(error.error == QJsonParseError::NoError,
+                     qPrintable(QStringLiteral("%1: %2").arg(path, error.errorString())));
+            root = document.object();
+        }
+
+#ifdef QT_DEBUG
+        m_scale = root.value(QStringLiteral("debugScale")).toDouble(4.0);
+#else
+        m_scale = root.value(QStringLiteral("scale")).toDouble(1.0);
+#endif
+        bool scaleOk = false;
+        const double envScale = qEnvironmentVariable("QTFLUENT_FRAME_BUDGET_SCALE").toDouble(&scaleOk);
+        if (scaleOk && envScale > 0.0) {
+            m_scale = envScale;
+        }
+
+        m_defaultBudget = budgetFromJson(root.value(QStringLiteral("default")).toObject(), FrameBudget());
+        const QJsonObject scenarios = root.value(QStringLiteral("scenarios")).toObject();
+        for (auto it = scenarios.constBegin(); it != scenarios.constEnd(); ++it) {
+            m_budgets.insert(it.key(), budgetFromJson(it.value().toObject(), m_defaultBudget));
+        }
+    }
+
+    FrameBudget budgetFor(const QString &scenario) const
+    {
+        FrameBudget budget = m_budgets.value(scenario, m_defaultBudget);
+        budget.p95FrameMs *= m_scale;
+        budget.maxFrameMs *= m_scale;
+        budget.maxLatencyMs *= m_scale;
+        return budget;
+    }
+
+    void verifyBudget(const QString &scenario, const FrameStats &stats)
+    {
+        const FrameBudget budget = budgetFor(scenario);
+        m_report.insert(scenario, statsToJson(stats, budget));
+        qInfo().noquote() << QStringLiteral("[FrameBudget] %1 frames=%2 paints=%3 p50=%4 ms p95=%5/%6 ms max=%7/%8 ms latency=%9/%10 ms")
+                                 .arg(scenario)
+                                 .arg(stats.frames)
+                                 .arg(stats.paints)
+                                 .arg(stats.p50FrameMs, 0, 'f', 2)
+                                 .arg(stats.p95FrameMs, 0, 'f', 2)
+                                 .arg(budget.p95FrameMs, 0, 'f', 1)
+                                 .arg(stats.maxFrameMs, 0, 'f', 2)
+                                 .arg(budget.maxFrameMs, 0, 'f', 1)
+                                 .arg(stats.maxLatencyMs, 0, 'f', 2)
+                                 .arg(budget.maxLatencyMs, 0, 'f', 1);
+
+        const QString failure = budgetFailure(scenario, stats, budget);
+        QVERIFY2(failure.isEmpty(), qPrintable(failure));
+    }
+
+    void writeReport() const
+    {
+        const QString outputDir = qEnvironmentVariable("QTFLUENT_FRAME_BUDGET_OUTPUT_DIR");
+        if (outputDir.isEmpty()) {
+            return;
+        }
+        QDir().mkpath(outputDir);
+
+        QJsonObject root;
+        root.insert(QStringLiteral("scale"), m_scale);
+        root.insert(QStringLiteral("scenarios"), m_report);
+        QFile file(QDir(outputDir).filePath(QStringLiteral("frame-budgets.json")));
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+        }
+    }
+
+    QHash<QString, FrameBudget> m_budgets;
+    FrameBudget m_defaultBudget;
+    double m_scale = 1.0;
+    QJsonObject m_report;
+
+    bool m_animationsEnabled = true;
+    ThemeManager::ThemeMode m_themeMode = ThemeManager::ThemeMode::Light;
+    bool m_accentBorderEnabled = false;
+    ThemeManager::AccentBorderStyle m_accentBorderStyle = ThemeManager::AccentBorderStyle::Solid;
+};
+
+QTEST_MAIN(QtFluentWidgetsFrameBudgetTest)
+#include "QtFluentWidgetsFrameBudgetTest.moc"
@@ -12,6 +12,7 @@
 #include "Fluent/FluentDatePicker.h"
 #include "Fluent/FluentDateRangePicker.h"
 #include "Fluent/FluentDial.h"
+#include "Fluent/FluentDiagnostics.h"
 #include "Fluent/FluentDialog.h"
 #include "Fluent/FluentDropDownButton.h"
 #include "Fluent/FluentAutoSuggestBox.h"
@@ -40,6 +41,7 @@
 #include "Fluent/FluentProgressRing.h"
 #include "Fluent/FluentQtCompat.h"
 #include "Fluent/FluentRadioButton.h"
+#include "Fluent/FluentResizeHelper.h"
 #include "Fluent/FluentScrollBar.h"
 #include "Fluent/FluentScrollArea.h"
 #include "Fluent/FluentSlider.h"
@@ -65,7 +67,9 @@
 #include "Fluent/datePicker/FluentCalendarPopup.h"
 
 #include "../src/FluentButtonVisuals_p.h"
+#include "../src/FluentFadeLayer_p.h"
 #include "../src/FluentInputVisuals_p.h"
+#include "../src/FluentThemeRegistry_p.h"
 #include "../src/colorPicker/ColorPickerWidgets.h"
 #include "../src/datePicker/FluentWheelPickerSupport.h"
 
@@ -89,6 +93,7 @@
 #include <QFocusEvent>
 #include <QFont>
 #include <QFontMetrics>
+#include <QFrame>
 #include <QGraphicsEffect>
 #include <QGraphicsOpacityEffect>
 #include <QHBoxLayout>
@@ -98,6 +103,9 @@
 #include <QImage>
 #include <QInputMethodEvent>
 #include <QItemSelectionModel>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QKeySequence>
 #include <QLabel>
 #include <QLineEdit>
@@ -3921,6 +3929,409 @@ private slots:
         QCOMPARE(rendered.size(), host.size());
     }
 
+    void idleControlsAllocateMotionLazily()
+    {
+        struct MotionRestore {
+            bool animationsEnabled = ThemeManager::instance().animationsEnabled();
+
+            ~MotionRestore()
+            {
+                ThemeManager::instance().setAnimationsEnabled(animationsEnabled);
+                QCoreApplication::processEvents();
+            }
+        } restore;
+
+        ThemeManager::instance().setAnimationsEnabled(true);
+        QCoreApplication::processEvents();
+
+        auto directAnimationCount = [](QObject *object) {
+            return static_cast<int>(object->findChildren<QVariantAnimation *>(QString(), Qt::FindDirectChildrenOnly).size());
+        };
+
+        auto sendEnter = [](QWidget *widget) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+            QEnterEvent event(QPointF(8, 8), QPointF(8, 8), QPointF(8, 8));
+#else
+            QEvent event(QEvent::Enter);
+#endif
+            QCoreApplication::sendEvent(widget, &event);
+        };
+
+        QWidget host;
+        auto *button = new FluentButton(QStringLiteral("Button"), &host);
+        auto *idleButton = new FluentButton(QStringLiteral("Idle"), &host);
+        auto *toolButton = new FluentToolButton(&host);
+        auto *checkBox = new FluentCheckBox(QStringLiteral("Check"), &host);
+        auto *radio = new FluentRadioButton(QStringLiteral("Radio"), &host);
+        auto *toggle = new FluentToggleSwitch(QStringLiteral("Toggle"), &host);
+        auto *lineEdit = new FluentLineEdit(&host);
+        auto *listView = new FluentListView(&host);
+        auto *codeEditor = new FluentCodeEditor(&host);
+        const QList<QWidget *> idle = {button, idleButton, toolButton, checkBox, radio, toggle, lineEdit, listView, codeEditor};
+        for (QWidget *widget : idle) {
+            QVERIFY2(directAnimationCount(widget) == 0,
+                     qPrintable(QStringLiteral("%1 should not own animations before its first interaction")
+                                    .arg(QString::fromLatin1(widget->metaObject()->className()))));
+        }
+
+        sendEnter(button);
+        QCOMPARE(directAnimationCount(button), 1);
+        QVERIFY2(button->findChild<QVariantAnimation *>(QString(), Qt::FindDirectChildrenOnly)->state() ==
+                     QAbstractAnimation::Running,
+                 "The first hover should allocate and run exactly one animation");
+        QCOMPARE(directAnimationCount(idleButton), 0);
+
+        toggle->setChecked(true);
+        QCOMPARE(directAnimationCount(toggle), 1);
+
+        ThemeManager::instance().setAnimationsEnabled(false);
+        QCoreApplication::processEvents();
+        sendEnter(idleButton);
+        QCOMPARE(idleButton->property("hoverLevel").toReal(), 1.0);
+        QCOMPARE(directAnimationCount(idleButton), 0);
+        sendEnter(lineEdit);
+        QCOMPARE(lineEdit->hoverLevel(), 1.0);
+        QCOMPARE(directAnimationCount(lineEdit), 0);
+    }
+
+    void themeRegistryThemesVisibleFirstAndDefersHiddenWidgets()
+    {
+        struct ThemeRestore {
+            ThemeManager::ThemeMode mode = ThemeManager::instance().themeMode();
+            ThemeColors colors = ThemeManager::instance().colors();
+
+            ~ThemeRestore()
+            {
+                ThemeManager::instance().setColors(colors);
+                ThemeManager::instance().setThemeMode(mode);
+                QCoreApplication::processEvents();
+            }
+        } restore;
+
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+
+        static QStringList *appliedOrder = nullptr;
+        QStringList applied;
+        appliedOrder = &applied;
+        struct OrderReset {
+            ~OrderReset() { appliedOrder = nullptr; }
+        } orderReset;
+
+        const ThemeRegistry::ApplyFn record = [](QWidget *widget) {
+            if (appliedOrder) {
+                appliedOrder->append(widget->objectName());
+            }
+        };
+
+        QWidget window;
+        window.resize(320, 200);
+        auto enrollProbe = [&](QWidget *probe, const QString &name, const QPoint &pos) {
+            probe->setObjectName(name);
+            probe->setGeometry(QRect(pos, QSize(40, 20)));
+            ThemeRegistry::enroll(probe, record);
+            return probe;
+        };
+        enrollProbe(new QFrame(&window), QStringLiteral("frameA"), QPoint(0, 0));
+        enrollProbe(new QLabel(&window), QStringLiteral("labelA"), QPoint(50, 0));
+        enrollProbe(new QFrame(&window), QStringLiteral("frameB"), QPoint(100, 0));
+        enrollProbe(new QLabel(&window), QStringLiteral("labelB"), QPoint(150, 0));
+        enrollProbe(new QFrame(&window), QStringLiteral("frameClipped"), QPoint(4000, 0));
+        QWidget *hiddenProbe = enrollProbe(new QFrame(&window), QStringLiteral("frameHidden"), QPoint(0, 40));
+        hiddenProbe->hide();
+        auto *hiddenLabel = new FluentLabel(QStringLiteral("Deferred"), &window);
+        hiddenLabel->hide();
+
+        constexpr int kHiddenPageLabels = 2000;
+        auto *hiddenPage = new QWidget(&window);
+        for (int i = 0; i < kHiddenPageLabels; ++i) {
+            new FluentLabel(QStringLiteral("Row %1").arg(i), hiddenPage);
+        }
+        hiddenPage->hide();
+
+        auto *lazyPage = new QWidget(&window);
+        auto *lazyPageLabel = new FluentLabel(QStringLiteral("Page"), lazyPage);
+        lazyPage->hide();
+
+        window.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&window));
+        QCoreApplication::processEvents();
+
+        const QString lightSheet = hiddenLabel->styleSheet();
+        applied.clear();
+        ThemeManager::instance().setThemeMode(ThemeManager::ThemeMode::Dark);
+        QTRY_VERIFY(!applied.isEmpty());
+
+        // Visible probes first, grouped by class in first-enrollment order,
+        // then the clipped one; hidden widgets wait.
+        QCOMPARE(applied,
+                 QStringList({QStringLiteral("frameA"),
+                              QStringLiteral("frameB"),
+                              QStringLiteral("labelA"),
+                              QStringLiteral("labelB"),
+                              QStringLiteral("frameClipped")}));
+        const ThemeRegistry::DispatchStats stats = ThemeRegistry::lastDispatch();
+        QVERIFY2(stats.deferred >= kHiddenPageLabels + 2, qPrintable(QString::number(stats.deferred)));
+        QVERIFY(stats.visible >= 4);
+        QVERIFY(stats.offscreen >= 1);
+        QVERIFY(stats.batches >= 3);
+        qInfo().noquote() << QStringLiteral("[Benchmark] theme registry dispatch themed=%1 deferred=%2 batches=%3 %4 ms")
+                                 .arg(stats.applied)
+                                 .arg(stats.deferred)
+                                 .arg(stats.batches)
+                                 .arg(stats.elapsedNs / 1000000.0, 0, 'f', 2);
+
+        QVERIFY(ThemeRegistry::isPending(hiddenProbe));
+        QVERIFY(ThemeRegistry::isPending(hiddenLabel));
+        QCOMPARE(hiddenLabel->styleSheet(), lightSheet);
+
+        hiddenProbe->show();
+        hiddenLabel->show();
+        QCOMPARE(applied.last(), QStringLiteral("frameHidden"));
+        QVERIFY(!ThemeRegistry::isPending(hiddenProbe));
+        QVERIFY(!ThemeRegistry::isPending(hiddenLabel));
+        QVERIFY2(hiddenLabel->styleSheet() != lightSheet, "A deferred widget should pick up the theme when shown");
+
+        // Showing a page delivers Show to its children, whose own filter
+        // themes them.
+        QVERIFY(ThemeRegistry::isPending(lazyPageLabel));
+        lazyPage->show();
+        QVERIFY(!ThemeRegistry::isPending(lazyPageLabel));
+        QVERIFY(lazyPageLabel->styleSheet() != lightSheet);
+
+        const int pendingBefore = ThemeRegistry::pendingCount();
+        QVERIFY(pendingBefore >= kHiddenPageLabels);
+        delete hiddenPage;
+        QCOMPARE(ThemeRegistry::pendingCount(), pendingBefore - kHiddenPageLabels);
+
+        const int enrolled = ThemeRegistry::enrolledCount();
+        {
+            FluentLabel transient;
+            QCOMPARE(ThemeRegistry::enrolledCount(), enrolled + 1);
+        }
+        QCOMPARE(ThemeRegistry::enrolledCount(), enrolled);
+    }
+
+    void controlSurfacesBlitFromNineSliceCache()
+    {
+        struct CacheRestore {
+            bool enabled = Style::surfaceCacheEnabled();
+
+            ~CacheRestore()
+            {
+                Style::setSurfaceCacheEnabled(enabled);
+            }
+        } restore;
+
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+
+        constexpr int kButtons = 50;
+        QWidget toolbar;
+        auto *layout = new QHBoxLayout(&toolbar);
+        layout->setContentsMargins(4, 4, 4, 4);
+        layout->setSpacing(3);
+        for (int i = 0; i < kButtons; ++i) {
+            layout->addWidget(new FluentButton(QStringLiteral("Cmd %1").arg(i), &toolbar));
+        }
+        toolbar.resize(toolbar.sizeHint());
+
+        Style::setSurfaceCacheEnabled(false);
+        const QImage direct = renderWidgetImage(&toolbar);
+
+        Style::setSurfaceCacheEnabled(true);
+        Style::clearSurfaceCache();
+        Style::resetSurfaceCacheStats();
+        const QImage cached = renderWidgetImage(&toolbar);
+        const SurfaceCacheStats first = Style::surfaceCacheStats();
+        QVERIFY2(first.misses <= quint64(4), qPrintable(QString::number(first.misses)));
+        QVERIFY2(first.hits >= quint64(kButtons - 4), qPrintable(QString::number(first.hits)));
+        QVERIFY(first.tiles >= 1);
+        QVERIFY(first.bytes > 0);
+
+        const int changed = changedPixelCount(direct, cached, 24);
+        QVERIFY2(changed <= direct.width() * direct.height() / 200,
+                 qPrintable(QStringLiteral("nine-slice blit differs from direct painting in %1 pixels").arg(changed)));
+
+        renderWidgetImage(&toolbar);
+        const SurfaceCacheStats second = Style::surfaceCacheStats();
+        QCOMPARE(second.misses, first.misses);
+        QVERIFY(second.hits - first.hits >= quint64(kButtons));
+
+        // Half-pixel rects on a 2x device still slice exactly.
+        const ThemeColors &colors = ThemeManager::instance().colors();
+        auto paintSurface = [&](const QTransform &transform) {
+            QImage image(QSize(120, 48) * 2, QImage::Format_ARGB32_Premultiplied);
+            image.setDevicePixelRatio(2.0);
+            image.fill(Qt::transparent);
+            QPainter painter(&image);
+            painter.setTransform(transform);
+            Style::paintControlSurface(painter, QRectF(4.5, 6.5, 100, 32), colors, 0.5, 1.0, true, false);
+            painter.end();
+            return image;
+        };
+        Style::setSurfaceCacheEnabled(false);
+        const QImage directHiDpi = paintSurface(QTransform());
+        Style::setSurfaceCacheEnabled(true);
+        const SurfaceCacheStats beforeHiDpi = Style::surfaceCacheStats();
+        const QImage cachedHiDpi = paintSurface(QTransform());
+        QVERIFY(Style::surfaceCacheStats().misses > beforeHiDpi.misses);
+        QVERIFY2(changedPixelCount(directHiDpi, cachedHiDpi, 24) <= 24,
+                 qPrintable(QString::number(changedPixelCount(directHiDpi, cachedHiDpi, 24))));
+
+        // A rotated painter cannot be sliced and paints directly.
+        const quint64 bypassedBefore = Style::surfaceCacheStats().bypassed;
+        paintSurface(QTransform().rotate(3.0));
+        QCOMPARE(Style::surfaceCacheStats().bypassed, bypassedBefore + 1);
+
+        qInfo().noquote() << QStringLiteral("[Benchmark] surface cache tiles=%1 bytes=%2 hits=%3 misses=%4")
+                                 .arg(second.tiles)
+                                 .arg(second.bytes)
+                                 .arg(second.hits)
+                                 .arg(second.misses);
+
+        Style::setSurfaceCacheEnabled(false);
+        QCOMPARE(Style::surfaceCacheStats().tiles, 0);
+    }
+
+    void elevationShadowsBlitFromCachedBlurTiles()
+    {
+        struct CacheRestore {
+            bool enabled = Style::surfaceCacheEnabled();
+
+            ~CacheRestore()
+            {
+                Style::setSurfaceCacheEnabled(enabled);
+            }
+        } restore;
+
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+        const ThemeColors &colors = ThemeManager::instance().colors();
+        auto renderCards = [&]() {
+            QImage image(360, 160, QImage::Format_ARGB32_Premultiplied);
+            image.fill(colors.background.rgba());
+            QPainter painter(&image);
+            FluentSurfaceSpec spec;
+            spec.level = FluentSurfaceLevel::Popup;
+            spec.elevation = FluentElevationLevel::Medium;
+            paintFluentSurface(painter, QRectF(20, 20, 90, 60), colors, spec);
+            paintFluentSurface(painter, QRectF(130, 20, 200, 40), colors, spec);
+            paintFluentSurface(painter, QRectF(130, 80, 64, 64), colors, spec);
+            painter.end();
+            return image;
+        };
+
+        // With the cache off the shadow falls back to the stacked rings and
+        // never builds a blur tile.
+        Style::setSurfaceCacheEnabled(false);
+        Style::resetSurfaceCacheStats();
+        const QImage direct = renderCards();
+        QCOMPARE(Style::surfaceCacheStats().misses, quint64(0));
+        QCOMPARE(Style::surfaceCacheStats().hits, quint64(0));
+        Style::setSurfaceCacheEnabled(true);
+        Style::clearSurfaceCache();
+        Style::resetSurfaceCacheStats();
+        const QImage cached = renderCards();
+        // One blurred tile serves every card size.
+        QCOMPARE(Style::surfaceCacheStats().misses, quint64(1));
+        QCOMPARE(Style::surfaceCacheStats().hits, quint64(2));
+        // Both paths shade just below a card.
+        QVERIFY(qGray(direct.pixel(65, 83)) < qGray(colors.background.rgb()));
+        QVERIFY(qGray(cached.pixel(65, 83)) < qGray(colors.background.rgb()));
+
+        // Gaussian falloff: full color inside, fading past the edge and gone
+        // beyond three sigma.
+        auto paintShadow = [](qreal dpr) {
+            QImage image(QSize(120, 100) * dpr, QImage::Format_ARGB32_Premultiplied);
+            image.setDevicePixelRatio(dpr);
+            image.fill(Qt::transparent);
+            QPainter painter(&image);
+            Style::paintShadow(painter, QRectF(20, 20, 80, 40), 8.0, 3.0, QColor(0, 0, 0, 200));
+            painter.end();
+            return image;
+        };
+        const QImage shadow = paintShadow(1.0);
+        QVERIFY(qAbs(qAlpha(shadow.pixel(60, 40)) - 200) <= 1);
+        int previous = qAlpha(shadow.pixel(60, 56));
+        for (int y = 57; y < 72; ++y) {
+            const int alpha = qAlpha(shadow.pixel(60, y));
+            QVERIFY2(alpha <= previous, qPrintable(QStringLiteral("shadow alpha rises at y=%1").arg(y)));
+            previous = alpha;
+        }
+        QVERIFY(qAlpha(shadow.pixel(60, 60)) > 40);
+        QVERIFY(qAlpha(shadow.pixel(60, 60)) < 160);
+        QCOMPARE(qAlpha(shadow.pixel(60, 72)), 0);
+
+        const quint64 missesBeforeHiDpi = Style::surfaceCacheStats().misses;
+        const QImage hiDpiShadow = paintShadow(2.0);
+        QCOMPARE(Style::surfaceCacheStats().misses, missesBeforeHiDpi + 1);
+        QVERIFY(qAbs(qAlpha(hiDpiShadow.pixel(120, 80)) - 200) <= 1);
+        QCOMPARE(qAlpha(hiDpiShadow.pixel(120, 144)), 0);
+    }
+
+    void styleMixBlendsInFixedPointAndStacksButtonStates()
+    {
+        auto floatMix = [](const QColor &a, const QColor &b, qreal t) {
+            return QColor::fromRgbF(a.redF() + (b.redF() - a.redF()) * t,
+                                    a.greenF() + (b.greenF() - a.greenF()) * t,
+                                    a.blueF() + (b.blueF() - a.blueF()) * t,
+                                    a.alphaF() + (b.alphaF() - a.alphaF()) * t);
+        };
+        const QColor pairs[][2] = {
+            {QColor(0, 0, 0, 0), QColor(255, 255, 255, 255)},
+            {QColor(QStringLiteral("#0066B4")), QColor(QStringLiteral("#FFFFFF"))},
+            {QColor(32, 32, 32, 179), QColor(61, 61, 61, 230)},
+            {QColor::fromHsvF(0.6, 0.7, 0.8, 0.5), QColor(250, 10, 128, 3)},
+        };
+        for (const auto &pair : pairs) {
+            const QColor &a = pair[0];
+            const QColor &b = pair[1];
+            QCOMPARE(Style::mix(a, b, 0.0).rgba(), a.rgba());
+            QCOMPARE(Style::mix(a, b, 1.0).rgba(), b.rgba());
+            QCOMPARE(Style::mix(a, b, -2.0).rgba(), a.rgba());
+            QCOMPARE(Style::mix(a, b, 3.0).rgba(), b.rgba());
+
+            for (int step = 0; step <= 200; ++step) {
+                const qreal t = step / 200.0;
+                const QColor mixed = Style::mix(a, b, t);
+                const QColor reference = floatMix(a, b, t);
+                QVERIFY2(qAbs(mixed.red() - reference.red()) <= 1 && qAbs(mixed.green() - reference.green()) <= 1
+                             && qAbs(mixed.blue() - reference.blue()) <= 1
+                             && qAbs(mixed.alpha() - reference.alpha()) <= 1,
+                         qPrintable(QStringLiteral("mix(%1, %2, %3) = %4, expected %5")
+                                        .arg(a.name(QColor::HexArgb), b.name(QColor::HexArgb))
+                                        .arg(t)
+                                        .arg(mixed.name(QColor::HexArgb), reference.name(QColor::HexArgb))));
+            }
+        }
+
+        // Button fills blend hover, then press, on top of it. Levels on the
+        // 1/32 grid pass through quantization unchanged whether or not the
+        // surface cache is on.
+        ButtonVisuals::StateColors state;
+        state.base = QColor(QStringLiteral("#FBFBFB"));
+        state.hover = QColor(249, 249, 249, 128);
+        state.pressed = QColor(QStringLiteral("#0066B4"));
+        const qreal levels[] = {0.0, 0.25, 0.5, 0.75, 1.0};
+        for (qreal hover : levels) {
+            for (qreal press : levels) {
+                const QColor fill = ButtonVisuals::fillForState(state, hover, press);
+                const QColor nested = Style::mix(Style::mix(state.base, state.hover, hover), state.pressed, press);
+                QCOMPARE(quint64(fill.rgba64()), quint64(nested.rgba64()));
+
+                const QColor reference = floatMix(floatMix(state.base, state.hover, hover), state.pressed, press);
+                QVERIFY2(qAbs(fill.red() - reference.red()) <= 1 && qAbs(fill.green() - reference.green()) <= 1
+                             && qAbs(fill.blue() - reference.blue()) <= 1
+                             && qAbs(fill.alpha() - reference.alpha()) <= 1,
+                         qPrintable(QStringLiteral("fillForState(%1, %2) = %3, expected %4")
+                                        .arg(hover)
+                                        .arg(press)
+                                        .arg(fill.name(QColor::HexArgb), reference.name(QColor::HexArgb))));
+            }
+        }
+        QCOMPARE(ButtonVisuals::fillForState(state, 0.0, 0.0).rgba(), state.base.rgba());
+        QCOMPARE(ButtonVisuals::fillForState(state, 1.0, 0.0).rgba(), state.hover.rgba());
+        QCOMPARE(ButtonVisuals::fillForState(state, 0.5, 1.0).rgba(), state.pressed.rgba());
+    }
+
     void lottieHonorsReducedMotion()
     {
         syncTheme(false, QColor(QStringLiteral("#0066B4")));
@@ -4791,6 +5202,102 @@ private slots:
                  "Theme-retinted Lottie frame should not reuse the previous accent cache");
     }
 
+    void lottieAsyncLoadSharesParsedModels()
+    {
+        FluentLottieWidget::clearModelCache();
+        const QString key = QStringLiteral("visual-smoke-lottie-async");
+        QVERIFY(!FluentLottieWidget::isModelCached(key));
+
+        FluentLottieWidget first;
+        QSignalSpy firstLoaded(&first, &FluentLottieWidget::loaded);
+        first.loadDataAsync(visualSmokeLottieJson(), key);
+        QVERIFY2(first.isLoading() && !first.isLoaded(), "Asynchronous Lottie parsing should not block the caller");
+        QTRY_COMPARE(firstLoaded.count(), 1);
+        QVERIFY(first.isLoaded());
+        QVERIFY(!first.isLoading());
+        QVERIFY(first.totalFrames() > 1);
+        QVERIFY(FluentLottieWidget::isModelCached(key));
+
+        // A registered model is applied before loadDataAsync() returns.
+        FluentLottieWidget second;
+        QSignalSpy secondLoaded(&second, &FluentLottieWidget::loaded);
+        second.loadDataAsync(visualSmokeLottieJson(), key);
+        QVERIFY(second.isLoaded());
+        QCOMPARE(secondLoaded.count(), 1);
+        QCOMPARE(second.totalFrames(), first.totalFrames());
+
+        // Reusing a cache key for different JSON must not return the old model.
+        FluentLottieWidget invalid;
+        QSignalSpy invalidFailed(&invalid, &FluentLottieWidget::loadFailed);
+        invalid.loadDataAsync(QByteArrayLiteral("{ not valid lottie json"), key);
+        QTRY_COMPARE(invalidFailed.count(), 1);
+        QVERIFY(!invalid.isLoaded());
+
+        // A later synchronous load supersedes a pending asynchronous one.
+        FluentLottieWidget superseded;
+        QSignalSpy supersededFailed(&superseded, &FluentLottieWidget::loadFailed);
+        superseded.loadDataAsync(QByteArrayLiteral("{ not valid"), QStringLiteral("visual-smoke-lottie-superseded"));
+        QVERIFY(superseded.loadData(visualSmokeLottieJson(), key));
+        QTest::qWait(50);
+        QCoreApplication::processEvents();
+        QCOMPARE(supersededFailed.count(), 0);
+        QVERIFY(superseded.isLoaded());
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = dir.filePath(QStringLiteral("preloaded.json"));
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(visualSmokeLottieJson());
+        file.close();
+
+        FluentLottieWidget::preload({path});
+        QTRY_VERIFY(FluentLottieWidget::isModelCached(path));
+        FluentLottieWidget fromFile;
+        fromFile.loadAsync(path);
+        QVERIFY2(fromFile.isLoaded(), "Preloaded Lottie files should load without waiting for a worker");
+        QCOMPARE(fromFile.source(), path);
+
+        FluentLottieWidget missing;
+        QSignalSpy missingFailed(&missing, &FluentLottieWidget::loadFailed);
+        const QString missingPath = dir.filePath(QStringLiteral("missing.json"));
+        missing.loadAsync(missingPath);
+        QTRY_COMPARE(missingFailed.count(), 1);
+        QVERIFY(missing.errorString().contains(missingPath));
+
+        FluentLottieWidget::clearModelCache();
+        QVERIFY(!FluentLottieWidget::isModelCached(path));
+        QVERIFY(fromFile.isLoaded());
+
+        // Models are held weakly: with no room to retain idle ones, a model
+        // lives exactly as long as a widget uses it.
+        struct LimitRestore {
+            qint64 limit = FluentLottieWidget::modelCacheLimit();
+            ~LimitRestore()
+            {
+                FluentLottieWidget::setModelCacheLimit(limit);
+            }
+        } limitRestore;
+        const QString weakKey = QStringLiteral("visual-smoke-lottie-weak");
+        FluentLottieWidget::setModelCacheLimit(0);
+        {
+            FluentLottieWidget holder;
+            QVERIFY(holder.loadData(visualSmokeLottieJson(), weakKey));
+            QVERIFY(FluentLottieWidget::isModelCached(weakKey));
+        }
+        QVERIFY(!FluentLottieWidget::isModelCached(weakKey));
+
+        // Within the limit, a released model stays ready for the next widget.
+        FluentLottieWidget::setModelCacheLimit(limitRestore.limit);
+        {
+            FluentLottieWidget holder;
+            QVERIFY(holder.loadData(visualSmokeLottieJson(), weakKey));
+        }
+        QVERIFY(FluentLottieWidget::isModelCached(weakKey));
+        FluentLottieWidget::setModelCacheLimit(0);
+        QVERIFY(!FluentLottieWidget::isModelCached(weakKey));
+    }
+
     void motionTokensCanConfigureDurations()
     {
         syncTheme(false, QColor(QStringLiteral("#0066B4")));
@@ -5492,7 +5999,8 @@ private slots:
         QCoreApplication::processEvents();
         QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
         QCoreApplication::processEvents();
-        QTRY_VERIFY2(toastGuard.isNull(), "Toast should be deleted immediately when dismissed with animations disabled");
+        QTRY_VERIFY2(toastGuard && toastGuard->isHidden(),
+                     "Toast should be released to the overlay pool immediately when dismissed with animations disabled");
         QVERIFY2(overlay->mask().isEmpty(), "Toast overlay mask should clear once no toasts remain");
         QVERIFY2(overlay->testAttribute(Qt::WA_TransparentForMouseEvents),
                  "Toast overlay should become transparent for mouse events once no toasts remain");
@@ -5571,7 +6079,8 @@ private slots:
         QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
         QCoreApplication::processEvents();
 
-        QTRY_VERIFY2(toastGuard.isNull(), "Clicking the toast text should dismiss and delete the toast immediately");
+        QTRY_VERIFY2(toastGuard && toastGuard->isHidden(),
+                     "Clicking the toast text should dismiss and release the toast immediately");
         QVERIFY2(overlay->mask().isEmpty(), "Toast overlay mask should clear after click dismiss");
         QVERIFY2(overlay->testAttribute(Qt::WA_TransparentForMouseEvents),
                  "Toast overlay should stop intercepting input after click dismiss");
@@ -5640,9 +6149,10 @@ private slots:
         QCoreApplication::processEvents();
 
         QTRY_COMPARE(runningOpacityGroups(appearingToast), 0);
-        auto *appearEffect = qobject_cast<QGraphicsOpacityEffect *>(appearingToast->graphicsEffect());
-        QVERIFY2(appearEffect, "Toast should keep an opacity effect after snapping its appear animation");
-        QCOMPARE(appearEffect->opacity(), 1.0);
+        QVERIFY2(!appearingToast->graphicsEffect(), "Toast should fade from a cached layer, not a graphics effect");
+        auto *appearTitle = appearingToast->findChild<QLabel *>(QStringLiteral("FluentToastTitle"));
+        QVERIFY2(appearTitle && !appearTitle->isHidden(),
+                 "Snapping the appear animation should swap the live toast children back in");
         QVERIFY2(!renderWidgetImage(appearingToast).isNull(),
                  "Toast should render to an offscreen QWidget::render image after snapping appear opacity");
 
@@ -5677,8 +6187,177 @@ private slots:
         ThemeManager::instance().setAnimationsEnabled(false);
         QCoreApplication::processEvents();
 
-        QTRY_VERIFY2(toastGuard.isNull(),
-                     "Toast should be deleted immediately when reduced motion is enabled mid-dismiss");
+        QTRY_VERIFY2(toastGuard && toastGuard->isHidden(),
+                     "Toast should be released immediately when reduced motion is enabled mid-dismiss");
+    }
+
+    void toastFadeBlendsCachedLayerInsteadOfGraphicsEffect()
+    {
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+
+        struct Restore {
+            bool enabled = ThemeManager::instance().animationsEnabled();
+            FluentMotionTokens tokens = ThemeManager::instance().motionTokens();
+            int maxVisible = FluentToast::maxVisibleCount(FluentToast::Position::TopRight);
+            ~Restore()
+            {
+                FluentToast::setMaxVisibleCount(FluentToast::Position::TopRight, maxVisible);
+                ThemeManager::instance().setMotionTokens(tokens);
+                ThemeManager::instance().setAnimationsEnabled(enabled);
+                QCoreApplication::processEvents();
+            }
+        } restore;
+
+        FluentMotionTokens custom = restore.tokens;
+        custom.toastDuration = 600;
+        ThemeManager::instance().setMotionTokens(custom);
+        ThemeManager::instance().setAnimationsEnabled(true);
+        QCoreApplication::processEvents();
+
+        QWidget window;
+        window.resize(720, 900);
+        window.show();
+        QTRY_VERIFY(window.isVisible());
+
+        constexpr int kToasts = 10;
+        FluentToast::setMaxVisibleCount(FluentToast::Position::TopRight, kToasts);
+        for (int i = 0; i < kToasts; ++i) {
+            FluentToast::showToast(&window,
+                                   QStringLiteral("Burst %1").arg(i),
+                                   QStringLiteral("Each toast should fade from one cached layer."),
+                                   FluentToast::Position::TopRight,
+                                   5000);
+        }
+
+        auto fadeLayer = [](FluentToast *toast) -> FluentFadeLayer * {
+            return toast ? dynamic_cast<FluentFadeLayer *>(toast->findChild<QObject *>(QStringLiteral("FluentFadeLayer")))
+                         : nullptr;
+        };
+
+        auto *overlay = window.findChild<QWidget *>(QStringLiteral("FluentToastOverlay"));
+        QVERIFY(overlay);
+        QTRY_COMPARE(overlay->findChildren<FluentToast *>(QStringLiteral("FluentToast")).size(), kToasts);
+        const auto toasts = overlay->findChildren<FluentToast *>(QStringLiteral("FluentToast"));
+        QTRY_VERIFY2(std::all_of(toasts.cbegin(), toasts.cend(), [&](FluentToast *toast) {
+                         auto *layer = fadeLayer(toast);
+                         return layer && layer->isActive();
+                     }),
+                     "Every toast in the burst should be fading in from its cached layer");
+
+        for (FluentToast *toast : toasts) {
+            QVERIFY2(!toast->graphicsEffect(), "Toast fades should not install a QGraphicsOpacityEffect");
+            auto *title = toast->findChild<QLabel *>(QStringLiteral("FluentToastTitle"));
+            QVERIFY2(title && title->isHidden(), "Live toast children should be swapped out while the layer fades");
+            QVERIFY2(fadeLayer(toast)->opacity() < 1.0, "The cached layer should carry the fade opacity");
+        }
+
+        QTest::qWait(120);
+        for (FluentToast *toast : toasts) {
+            QCOMPARE(fadeLayer(toast)->captureCount(), 1);
+        }
+
+        QTRY_VERIFY2(std::none_of(toasts.cbegin(), toasts.cend(), [&](FluentToast *toast) {
+                         return fadeLayer(toast)->isActive();
+                     }),
+                     "Toasts should swap back to their live widgets when the fade ends");
+        for (FluentToast *toast : toasts) {
+            auto *title = toast->findChild<QLabel *>(QStringLiteral("FluentToastTitle"));
+            QVERIFY2(title && !title->isHidden(), "Toast title should be live again after the fade");
+            QCOMPARE(fadeLayer(toast)->captureCount(), 1);
+        }
+    }
+
+    void toastBurstCoalescesQueuesAndRecyclesWidgets()
+    {
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+
+        struct Restore {
+            bool enabled = ThemeManager::instance().animationsEnabled();
+            int maxVisible = FluentToast::maxVisibleCount(FluentToast::Position::TopLeft);
+            ~Restore()
+            {
+                FluentToast::setMaxVisibleCount(FluentToast::Position::TopLeft, maxVisible);
+                ThemeManager::instance().setAnimationsEnabled(enabled);
+                QCoreApplication::processEvents();
+            }
+        } restore;
+
+        ThemeManager::instance().setAnimationsEnabled(false);
+        FluentToast::setMaxVisibleCount(FluentToast::Position::TopLeft, 3);
+        QCoreApplication::processEvents();
+
+        QWidget window;
+        window.resize(640, 520);
+        window.show();
+        QTRY_VERIFY(window.isVisible());
+
+        for (int i = 0; i < 200; ++i) {
+            FluentToast::showToast(&window,
+                                   QStringLiteral("Sync failed"),
+                                   QStringLiteral("The same error was reported again."),
+                                   FluentToast::Position::TopLeft,
+                                   5000);
+        }
+
+        auto *overlay = window.findChild<QWidget *>(QStringLiteral("FluentToastOverlay"));
+        QVERIFY(overlay);
+        QVERIFY2(overlay->findChildren<FluentToast *>().isEmpty(),
+                 "Posting toasts should defer widget creation to the overlay's next layout pass");
+        QCoreApplication::processEvents();
+
+        auto shownToasts = [overlay]() {
+            QList<FluentToast *> shown;
+            const auto toasts = overlay->findChildren<FluentToast *>(QString(), Qt::FindDirectChildrenOnly);
+            for (FluentToast *toast : toasts) {
+                if (!toast->isHidden()) {
+                    shown.append(toast);
+                }
+            }
+            return shown;
+        };
+
+        QTRY_COMPARE(shownToasts().size(), 1);
+        FluentToast *coalesced = shownToasts().constFirst();
+        QCOMPARE(coalesced->repeatCount(), 200);
+
+        FluentToast::showToast(&window,
+                               QStringLiteral("Sync failed"),
+                               QStringLiteral("The same error was reported again."),
+                               FluentToast::Position::TopLeft,
+                               5000);
+        QCoreApplication::processEvents();
+        QCOMPARE(coalesced->repeatCount(), 201);
+        QCOMPARE(shownToasts().size(), 1);
+
+        auto *title = coalesced->findChild<QLabel *>(QStringLiteral("FluentToastTitle"));
+        auto *message = coalesced->findChild<QLabel *>(QStringLiteral("FluentToastMessage"));
+        QVERIFY(title && message);
+        QTRY_VERIFY2(title->width() < message->width(), "The repeat badge should reserve room at the end of the title");
+
+        for (int i = 0; i < 12; ++i) {
+            FluentToast::showToast(&window,
+                                   QStringLiteral("Import warning %1").arg(i),
+                                   QStringLiteral("Distinct toasts beyond the cap should wait in the queue."),
+                                   FluentToast::Position::TopLeft,
+                                   5000);
+        }
+        QCoreApplication::processEvents();
+        QTRY_COMPARE(shownToasts().size(), 3);
+        QCOMPARE(overlay->findChildren<FluentToast *>(QString(), Qt::FindDirectChildrenOnly).size(), 3);
+
+        // Each dismissal frees a slot; the next queued toast reuses the released widget.
+        for (int round = 0; round < 10; ++round) {
+            const auto shown = shownToasts();
+            QVERIFY(!shown.isEmpty());
+            QTest::mouseClick(shown.constFirst(), Qt::LeftButton, Qt::NoModifier, shown.constFirst()->rect().center());
+            QCoreApplication::processEvents();
+        }
+
+        QTRY_COMPARE(shownToasts().size(), 3);
+        QCOMPARE(overlay->findChildren<FluentToast *>(QString(), Qt::FindDirectChildrenOnly).size(), 3);
+        for (FluentToast *toast : shownToasts()) {
+            QCOMPARE(toast->repeatCount(), 1);
+        }
     }
 
     void toastChromeUsesFrameAndProgressTokens()
@@ -8322,6 +9001,93 @@ private slots:
         QCOMPARE(anchorClicked.count(), 0);
     }
 
+    void calendarPopupCachedGridLayersFollowPageThemeAndLocale()
+    {
+        struct ThemeRestore {
+            ThemeManager::ThemeMode mode = ThemeManager::instance().themeMode();
+            ThemeColors colors = ThemeManager::instance().colors();
+            bool animationsEnabled = ThemeManager::instance().animationsEnabled();
+
+            ~ThemeRestore()
+            {
+                ThemeManager::instance().setColors(colors);
+                ThemeManager::instance().setThemeMode(mode);
+                ThemeManager::instance().setAnimationsEnabled(animationsEnabled);
+                QCoreApplication::processEvents();
+            }
+        } restore;
+
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+        ThemeManager::instance().setAnimationsEnabled(false);
+        QCoreApplication::processEvents();
+
+        QWidget anchor;
+        anchor.resize(220, 40);
+        anchor.show();
+        QTRY_VERIFY(anchor.isVisible());
+
+        FluentCalendarPopup popup(&anchor);
+        popup.setLocale(QLocale(QLocale::English, QLocale::UnitedStates));
+        popup.setDate(QDate(2026, 5, 15));
+        popup.popup();
+        QTRY_VERIFY(popup.isVisible());
+
+        auto layerBuilds = [&popup]() { return popup.property("_fluentGridLayerBuilds").toInt(); };
+
+        const QImage first = renderWidgetImage(&popup);
+        const int builtOnce = layerBuilds();
+        QVERIFY(builtOnce > 0);
+        const QImage repeated = renderWidgetImage(&popup);
+        QVERIFY2(!first.isNull() && first == repeated,
+                 "Calendar popup should repaint identically from its cached grid layers");
+        QCOMPARE(layerBuilds(), builtOnce);
+
+        const QRect content = PopupSurface::shadowContentRect(popup.rect()).adjusted(10, 10, -10, -10);
+        const QRect cells(content.left(), content.top() + 44 + 24, content.width(), content.height() - 44 - 24);
+        QTest::mouseMove(&popup, QPoint(cells.left() + cells.width() / 14, cells.top() + cells.height() / 12));
+        QCoreApplication::processEvents();
+        QVERIFY2(renderWidgetImage(&popup) != first,
+                 "Hover decoration should be composited over the cached day grid");
+        QCOMPARE(layerBuilds(), builtOnce);
+
+        QTest::keyClick(&popup, Qt::Key_PageDown);
+        QCoreApplication::processEvents();
+        const QImage nextMonth = renderWidgetImage(&popup);
+        QVERIFY2(nextMonth != first, "Stepping the page should rebuild the cached day grid for the new month");
+        const int builtForPage = layerBuilds();
+        QVERIFY(builtForPage > builtOnce);
+        renderWidgetImage(&popup);
+        QCOMPARE(layerBuilds(), builtForPage);
+
+        popup.setLocale(QLocale(QLocale::Chinese, QLocale::China));
+        QCoreApplication::processEvents();
+        QVERIFY2(renderWidgetImage(&popup) != nextMonth,
+                 "Changing the popup locale should invalidate the cached weekday row");
+        const int builtForLocale = layerBuilds();
+        QVERIFY(builtForLocale > builtForPage);
+
+        QFont larger = popup.font();
+        if (larger.pointSizeF() > 0.0) {
+            larger.setPointSizeF(larger.pointSizeF() + 2.0);
+        } else {
+            larger.setPixelSize(larger.pixelSize() + 2);
+        }
+        popup.setFont(larger);
+        QCoreApplication::processEvents();
+        renderWidgetImage(&popup);
+        const int builtForFont = layerBuilds();
+        QVERIFY2(builtForFont > builtForLocale, "Changing the popup font should rebuild the cached grid glyphs");
+        renderWidgetImage(&popup);
+        QCOMPARE(layerBuilds(), builtForFont);
+
+        const QImage light = renderWidgetImage(&popup);
+        syncTheme(true, QColor(QStringLiteral("#0066B4")));
+        const QImage dark = renderWidgetImage(&popup);
+        QVERIFY2(dark != light, "Theme changes should invalidate the cached day grid glyphs");
+        QVERIFY(layerBuilds() > builtForFont);
+        popup.dismiss();
+    }
+
     void calendarPickersUseDocumentedLocaleAndCalendarPopupTokenChrome()
     {
         struct ThemeRestore {
@@ -10969,6 +11735,219 @@ private slots:
                  "CodeEditor should render after deferred IME auto-formatting through QWidget::render");
     }
 
+    void codeEditorBracketIndexSkipsLiteralsAndTracksEdits()
+    {
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+
+        QString text = QStringLiteral("void run() {\n    const char *s = \"}\";\n    /* ) {\n    } */\n");
+        for (int i = 0; i < 2000; ++i) {
+            text += QStringLiteral("    call(%1); // }\n").arg(i);
+        }
+        text += QStringLiteral("}\n");
+
+        FluentCodeEditor editor;
+        editor.setAutoFormatEnabled(false);
+        editor.setCurrentLineHighlightEnabled(false);
+        editor.setPlainText(text);
+
+        auto markedAt = [&editor](int position) {
+            for (const QTextEdit::ExtraSelection &selection : editor.extraSelections()) {
+                if (selection.cursor.selectionStart() == position) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        auto placeCursor = [&editor](int position) {
+            QTextCursor cursor(editor.document());
+            cursor.setPosition(position);
+            editor.setTextCursor(cursor);
+        };
+
+        // The brace in the string, the comment block and the line comments
+        // are not brackets: the outer pair spans the whole document.
+        const int open = text.indexOf(QLatin1Char('{'));
+        const int close = text.lastIndexOf(QLatin1Char('}'));
+        placeCursor(open + 1);
+        QCOMPARE(editor.extraSelections().size(), 2);
+        QVERIFY(markedAt(open));
+        QVERIFY(markedAt(close));
+
+        placeCursor(text.indexOf(QStringLiteral("\"}\"")) + 1);
+        QCOMPARE(editor.extraSelections().size(), 0);
+
+        QCOMPARE(editor.bracketDepthAt(open), 0);
+        QCOMPARE(editor.bracketDepthAt(open + 1), 1);
+        QCOMPARE(editor.bracketDepthAt(text.indexOf(QStringLiteral("call(1000)")) + 5), 2);
+        QCOMPARE(editor.bracketDepthAt(close + 1), 0);
+
+        // Edits keep the index current, including comments that start or end.
+        QTextCursor cursor(editor.document());
+        cursor.setPosition(open + 1);
+        cursor.insertText(QStringLiteral("\n    if (ready) {\n    }"));
+        placeCursor(open + 1);
+        QVERIFY(markedAt(open));
+        QVERIFY(markedAt(editor.toPlainText().lastIndexOf(QLatin1Char('}'))));
+        const int inner = editor.toPlainText().indexOf(QStringLiteral("(ready) {")) + 9;
+        QCOMPARE(editor.bracketDepthAt(inner), 2);
+
+        cursor.setPosition(open + 1);
+        cursor.insertText(QStringLiteral("/*"));
+        QCOMPARE(editor.bracketDepthAt(inner + 2), 1);
+        placeCursor(open + 1);
+        QVERIFY(markedAt(editor.toPlainText().lastIndexOf(QLatin1Char('}'))));
+    }
+
+    void codeEditorLargeFileModeLoadsInChunksAndHighlightsVisibleLines()
+    {
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+
+        QString text;
+        for (int i = 0; i < 30000; ++i) {
+            text += QStringLiteral("int value%1 = %1; // generated\n").arg(i);
+        }
+
+        FluentCodeEditor editor;
+        editor.setLargeFileLineThreshold(10000);
+        editor.resize(420, 240);
+        editor.show();
+        QTRY_VERIFY(editor.isVisible());
+        QVERIFY(!editor.largeFileMode());
+
+        QSignalSpy modeSpy(&editor, &FluentCodeEditor::largeFileModeChanged);
+        QSignalSpy progressSpy(&editor, &FluentCodeEditor::loadProgress);
+        QSignalSpy finishedSpy(&editor, &FluentCodeEditor::loadFinished);
+        editor.loadPlainText(text);
+        QVERIFY(editor.isLoading());
+        QVERIFY(editor.isReadOnly());
+        QVERIFY(editor.largeFileMode());
+        QCOMPARE(modeSpy.count(), 1);
+        QVERIFY(editor.document()->findChildren<FluentCppHighlighter *>().isEmpty());
+        QVERIFY(editor.toPlainText().size() < text.size());
+
+        QTRY_COMPARE(finishedSpy.count(), 1);
+        QVERIFY(progressSpy.count() > 2);
+        QCOMPARE(progressSpy.last().at(0).toLongLong(), qint64(text.size()));
+        QCOMPARE(progressSpy.last().at(1).toLongLong(), qint64(text.size()));
+        QVERIFY(!editor.isLoading());
+        QVERIFY(!editor.isReadOnly());
+        QVERIFY(!editor.document()->isModified());
+        QVERIFY(!editor.document()->isUndoAvailable());
+        QCOMPARE(editor.toPlainText(), text);
+
+        // Only what is on screen gets formats.
+        QTRY_VERIFY(!editor.document()->firstBlock().layout()->formats().isEmpty());
+        QVERIFY(editor.document()->lastBlock().previous().layout()->formats().isEmpty());
+
+        // A document that outgrows the threshold through setPlainText() is
+        // taken from the attached highlighter before it formats anything.
+        editor.setPlainText(QStringLiteral("int x = 1;\n"));
+        QCOMPARE(modeSpy.count(), 2);
+        QVERIFY(!editor.largeFileMode());
+        QCOMPARE(editor.document()->findChildren<FluentCppHighlighter *>().size(), 1);
+
+        editor.setPlainText(text);
+        QCOMPARE(modeSpy.count(), 3);
+        QVERIFY(editor.largeFileMode());
+        QTRY_VERIFY(!editor.document()->firstBlock().layout()->formats().isEmpty());
+        QVERIFY(editor.document()->lastBlock().previous().layout()->formats().isEmpty());
+    }
+
+    void codeEditorBasicFormatterRunsOffThreadAndDropsStaleRuns()
+    {
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+
+        const QString unformatted = QStringLiteral("int main() {\nreturn 0;\n}\n");
+        const QString formatted = QStringLiteral("int main() {\n    return 0;\n}\n");
+
+        FluentCodeEditor editor;
+        editor.setClangFormatPath(QStringLiteral("__qtfluent_missing_clang_format__"));
+        editor.setClangFormatMissingHintEnabled(false);
+        editor.setAutoFormatEnabled(false);
+        editor.setPlainText(unformatted);
+        editor.resize(360, 160);
+        editor.show();
+        QTRY_VERIFY(editor.isVisible());
+        QVERIFY(!editor.clangFormatAvailable());
+
+        QSignalSpy startedSpy(&editor, &FluentCodeEditor::formatStarted);
+        QSignalSpy finishedSpy(&editor, &FluentCodeEditor::formatFinished);
+        editor.formatDocumentNow();
+        QCOMPARE(startedSpy.count(), 1);
+        QCOMPARE(finishedSpy.count(), 0);
+        QCOMPARE(editor.toPlainText(), unformatted);
+
+        QTRY_COMPARE(finishedSpy.count(), 1);
+        QCOMPARE(finishedSpy.at(0).at(0).toBool(), true);
+        QVERIFY(finishedSpy.at(0).at(1).toLongLong() >= 0);
+        QCOMPARE(editor.toPlainText(), formatted);
+
+        // Typing before the worker reports back cancels the run.
+        editor.setPlainText(unformatted);
+        editor.formatDocumentNow();
+        QTextCursor cursor(editor.document());
+        cursor.movePosition(QTextCursor::End);
+        cursor.insertText(QStringLiteral("// typed\n"));
+        QTRY_COMPARE(finishedSpy.count(), 2);
+        QCOMPARE(startedSpy.count(), 2);
+        QCOMPARE(finishedSpy.at(1).at(0).toBool(), false);
+        QCOMPARE(editor.toPlainText(), unformatted + QStringLiteral("// typed\n"));
+    }
+
+    void codeEditorFormatterEditsOnlyChangedBlocks()
+    {
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+
+        QString formatted;
+        for (int i = 0; i < 400; ++i) {
+            formatted += QStringLiteral("void f%1() {\n    return;\n}\n").arg(i);
+        }
+        QString unformatted = formatted;
+        unformatted.replace(QStringLiteral("void f10() {\n    return;"), QStringLiteral("void f10() {\nreturn;"));
+        unformatted.replace(QStringLiteral("void f300() {\n    return;"), QStringLiteral("void f300() {\nreturn;"));
+        QVERIFY(unformatted != formatted);
+
+        int changedChars = 0;
+        FluentCodeEditor editor;
+        editor.setClangFormatPath(QStringLiteral("__qtfluent_missing_clang_format__"));
+        editor.setClangFormatMissingHintEnabled(false);
+        editor.setAutoFormatEnabled(false);
+        editor.setCppHighlightingEnabled(false);
+        editor.setPlainText(unformatted);
+        editor.resize(360, 200);
+        editor.show();
+        QTRY_VERIFY(editor.isVisible());
+        QVERIFY(!editor.clangFormatAvailable());
+
+        // Blocks that get replaced come back with userState -1.
+        QTextDocument *document = editor.document();
+        for (QTextBlock block = document->begin(); block.isValid(); block = block.next()) {
+            block.setUserState(block.blockNumber());
+        }
+        connect(document, &QTextDocument::contentsChange, &editor, [&changedChars](int, int removed, int added) {
+            changedChars += removed + added;
+        });
+
+        QSignalSpy finishedSpy(&editor, &FluentCodeEditor::formatFinished);
+        editor.formatDocumentNow();
+        QTRY_COMPARE(finishedSpy.count(), 1);
+        QCOMPARE(finishedSpy.at(0).at(0).toBool(), true);
+        QCOMPARE(editor.toPlainText(), formatted);
+        QCOMPARE(changedChars, 8);
+
+        int keptBlocks = 0;
+        for (QTextBlock block = document->begin(); block.isValid(); block = block.next()) {
+            if (block.userState() == block.blockNumber()) {
+                ++keptBlocks;
+            }
+        }
+        QCOMPARE(keptBlocks, document->blockCount());
+
+        QCOMPARE(document->availableUndoSteps(), 1);
+        document->undo();
+        QCOMPARE(editor.toPlainText(), unformatted);
+    }
+
     void codeEditorAsyncClangFormatDoesNotApplyStaleOutput()
     {
         syncTheme(false, QColor(QStringLiteral("#0066B4")));
@@ -11053,6 +12032,97 @@ private slots:
                  "CodeEditor should render after stale async clang-format recovery through QWidget::render");
     }
 
+    void codeEditorAutoFormatPassesChangedLinesAndCachesResults()
+    {
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+
+        QTemporaryDir formatterDir;
+        QVERIFY2(formatterDir.isValid(), "Test should be able to create a temporary clang-format shim");
+        const QString logPath = formatterDir.filePath(QStringLiteral("arguments.log"));
+
+        // Logs its arguments, one run per line, and echoes stdin unchanged.
+#ifdef Q_OS_WIN
+        const QString formatterPath = formatterDir.filePath(QStringLiteral("qtfluent-fake-clang-format.cmd"));
+        const QByteArray formatterScript =
+            "@echo off\r\n"
+            "echo %*>>\"" + QDir::toNativeSeparators(logPath).toLocal8Bit() + "\"\r\n"
+            "powershell -NoProfile -ExecutionPolicy Bypass -Command "
+            "\"[Console]::Out.Write([Console]::In.ReadToEnd())\"\r\n";
+#else
+        const QString formatterPath = formatterDir.filePath(QStringLiteral("qtfluent-fake-clang-format.sh"));
+        const QByteArray formatterScript =
+            "#!/bin/sh\n"
+            "echo \"$*\" >> '" + logPath.toLocal8Bit() + "'\n"
+            "cat\n";
+#endif
+
+        QFile formatter(formatterPath);
+        QVERIFY2(formatter.open(QIODevice::WriteOnly | QIODevice::Truncate),
+                 "Test should be able to write a temporary clang-format shim");
+        QVERIFY(formatter.write(formatterScript) == formatterScript.size());
+        formatter.close();
+        QVERIFY(QFile::setPermissions(formatterPath,
+                                      QFile::permissions(formatterPath) | QFileDevice::ExeOwner | QFileDevice::ExeUser));
+
+        auto loggedRuns = [&logPath]() {
+            QFile log(logPath);
+            if (!log.open(QIODevice::ReadOnly | QIODevice::Text)) {
+                return QStringList();
+            }
+            return QString::fromLocal8Bit(log.readAll()).split(QLatin1Char('\n'), Qt::SkipEmptyParts);
+        };
+
+        QString text;
+        for (int i = 0; i < 20; ++i) {
+            text += QStringLiteral("int v%1 = %1;\n").arg(i);
+        }
+
+        FluentCodeEditor editor;
+        editor.setClangFormatPath(formatterPath);
+        editor.setClangFormatMissingHintEnabled(false);
+        editor.setAutoFormatEnabled(true);
+        editor.setAutoFormatTriggerPolicy(FluentCodeEditor::AutoFormatTriggerPolicy::OnEnterOrFocusOut);
+        editor.setAutoFormatDebounceMs(0);
+        // Incremental clang-format runs are not bound by the whole-document limit.
+        editor.setMaxAutoFormatCharacters(16);
+        editor.setPlainText(text);
+        editor.resize(360, 200);
+        editor.show();
+        QTRY_VERIFY(editor.isVisible());
+        QVERIFY(editor.clangFormatAvailable());
+
+        QSignalSpy finishedSpy(&editor, &FluentCodeEditor::formatFinished);
+        editor.formatDocumentNow();
+        QTRY_VERIFY_WITH_TIMEOUT(finishedSpy.count() == 1, 4000);
+        QCOMPARE(loggedRuns().size(), 1);
+        QVERIFY2(!loggedRuns().constFirst().contains(QStringLiteral("-lines=")),
+                 "Manual formatting should format the whole document");
+
+        editor.formatDocumentNow();
+        QTRY_COMPARE(finishedSpy.count(), 2);
+        QCOMPARE(loggedRuns().size(), 1);
+
+        QTextCursor cursor(editor.document()->findBlockByNumber(9));
+        cursor.movePosition(QTextCursor::EndOfBlock);
+        cursor.insertText(QStringLiteral(" // edited"));
+
+        auto sendFocusOut = [&editor]() {
+            QFocusEvent event(QEvent::FocusOut, Qt::OtherFocusReason);
+            QCoreApplication::sendEvent(&editor, &event);
+        };
+        sendFocusOut();
+        QTRY_VERIFY_WITH_TIMEOUT(finishedSpy.count() == 3, 4000);
+        const QStringList runs = loggedRuns();
+        QCOMPARE(runs.size(), 2);
+        QVERIFY2(runs.last().contains(QStringLiteral("-lines=10:10")), qPrintable(runs.last()));
+        QCOMPARE(runs.last().count(QStringLiteral("-lines=")), 1);
+
+        sendFocusOut();
+        QTest::qWait(50);
+        QCOMPARE(finishedSpy.count(), 3);
+        QCOMPARE(loggedRuns().size(), 2);
+    }
+
     void cppHighlighterFollowsThemeChangesWhenUsedStandalone()
     {
         struct ThemeRestore {
@@ -11178,6 +12248,61 @@ private slots:
                  "CodeEditor gutter selection boundary should render to an offscreen QWidget::render image");
     }
 
+    void codeEditorGutterScrollRepaintMatchesFullRepaint()
+    {
+        syncTheme(true, QColor(QStringLiteral("#0066B4")));
+        const ThemeColors colors = ThemeManager::instance().colors();
+
+        QString text;
+        for (int i = 0; i < 200; ++i) {
+            text += QStringLiteral("int value%1 = %1;\n").arg(i);
+        }
+        auto renderEditor = [&](FluentCodeEditor &editor) {
+            QImage image(editor.size(), QImage::Format_ARGB32);
+            image.fill(colors.background.rgba());
+            QPainter painter(&image);
+            editor.render(&painter);
+            return image;
+        };
+
+        // The scrolled editor keeps its painted lines and only draws the ones
+        // that came into view; the result must match a gutter painted whole.
+        FluentCodeEditor scrolled;
+        scrolled.setPlainText(text);
+        QTextCursor cursor(scrolled.document()->findBlockByNumber(24));
+        cursor.movePosition(QTextCursor::Down, QTextCursor::KeepAnchor, 2);
+        scrolled.setTextCursor(cursor);
+        scrolled.resize(280, 180);
+        scrolled.show();
+        QTRY_VERIFY(scrolled.isVisible());
+        scrolled.verticalScrollBar()->setValue(10);
+        QCoreApplication::processEvents();
+        renderEditor(scrolled);
+        scrolled.verticalScrollBar()->setValue(20);
+        QCoreApplication::processEvents();
+        const QImage scrolledImage = renderEditor(scrolled);
+
+        FluentCodeEditor fresh;
+        fresh.setPlainText(text);
+        fresh.setTextCursor(QTextCursor(fresh.document()->findBlockByNumber(24)));
+        QTextCursor freshCursor = fresh.textCursor();
+        freshCursor.movePosition(QTextCursor::Down, QTextCursor::KeepAnchor, 2);
+        fresh.setTextCursor(freshCursor);
+        fresh.resize(280, 180);
+        fresh.show();
+        QTRY_VERIFY(fresh.isVisible());
+        fresh.verticalScrollBar()->setValue(20);
+        QCoreApplication::processEvents();
+        const QImage freshImage = renderEditor(fresh);
+
+        QCOMPARE(scrolled.firstVisibleBlock().blockNumber(), fresh.firstVisibleBlock().blockNumber());
+        // Stay inside the frame so the focus border does not take part.
+        const QRect cr = scrolled.contentsRect();
+        const QRect gutter(cr.left() + 2, cr.top() + 4, scrolled.viewport()->geometry().left() - cr.left() - 2, cr.height() - 8);
+        QVERIFY(gutter.width() > 8);
+        QCOMPARE(scrolledImage.copy(gutter), freshImage.copy(gutter));
+    }
+
     void tabWidgetChromeUsesThemeTokens()
     {
         auto colorDelta = [](const QColor &a, const QColor &b) {
@@ -11340,6 +12465,357 @@ private slots:
                  "TabWidget hover leave should snap when animations are disabled after construction");
     }
 
+    void tabWidgetSnapshotPageTransitionDoesNotRepaintLivePages()
+    {
+        struct MotionRestore {
+            bool animationsEnabled = ThemeManager::instance().animationsEnabled();
+            FluentMotionTokens motionTokens = ThemeManager::instance().motionTokens();
+
+            ~MotionRestore()
+            {
+                ThemeManager::instance().setMotionTokens(motionTokens);
+                ThemeManager::instance().setAnimationsEnabled(animationsEnabled);
+                QCoreApplication::processEvents();
+            }
+        } restore;
+
+        struct PaintCounter final : QObject {
+            int count = 0;
+
+            bool eventFilter(QObject *watched, QEvent *event) override
+            {
+                Q_UNUSED(watched)
+                if (event->type() == QEvent::Paint) {
+                    ++count;
+                }
+                return false;
+            }
+        } paintCounter;
+
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+        ThemeManager::instance().setAnimationsEnabled(true);
+        FluentMotion::setDuration(FluentMotionRole::Page, 240);
+        QCoreApplication::processEvents();
+
+        FluentTabWidget tabs;
+        auto *overview = new QLabel(QStringLiteral("Overview page"), &tabs);
+        auto *details = new QLabel(QStringLiteral("Details page"), &tabs);
+        tabs.addTab(overview, QStringLiteral("Overview"));
+        tabs.addTab(details, QStringLiteral("Details"));
+        QCOMPARE(tabs.pageTransition(), FluentPageTransition::None);
+        tabs.setPageTransition(FluentPageTransition::Slide);
+        tabs.resize(320, 180);
+        tabs.show();
+        QTRY_VERIFY(tabs.isVisible());
+        QCoreApplication::processEvents();
+
+        overview->installEventFilter(&paintCounter);
+        details->installEventFilter(&paintCounter);
+        tabs.setCurrentIndex(1);
+
+        auto *overlay = tabs.findChild<QWidget *>(QStringLiteral("FluentPageTransitionOverlay"));
+        QVERIFY2(overlay && overlay->isVisible(), "Snapshot page transition should cover the incoming page with its overlay");
+        const int paintsAfterSnapshots = paintCounter.count;
+        QTest::qWait(120);
+        QVERIFY2(overlay->isVisible(), "Snapshot page transition should still be running mid-flight");
+        QCOMPARE(paintCounter.count, paintsAfterSnapshots);
+
+        QTRY_VERIFY(!overlay->isVisible());
+        QVERIFY(details->isVisible());
+
+        ThemeManager::instance().setAnimationsEnabled(false);
+        QCoreApplication::processEvents();
+        tabs.setCurrentIndex(0);
+        QVERIFY2(!overlay->isVisible(), "Snapshot page transition should switch instantly when animations are disabled");
+        QVERIFY(overview->isVisible());
+    }
+
+    void themeStyleSheetCacheSharesBuildsAcrossInstances()
+    {
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+        Theme::clearStyleSheetCache();
+        Theme::resetStyleSheetCacheStats();
+
+        const ThemeColors lightColors = ThemeManager::instance().colors();
+        const QString lightSheet = Theme::tableViewStyle(lightColors);
+        QCOMPARE(Theme::styleSheetCacheStats().misses, quint64(1));
+        QCOMPARE(Theme::tableViewStyle(lightColors), lightSheet);
+        QCOMPARE(Theme::styleSheetCacheStats().hits, quint64(1));
+
+        // A different palette is a different entry, never a stale hit.
+        ThemeColors tinted = lightColors;
+        tinted.text = QColor(QStringLiteral("#FF112233"));
+        QVERIFY(Theme::tableViewStyle(tinted) != lightSheet);
+        QCOMPARE(Theme::styleSheetCacheStats().misses, quint64(2));
+
+        constexpr int kViews = 40;
+        QWidget host;
+        auto *layout = new QVBoxLayout(&host);
+        for (int i = 0; i < kViews; ++i) {
+            layout->addWidget(new FluentTableView(&host));
+        }
+        QVERIFY(Theme::styleSheetCacheStats().hits >= quint64(kViews));
+
+        const StyleSheetCacheStats beforeSwitch = Theme::styleSheetCacheStats();
+        syncTheme(true, QColor(QStringLiteral("#0066B4")));
+        const StyleSheetCacheStats afterSwitch = Theme::styleSheetCacheStats();
+        // At most one build per builder, however many instances re-theme.
+        QVERIFY2(afterSwitch.misses - beforeSwitch.misses <= quint64(26),
+                 qPrintable(QString::number(afterSwitch.misses - beforeSwitch.misses)));
+        QVERIFY(afterSwitch.hits - beforeSwitch.hits >= quint64(kViews - 1));
+
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+        const quint64 missesAfterToggle = Theme::styleSheetCacheStats().misses;
+        QCOMPARE(Theme::tableViewStyle(ThemeManager::instance().colors()), lightSheet);
+        QCOMPARE(Theme::styleSheetCacheStats().misses, missesAfterToggle);
+    }
+
+    void themeSwitchProfilerAttributesReceiversAndStyleSheets()
+    {
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+
+        QWidget host;
+        host.resize(420, 260);
+        auto *layout = new QVBoxLayout(&host);
+        auto *button = new FluentButton(QStringLiteral("Profiled"), &host);
+        button->setObjectName(QStringLiteral("ProfiledButton"));
+        layout->addWidget(button);
+        auto *lineEdit = new FluentLineEdit(&host);
+        layout->addWidget(lineEdit);
+        layout->addWidget(new FluentToolBar(&host));
+        host.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&host));
+
+        struct ProfilerRestore {
+            ~ProfilerRestore()
+            {
+                Diagnostics::setThemeSwitchProfilingEnabled(false);
+                Diagnostics::resetThemeSwitchReport();
+            }
+        } restore;
+
+        Diagnostics::resetThemeSwitchReport();
+        Diagnostics::setThemeSwitchProfilingEnabled(true);
+        QVERIFY(Diagnostics::themeSwitchProfilingEnabled());
+
+        syncTheme(true, QColor(QStringLiteral("#0066B4")));
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+
+        const ThemeSwitchReport report = Diagnostics::themeSwitchReport();
+        QVERIFY2(report.dispatchCount >= 2, qPrintable(QString::number(report.dispatchCount)));
+        QVERIFY(report.dispatchNs > 0);
+        QVERIFY(report.styleSheetCount > 0);
+        QVERIFY(!report.receivers.isEmpty());
+
+        bool sawButton = false;
+        qint64 receiverNs = 0;
+        for (int i = 0; i < report.receivers.size(); ++i) {
+            const ThemeReceiverCost &cost = report.receivers.at(i);
+            if (i > 0) {
+                QVERIFY(report.receivers.at(i - 1).totalNs >= cost.totalNs);
+            }
+            QVERIFY(cost.count > 0);
+            QVERIFY(cost.maxNs <= cost.totalNs);
+            receiverNs += cost.totalNs;
+            if (cost.className == QStringLiteral("Fluent::FluentButton")
+                && cost.objectName == QStringLiteral("ProfiledButton")) {
+                sawButton = true;
+                QVERIFY(cost.count >= report.dispatchCount);
+            }
+        }
+        QVERIFY(sawButton);
+        QVERIFY(receiverNs + report.unattributedNs <= report.dispatchNs);
+
+        QJsonParseError error;
+        const QJsonDocument json = QJsonDocument::fromJson(Diagnostics::themeSwitchReportJson(), &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(json.object().value(QStringLiteral("dispatchCount")).toInt(), report.dispatchCount);
+        QCOMPARE(json.object().value(QStringLiteral("receivers")).toArray().size(), report.receivers.size());
+
+        // Disabled profiling leaves the report untouched.
+        Diagnostics::setThemeSwitchProfilingEnabled(false);
+        syncTheme(true, QColor(QStringLiteral("#0066B4")));
+        QCOMPARE(Diagnostics::themeSwitchReport().dispatchCount, report.dispatchCount);
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+    }
+
+    void paintProfilerCountsPaintsPerWidgetAndClass()
+    {
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+
+        struct ProfilerRestore {
+            ~ProfilerRestore()
+            {
+                Diagnostics::setRepaintFlashEnabled(false);
+                Diagnostics::setPaintProfilingEnabled(false);
+                Diagnostics::resetPaintReport();
+            }
+        } restore;
+
+        QWidget host;
+        host.resize(360, 160);
+        auto *layout = new QVBoxLayout(&host);
+        auto *first = new FluentButton(QStringLiteral("First"), &host);
+        first->setObjectName(QStringLiteral("PaintFirst"));
+        auto *second = new FluentButton(QStringLiteral("Second"), &host);
+        second->setObjectName(QStringLiteral("PaintSecond"));
+        auto *label = new FluentLabel(QStringLiteral("Label"), &host);
+        layout->addWidget(first);
+        layout->addWidget(second);
+        layout->addWidget(label);
+        host.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&host));
+        QCoreApplication::processEvents();
+
+        Diagnostics::resetPaintReport();
+        Diagnostics::setPaintProfilingEnabled(true);
+        QVERIFY(Diagnostics::paintProfilingEnabled());
+
+        constexpr int kRepaints = 5;
+        for (int i = 0; i < kRepaints; ++i) {
+            first->repaint();
+        }
+        second->repaint(QRect(0, 0, 10, 10));
+
+        const PaintReport report = Diagnostics::paintReport();
+        QVERIFY2(report.paintCount >= kRepaints + 1, qPrintable(QString::number(report.paintCount)));
+        QVERIFY(report.totalNs > 0);
+
+        const PaintCost *firstCost = nullptr;
+        const PaintCost *secondCost = nullptr;
+        for (const PaintCost &cost : report.widgets) {
+            if (cost.widget == reinterpret_cast<quintptr>(first)) {
+                firstCost = &cost;
+            } else if (cost.widget == reinterpret_cast<quintptr>(second)) {
+                secondCost = &cost;
+            }
+        }
+        QVERIFY(firstCost && secondCost);
+        QCOMPARE(firstCost->objectName, QStringLiteral("PaintFirst"));
+        QVERIFY(firstCost->count >= kRepaints);
+        QCOMPARE(firstCost->area, qint64(firstCost->count) * first->width() * first->height());
+        QVERIFY(firstCost->maxNs <= firstCost->totalNs);
+        QVERIFY2(secondCost->area < qint64(second->width()) * second->height(),
+                 "A partial repaint should only count its invalidated area");
+
+        const PaintCost *buttonClass = nullptr;
+        for (int i = 0; i < report.classes.size(); ++i) {
+            if (i > 0) {
+                QVERIFY(report.classes.at(i - 1).totalNs >= report.classes.at(i).totalNs);
+            }
+            if (report.classes.at(i).className == QStringLiteral("Fluent::FluentButton")) {
+                buttonClass = &report.classes.at(i);
+            }
+        }
+        QVERIFY(buttonClass);
+        QCOMPARE(buttonClass->widget, quintptr(0));
+        QCOMPARE(buttonClass->count, firstCost->count + secondCost->count);
+
+        QJsonParseError error;
+        const QJsonDocument json = QJsonDocument::fromJson(Diagnostics::paintReportJson(), &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(json.object().value(QStringLiteral("paintCount")).toInt(), report.paintCount);
+        QCOMPARE(json.object().value(QStringLiteral("classes")).toArray().size(), report.classes.size());
+
+        // The flash overlay tints what was just repainted, on screen only: a
+        // grab() renders into its own device and must come back untinted.
+        const QImage plain = host.grab().toImage();
+        Diagnostics::setRepaintFlashEnabled(true);
+        QVERIFY(Diagnostics::repaintFlashEnabled());
+        QCOMPARE(changedPixelCount(plain, host.grab().toImage()), 0);
+        host.repaint();
+        QCOMPARE(changedPixelCount(plain, host.grab().toImage()), 0);
+        Diagnostics::setRepaintFlashEnabled(false);
+
+        // Disabled, paints are no longer observed.
+        Diagnostics::setPaintProfilingEnabled(false);
+        const int countBefore = Diagnostics::paintReport().paintCount;
+        first->repaint();
+        QCOMPARE(Diagnostics::paintReport().paintCount, countBefore);
+        QCOMPARE(changedPixelCount(plain, host.grab().toImage()), 0);
+
+        // The flash alone keeps its probe installed but records nothing.
+        Diagnostics::setRepaintFlashEnabled(true);
+        first->repaint();
+        QCOMPARE(Diagnostics::paintReport().paintCount, countBefore);
+        Diagnostics::setRepaintFlashEnabled(false);
+
+        Diagnostics::resetPaintReport();
+        QCOMPARE(Diagnostics::paintReport().paintCount, 0);
+        QVERIFY(Diagnostics::paintReport().widgets.isEmpty());
+    }
+
+    void startupTraceRecordsPhasesUntilFirstFrame()
+    {
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+
+        // The first window of the test run closed the process trace long ago;
+        // re-arm it so the next window counts as the first one again.
+        Diagnostics::resetStartupTrace();
+        QVERIFY(Diagnostics::startupTrace().phases.isEmpty());
+        QVERIFY(!Diagnostics::startupTrace().complete);
+
+        Diagnostics::markStartupPhase(QStringLiteral("window construction"));
+        FluentMainWindow window;
+        window.resize(360, 220);
+        window.setCentralWidget(new FluentLabel(QStringLiteral("Startup")));
+
+        // Chrome that only matters on screen waits for the first show.
+        QVERIFY(!window.findChild<QWidget *>(QStringLiteral("FluentMainWindowBorderOverlay"),
+                                              Qt::FindDirectChildrenOnly));
+        QVERIFY(!window.findChild<FluentResizeHelper *>());
+        Diagnostics::markStartupPhase(QStringLiteral("window constructed"));
+
+        window.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&window));
+        QTRY_VERIFY(Diagnostics::startupTrace().complete);
+
+        auto *overlay = window.findChild<QWidget *>(QStringLiteral("FluentMainWindowBorderOverlay"),
+                                                    Qt::FindDirectChildrenOnly);
+        QVERIFY(overlay && overlay->isVisible());
+        QVERIFY(window.findChild<FluentResizeHelper *>());
+
+        const StartupTrace trace = Diagnostics::startupTrace();
+        QStringList names;
+        for (int i = 0; i < trace.phases.size(); ++i) {
+            names << trace.phases.at(i).name;
+            if (i > 0) {
+                QVERIFY(trace.phases.at(i - 1).elapsedNs <= trace.phases.at(i).elapsedNs);
+            }
+        }
+        const QStringList expected = {
+            QStringLiteral("window construction"), QStringLiteral("window constructed"),
+            QStringLiteral("first window shown"),  QStringLiteral("first window exposed"),
+            QStringLiteral("first paint"),         QStringLiteral("first frame"),
+        };
+        int from = 0;
+        for (const QString &name : expected) {
+            const int at = names.indexOf(name, from);
+            QVERIFY2(at >= 0, qPrintable(QStringLiteral("%1 missing or out of order in: %2")
+                                             .arg(name, names.join(QStringLiteral(", ")))));
+            from = at + 1;
+        }
+        QCOMPARE(names.last(), QStringLiteral("first frame"));
+        QCOMPARE(trace.firstFrameNs, trace.phases.last().elapsedNs);
+
+        // The trace is closed: later marks and windows do not extend it.
+        Diagnostics::markStartupPhase(QStringLiteral("after first frame"));
+        QWidget second;
+        second.resize(120, 80);
+        second.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&second));
+        QCoreApplication::processEvents();
+        QCOMPARE(Diagnostics::startupTrace().phases.size(), trace.phases.size());
+
+        QJsonParseError error;
+        const QJsonDocument json = QJsonDocument::fromJson(Diagnostics::startupTraceJson(), &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QVERIFY(json.object().value(QStringLiteral("complete")).toBool());
+        const QJsonArray phases = json.object().value(QStringLiteral("phases")).toArray();
+        QCOMPARE(phases.size(), trace.phases.size());
+        QCOMPARE(phases.last().toObject().value(QStringLiteral("name")).toString(), QStringLiteral("first frame"));
+    }
+
     void toolBarWrapsPlainActionsWithFluentButtons()
     {
         struct ThemeRestore {
@@ -12479,9 +13955,10 @@ private slots:
         QTRY_VERIFY(itemNav.isVisible());
         QVERIFY2(!renderWidgetImage(&itemNav).isNull(),
                  "NavigationView animated item icon should render to an offscreen QWidget::render image");
-        FluentAnimatedIcon *itemAnimatedIcon = firstVisibleLoadedLottieIcon(&itemNav);
-        QVERIFY2(itemAnimatedIcon,
-                 "NavigationView should expose a visible loaded Lottie item icon after render synchronization");
+        // Item icons parse on a worker thread and appear on the next paint.
+        FluentAnimatedIcon *itemAnimatedIcon = nullptr;
+        QTRY_VERIFY2((itemAnimatedIcon = firstVisibleLoadedLottieIcon(&itemNav)) != nullptr,
+                     "NavigationView should expose a visible loaded Lottie item icon after render synchronization");
         QVERIFY2(itemAnimatedIcon->isPlaying(),
                  "NavigationView selected Lottie item icon should play while global animations are enabled");
 
@@ -12672,6 +14149,10 @@ private slots:
             return renderWidgetImage(&nav, nav.size());
         };
 
+        // Warm the shared model so both navs apply it before their first paint.
+        FluentLottieWidget::preloadData(visualSmokeLottieJson(), QStringLiteral("visual-smoke-nav-static-fallback"));
+        QTRY_VERIFY(FluentLottieWidget::isModelCached(QStringLiteral("visual-smoke-nav-static-fallback")));
+
         const QImage animatedOnly = renderAnimatedItemNav(false);
         const QImage animatedPlusStatic = renderAnimatedItemNav(true);
         QVERIFY2(!animatedOnly.isNull() && !animatedPlusStatic.isNull(),
@@ -12693,6 +14174,9 @@ private slots:
         compactItem.animatedIconData = visualSmokeLottieJson();
         compactItem.animatedIconCacheKey = QStringLiteral("visual-smoke-nav-compact-item");
 
+        FluentLottieWidget::preloadData(visualSmokeLottieJson(), compactItem.animatedIconCacheKey);
+        QTRY_VERIFY(FluentLottieWidget::isModelCached(compactItem.animatedIconCacheKey));
+
         FluentNavigationView compactNav;
         compactNav.setExpandedWidth(248);
         compactNav.setCompactWidth(56);
@@ -12802,6 +14286,232 @@ private slots:
                                 .arg(paintCounter.count)));
     }
 
+    void navigationRenderCacheFollowsItemTextThemeAndPaneWidth()
+    {
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+
+        const bool oldAnimationsEnabled = ThemeManager::instance().animationsEnabled();
+        struct RestoreAnimations {
+            bool enabled = true;
+            ~RestoreAnimations()
+            {
+                ThemeManager::instance().setAnimationsEnabled(enabled);
+                QCoreApplication::processEvents();
+            }
+        } restore{oldAnimationsEnabled};
+
+        ThemeManager::instance().setAnimationsEnabled(false);
+        QCoreApplication::processEvents();
+
+        auto makeItems = [](const QString &prefix) {
+            std::vector<FluentNavigationItem> items;
+            for (int group = 0; group < 20; ++group) {
+                FluentNavigationItem parent;
+                parent.key = QStringLiteral("group_%1").arg(group);
+                parent.text = QStringLiteral("%1 group %2 with a long label").arg(prefix).arg(group + 1);
+                parent.hasFluentIcon = true;
+                parent.fluentIcon = FluentIconType::Folder;
+                for (int child = 0; child < 9; ++child) {
+                    FluentNavigationItem item;
+                    item.key = QStringLiteral("group_%1_item_%2").arg(group).arg(child);
+                    item.text = QStringLiteral("%1 item %2").arg(prefix).arg(child + 1);
+                    item.hasFluentIcon = true;
+                    item.fluentIcon = FluentIconType::Document;
+                    parent.children.push_back(item);
+                }
+                items.push_back(parent);
+            }
+            return items;
+        };
+
+        auto configure = [](FluentNavigationView &view) {
+            view.setExpandedWidth(248);
+            view.setFixedSize(248, 360);
+            view.setPaneTitle(QStringLiteral("Navigation"));
+        };
+
+        FluentNavigationView nav;
+        configure(nav);
+        nav.setItems(makeItems(QStringLiteral("Alpha")));
+        nav.setSelectedKey(QStringLiteral("group_0_item_3"));
+        nav.show();
+        QTRY_VERIFY(nav.isVisible());
+        QCoreApplication::processEvents();
+
+        const QImage alpha = renderWidgetImage(&nav);
+        nav.setItems(makeItems(QStringLiteral("Omega")));
+        QCoreApplication::processEvents();
+        const QImage omega = renderWidgetImage(&nav);
+        QVERIFY2(alpha != omega, "Replacing NavigationView items should not reuse cached labels of the old items");
+
+        FluentNavigationView fresh;
+        configure(fresh);
+        fresh.setItems(makeItems(QStringLiteral("Omega")));
+        fresh.setSelectedKey(QStringLiteral("group_0_item_3"));
+        fresh.show();
+        QTRY_VERIFY(fresh.isVisible());
+        QCoreApplication::processEvents();
+        QCOMPARE(omega, renderWidgetImage(&fresh));
+
+        syncTheme(true, QColor(QStringLiteral("#0066B4")));
+        QCoreApplication::processEvents();
+        const QImage darkCached = renderWidgetImage(&nav);
+        QCOMPARE(darkCached, renderWidgetImage(&fresh));
+        QVERIFY2(darkCached != omega, "Cached NavigationView icons and labels should follow theme changes");
+
+        nav.setExpanded(false);
+        QCoreApplication::processEvents();
+        nav.setExpanded(true);
+        QCoreApplication::processEvents();
+        QCOMPARE(renderWidgetImage(&nav), darkCached);
+
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+    }
+
+    void navigationLazyChildrenAndKeyedUpdatesAvoidFullRebuild()
+    {
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+
+        const bool oldAnimationsEnabled = ThemeManager::instance().animationsEnabled();
+        struct RestoreAnimations {
+            bool enabled = true;
+            ~RestoreAnimations()
+            {
+                ThemeManager::instance().setAnimationsEnabled(enabled);
+                QCoreApplication::processEvents();
+            }
+        } restore{oldAnimationsEnabled};
+
+        ThemeManager::instance().setAnimationsEnabled(false);
+        QCoreApplication::processEvents();
+
+        FluentNavigationItem home;
+        home.key = QStringLiteral("home");
+        home.text = QStringLiteral("Home");
+
+        FluentNavigationItem project;
+        project.key = QStringLiteral("project");
+        project.text = QStringLiteral("Project");
+        project.selectsOnInvoked = false;
+        project.hasLazyChildren = true;
+
+        QStringList requestedKeys;
+        FluentNavigationView nav;
+        nav.setChildrenProvider([&requestedKeys](const QString &parentKey) {
+            requestedKeys.append(parentKey);
+            std::vector<FluentNavigationItem> children;
+            for (int i = 0; i < 3; ++i) {
+                FluentNavigationItem child;
+                child.key = QStringLiteral("%1_file_%2").arg(parentKey).arg(i);
+                child.text = QStringLiteral("File %1").arg(i + 1);
+                child.hasLazyChildren = i == 0;
+                children.push_back(child);
+            }
+            return children;
+        });
+        nav.setExpandedWidth(248);
+        nav.setItems({home, project});
+        nav.setSelectedKey(home.key);
+        nav.setFixedSize(248, 320);
+        nav.show();
+        QTRY_VERIFY(nav.isVisible());
+        QCoreApplication::processEvents();
+
+        QVERIFY2(requestedKeys.isEmpty(), "Lazy NavigationView children should not be requested before expansion");
+        QVERIFY(nav.items()[1].children.empty());
+
+        QTest::mouseClick(&nav, Qt::LeftButton, Qt::NoModifier, QPoint(48, 100));
+        QCoreApplication::processEvents();
+        QCOMPARE(requestedKeys, QStringList{project.key});
+        QCOMPARE(static_cast<int>(nav.items()[1].children.size()), 3);
+        QVERIFY(!nav.items()[1].hasLazyChildren);
+
+        QTest::mouseClick(&nav, Qt::LeftButton, Qt::NoModifier, QPoint(48, 100));
+        QCoreApplication::processEvents();
+        QTest::mouseClick(&nav, Qt::LeftButton, Qt::NoModifier, QPoint(48, 100));
+        QCoreApplication::processEvents();
+        QCOMPARE(requestedKeys.size(), 1);
+
+        nav.setSelectedKey(QStringLiteral("project_file_2"));
+        QCOMPARE(nav.selectedKey(), QStringLiteral("project_file_2"));
+
+        FluentNavigationItem added;
+        added.key = QStringLiteral("project_readme");
+        added.text = QStringLiteral("README");
+        QVERIFY(nav.insertItem(project.key, 0, added));
+        QVERIFY(!nav.insertItem(QStringLiteral("missing"), 0, added));
+        QCOMPARE(nav.items()[1].children.front().key, added.key);
+
+        const QImage beforeRename = renderWidgetImage(&nav);
+        QVERIFY(nav.setItemText(added.key, QStringLiteral("Read me first")));
+        QCOMPARE(nav.items()[1].children.front().text, QStringLiteral("Read me first"));
+        QVERIFY2(renderWidgetImage(&nav) != beforeRename, "Renaming a NavigationView item should refresh its cached label");
+
+        QVERIFY(nav.removeItem(QStringLiteral("project_file_1")));
+        QVERIFY(!nav.removeItem(QStringLiteral("project_file_1")));
+        QCOMPARE(static_cast<int>(nav.items()[1].children.size()), 3);
+        QCOMPARE(nav.selectedKey(), QStringLiteral("project_file_2"));
+
+        QCOMPARE(requestedKeys.size(), 1);
+        QVERIFY2(nav.items()[1].children[1].hasLazyChildren,
+                 "Nested lazy groups should stay unmaterialized until they are expanded");
+
+        QSignalSpy selectionSpy(&nav, &FluentNavigationView::selectedKeyChanged);
+        QVERIFY(nav.setItemChildren(project.key, {}));
+        QVERIFY(nav.items()[1].children.empty());
+        QVERIFY2(nav.selectedKey().isEmpty(), "Replacing the children holding the selection should clear it");
+        QCOMPARE(selectionSpy.count(), 1);
+        QVERIFY(selectionSpy.last().at(0).toString().isEmpty());
+        QVERIFY(!renderWidgetImage(&nav).isNull());
+
+        FluentNavigationItem nested;
+        nested.key = QStringLiteral("project_nested");
+        nested.text = QStringLiteral("Nested");
+        QVERIFY(nav.insertItem(project.key, 0, nested));
+        nav.setSelectedKey(nested.key);
+        selectionSpy.clear();
+        QVERIFY(nav.removeItem(project.key));
+        QVERIFY2(nav.selectedKey().isEmpty(), "Removing an ancestor of the selected item should clear the selection");
+        QCOMPARE(selectionSpy.count(), 1);
+        QVERIFY(!renderWidgetImage(&nav).isNull());
+
+        nav.setSelectedKey(home.key);
+        selectionSpy.clear();
+        QVERIFY(nav.setItemText(home.key, QStringLiteral("Start")));
+        QVERIFY(selectionSpy.isEmpty());
+
+        // Renaming an item listed in an open compact flyout rebuilds the flyout.
+        FluentNavigationItem group;
+        group.key = QStringLiteral("group");
+        group.text = QStringLiteral("Group");
+        group.selectsOnInvoked = false;
+        FluentNavigationItem groupChild;
+        groupChild.key = QStringLiteral("group_child");
+        groupChild.text = QStringLiteral("Child");
+        group.children.push_back(groupChild);
+
+        FluentNavigationView compactNav;
+        compactNav.setItems({home, group});
+        compactNav.setPaneDisplayMode(FluentNavigationView::LeftCompact);
+        compactNav.setFixedSize(compactNav.compactWidth(), 320);
+        compactNav.show();
+        QTRY_VERIFY(compactNav.isVisible());
+        QCoreApplication::processEvents();
+
+        QTest::mouseClick(&compactNav, Qt::LeftButton, Qt::NoModifier, QPoint(compactNav.compactWidth() / 2, 100));
+        QTRY_VERIFY2(findVisibleTopLevelByObjectName(QStringLiteral("FluentMenuPopupHost")),
+                     "Clicking a compact NavigationView group should open its item flyout");
+        QPointer<QWidget> flyout = findVisibleTopLevelByObjectName(QStringLiteral("FluentMenuPopupHost"));
+        QVERIFY(compactNav.setItemText(groupChild.key, QStringLiteral("Renamed child")));
+        QTRY_VERIFY2(flyout.isNull() || !flyout->isVisible(), "Renaming a flyout item should replace the open flyout");
+        QTRY_COMPARE(visibleTopLevelCountByObjectName(QStringLiteral("FluentMenuPopupHost")), 1);
+
+        if (QWidget *popup = findVisibleTopLevelByObjectName(QStringLiteral("FluentMenuPopupHost"))) {
+            popup->close();
+        }
+        QCoreApplication::processEvents();
+    }
+
     void infoBarCompactModeUsesSingleLineMetrics()
     {
         syncTheme(false, QColor(QStringLiteral("#0066B4")));
@@ -20782,6 +22492,42 @@ private slots:
                  "Auto-themed FluentIcon rendering should change between light and dark theme text colors");
     }
 
+    void fluentIconEngineCachesPixmapsPerDevicePixelRatio()
+    {
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+        const QIcon icon = FluentIcon::icon(FluentIconType::Search);
+        QCOMPARE(icon.actualSize(QSize(20, 20)), QSize(20, 20));
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        const QPixmap scaled = icon.pixmap(QSize(16, 16), 1.5);
+        QCOMPARE(scaled.size(), QSize(24, 24));
+        QCOMPARE(scaled.devicePixelRatio(), 1.5);
+        QCOMPARE(icon.pixmap(QSize(16, 16), 1.5).cacheKey(), scaled.cacheKey());
+        QVERIFY(icon.pixmap(QSize(16, 16), 2.0).cacheKey() != scaled.cacheKey());
+#endif
+
+        const QPixmap light = icon.pixmap(QSize(20, 20));
+        QCOMPARE(icon.pixmap(QSize(20, 20)).cacheKey(), light.cacheKey());
+        QVERIFY(icon.pixmap(QSize(20, 20), QIcon::Disabled).cacheKey() != light.cacheKey());
+
+        // A theme switch re-renders icons that follow the theme.
+        syncTheme(true, QColor(QStringLiteral("#0066B4")));
+        const QPixmap dark = icon.pixmap(QSize(20, 20));
+        QVERIFY(dark.cacheKey() != light.cacheKey());
+        const QImage darkImage = dark.toImage();
+        QVERIFY2(nearColorPixelCount(darkImage, ThemeManager::instance().colors().text, darkImage.rect(), 18) > 12,
+                 "Cached FluentIcon pixmaps should follow the dark theme text color");
+        QCOMPARE(icon.pixmap(QSize(20, 20)).cacheKey(), dark.cacheKey());
+
+        // Explicit colors do not depend on the theme.
+        FluentIconOptions explicitColor;
+        explicitColor.color = QColor(QStringLiteral("#123456"));
+        const QIcon fixed = FluentIcon::icon(FluentIconType::Search, explicitColor);
+        const qint64 fixedKey = fixed.pixmap(QSize(20, 20)).cacheKey();
+        syncTheme(false, QColor(QStringLiteral("#0066B4")));
+        QCOMPARE(fixed.pixmap(QSize(20, 20)).cacheKey(), fixedKey);
+    }
+
     void qtCompatEventCoordinateHelpersMatchCurrentQtApi()
     {
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)